@@ -0,0 +1,227 @@
+#include <nano/lib/blocks.hpp>
+#include <nano/lib/logging.hpp>
+#include <nano/lib/stats.hpp>
+#include <nano/lib/work.hpp>
+#include <nano/node/make_store.hpp>
+#include <nano/secure/account_cache.hpp>
+#include <nano/secure/ledger.hpp>
+#include <nano/secure/ledger_set_any.hpp>
+#include <nano/secure/ledger_set_confirmed.hpp>
+#include <nano/secure/utility.hpp>
+#include <nano/store/component.hpp>
+#include <nano/test_common/testutil.hpp>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+class cached_ledger
+{
+public:
+	explicit cached_ledger (std::size_t cache_size) :
+		store{ nano::make_store (logger, nano::unique_path (), nano::dev::constants) },
+		stats{ logger },
+		ledger{ *store, stats, nano::dev::constants, nano::generate_cache_flags{}, 0, cache_size },
+		pool{ nano::dev::network_params.network, 1 }
+	{
+		auto transaction = ledger.tx_begin_write ();
+		store->initialize (transaction, ledger.cache, ledger.constants);
+	}
+
+	std::shared_ptr<nano::block> send (nano::block_hash const & previous, nano::uint128_t const & balance, nano::account const & destination)
+	{
+		nano::block_builder builder;
+		auto block = builder
+					 .state ()
+					 .account (nano::dev::genesis_key.pub)
+					 .previous (previous)
+					 .representative (nano::dev::genesis_key.pub)
+					 .balance (balance)
+					 .link (destination)
+					 .sign (nano::dev::genesis_key.prv, nano::dev::genesis_key.pub)
+					 .work (*pool.generate (previous))
+					 .build ();
+		return block;
+	}
+
+	nano::logger logger;
+	std::unique_ptr<nano::store::component> store;
+	nano::stats stats;
+	nano::ledger ledger;
+	nano::work_pool pool;
+};
+}
+
+TEST (account_cache, disabled)
+{
+	cached_ledger ctx{ 0 };
+	auto & ledger = ctx.ledger;
+	ASSERT_FALSE (ledger.account_cache.enabled ());
+	auto send = ctx.send (nano::dev::genesis->hash (), nano::dev::constants.genesis_amount - 1, nano::dev::genesis_key.pub);
+	{
+		auto transaction = ledger.tx_begin_write ();
+		ASSERT_EQ (nano::block_status::progress, ledger.process (transaction, send));
+	}
+	ASSERT_EQ (0, ledger.account_cache.size ());
+	ASSERT_EQ (send->hash (), ledger.any.account_get (ledger.tx_begin_read (), nano::dev::genesis_key.pub)->head);
+	ASSERT_EQ (0, ctx.stats.count (nano::stat::type::account_cache));
+}
+
+// Values written by the ledger are only served to readers whose snapshot includes the commit
+TEST (account_cache, visibility)
+{
+	cached_ledger ctx{ 1024 };
+	auto & ledger = ctx.ledger;
+	auto & cache = ledger.account_cache;
+
+	auto send = ctx.send (nano::dev::genesis->hash (), nano::dev::constants.genesis_amount - 1, nano::dev::genesis_key.pub);
+	auto reader_before = ledger.tx_begin_read ();
+	{
+		auto transaction = ledger.tx_begin_write ();
+		ASSERT_EQ (nano::block_status::progress, ledger.process (transaction, send));
+		// The writer sees its own changes
+		auto info = cache.account_get (transaction, nano::dev::genesis_key.pub);
+		ASSERT_TRUE (info);
+		ASSERT_EQ (send->hash (), info->head);
+		// Readers don't see uncommitted changes
+		auto reader_during = ledger.tx_begin_read ();
+		ASSERT_FALSE (cache.account_get (reader_during, nano::dev::genesis_key.pub));
+		ASSERT_EQ (nano::dev::genesis->hash (), ledger.any.account_get (reader_during, nano::dev::genesis_key.pub)->head);
+	}
+	// A snapshot taken before the commit must keep reading from the store
+	ASSERT_FALSE (cache.account_get (reader_before, nano::dev::genesis_key.pub));
+	ASSERT_EQ (nano::dev::genesis->hash (), ledger.any.account_get (reader_before, nano::dev::genesis_key.pub)->head);
+
+	auto reader_after = ledger.tx_begin_read ();
+	auto info = cache.account_get (reader_after, nano::dev::genesis_key.pub);
+	ASSERT_TRUE (info);
+	ASSERT_EQ (send->hash (), info->head);
+	ASSERT_EQ (2, info->block_count);
+
+	// Refreshing the read transaction moves it past the commit
+	reader_before.refresh ();
+	ASSERT_TRUE (cache.account_get (reader_before, nano::dev::genesis_key.pub));
+
+	ASSERT_GT (ctx.stats.count (nano::stat::type::account_cache, nano::stat::detail::hit_account), 0);
+	ASSERT_GT (ctx.stats.count (nano::stat::type::account_cache, nano::stat::detail::miss_account), 0);
+}
+
+TEST (account_cache, confirmation_height)
+{
+	cached_ledger ctx{ 1024 };
+	auto & ledger = ctx.ledger;
+	auto & cache = ledger.account_cache;
+
+	auto send = ctx.send (nano::dev::genesis->hash (), nano::dev::constants.genesis_amount - 1, nano::dev::genesis_key.pub);
+	{
+		auto transaction = ledger.tx_begin_write ();
+		ASSERT_EQ (nano::block_status::progress, ledger.process (transaction, send));
+		ASSERT_EQ (1, ledger.confirm (transaction, send->hash ()).size ());
+	}
+	auto transaction = ledger.tx_begin_read ();
+	auto height = cache.height_get (transaction, nano::dev::genesis_key.pub);
+	ASSERT_TRUE (height);
+	ASSERT_EQ (2, height->height);
+	ASSERT_EQ (send->hash (), height->frontier);
+	ASSERT_TRUE (ledger.confirmed.block_exists (transaction, send->hash ()));
+}
+
+TEST (account_cache, rollback)
+{
+	cached_ledger ctx{ 1024 };
+	auto & ledger = ctx.ledger;
+	auto & cache = ledger.account_cache;
+
+	nano::keypair key;
+	auto send = ctx.send (nano::dev::genesis->hash (), nano::dev::constants.genesis_amount - 1, key.pub);
+	nano::block_builder builder;
+	auto open = builder
+				.state ()
+				.account (key.pub)
+				.previous (0)
+				.representative (key.pub)
+				.balance (1)
+				.link (send->hash ())
+				.sign (key.prv, key.pub)
+				.work (*ctx.pool.generate (key.pub))
+				.build ();
+	{
+		auto transaction = ledger.tx_begin_write ();
+		ASSERT_EQ (nano::block_status::progress, ledger.process (transaction, send));
+		ASSERT_EQ (nano::block_status::progress, ledger.process (transaction, open));
+	}
+	ASSERT_TRUE (cache.account_get (ledger.tx_begin_read (), key.pub));
+	{
+		auto transaction = ledger.tx_begin_write ();
+		ASSERT_FALSE (ledger.rollback (transaction, send->hash ()));
+		ASSERT_FALSE (cache.account_get (transaction, key.pub));
+	}
+	auto transaction = ledger.tx_begin_read ();
+	ASSERT_FALSE (cache.account_get (transaction, key.pub));
+	ASSERT_FALSE (ledger.any.account_get (transaction, key.pub));
+	auto info = cache.account_get (transaction, nano::dev::genesis_key.pub);
+	ASSERT_TRUE (info);
+	ASSERT_EQ (nano::dev::genesis->hash (), info->head);
+}
+
+TEST (account_cache, eviction)
+{
+	cached_ledger ctx{ 64 };
+	auto & ledger = ctx.ledger;
+	auto & cache = ledger.account_cache;
+
+	auto transaction = ledger.tx_begin_write ();
+	for (auto i = 0; i < 1024; ++i)
+	{
+		nano::keypair key;
+		cache.account_put (transaction, key.pub, nano::account_info{});
+	}
+	ASSERT_LE (cache.size (), 64);
+	ASSERT_GT (ctx.stats.count (nano::stat::type::account_cache, nano::stat::detail::erase_oldest), 0);
+}
+
+TEST (account_cache, confirmed)
+{
+	cached_ledger ctx{ 1024 };
+	auto & ledger = ctx.ledger;
+	auto & cache = ledger.account_cache;
+
+	auto send1 = ctx.send (nano::dev::genesis->hash (), nano::dev::constants.genesis_amount - 1, nano::dev::genesis_key.pub);
+	auto send2 = ctx.send (send1->hash (), nano::dev::constants.genesis_amount - 2, nano::dev::genesis_key.pub);
+	{
+		auto transaction = ledger.tx_begin_write ();
+		ASSERT_EQ (nano::block_status::progress, ledger.process (transaction, send1));
+		ASSERT_EQ (nano::block_status::progress, ledger.process (transaction, send2));
+	}
+	ASSERT_FALSE (cache.confirmed_get (ledger.tx_begin_read (), send1->hash ()));
+	auto reader_before = ledger.tx_begin_read ();
+	{
+		auto transaction = ledger.tx_begin_write ();
+		ASSERT_EQ (2, ledger.confirm (transaction, send2->hash ()).size ());
+		ASSERT_TRUE (cache.confirmed_get (transaction, send1->hash ()));
+		ASSERT_TRUE (cache.confirmed_get (transaction, send2->hash ()));
+	}
+	// A snapshot taken before the commit doesn't see the blocks as confirmed
+	ASSERT_FALSE (cache.confirmed_get (reader_before, send2->hash ()));
+	ASSERT_FALSE (ledger.confirmed.block_exists (reader_before, send2->hash ()));
+
+	auto reader_after = ledger.tx_begin_read ();
+	ASSERT_TRUE (cache.confirmed_get (reader_after, send2->hash ()));
+	ASSERT_TRUE (ledger.confirmed.block_exists (reader_after, send2->hash ()));
+	ASSERT_GT (ctx.stats.count (nano::stat::type::account_cache, nano::stat::detail::hit_confirmed), 0);
+
+	// Pruned blocks are only reported as confirmed or pruned
+	{
+		auto transaction = ledger.tx_begin_write ();
+		ASSERT_EQ (1, ledger.pruning_action (transaction, send1->hash (), 1));
+	}
+	auto reader_pruned = ledger.tx_begin_read ();
+	ASSERT_FALSE (cache.confirmed_get (reader_pruned, send1->hash ()));
+	ASSERT_TRUE (cache.confirmed_get (reader_pruned, send1->hash (), true));
+	ASSERT_FALSE (ledger.confirmed.block_exists (reader_pruned, send1->hash ()));
+	ASSERT_TRUE (ledger.confirmed.block_exists_or_pruned (reader_pruned, send1->hash ()));
+
+	// Resetting the account drops its confirmed blocks
+	cache.erase (nano::dev::genesis_key.pub);
+	ASSERT_FALSE (cache.confirmed_get (reader_pruned, send2->hash ()));
+}
@@ -25,6 +25,38 @@ TEST (ed25519, signing)
 	ASSERT_NE (0, valid2);
 }
 
+TEST (ed25519, batch)
+{
+	size_t const count = 100;
+	std::vector<nano::keypair> keys (count);
+	std::vector<nano::block_hash> messages (count);
+	std::vector<nano::signature> signatures;
+	for (size_t i = 0; i < count; ++i)
+	{
+		messages[i] = nano::block_hash{ static_cast<uint64_t> (i) };
+		signatures.push_back (nano::sign_message (keys[i].prv, keys[i].pub, messages[i]));
+	}
+	std::vector<unsigned char const *> message_pointers;
+	std::vector<size_t> lengths (count, sizeof (nano::block_hash));
+	std::vector<unsigned char const *> key_pointers;
+	std::vector<unsigned char const *> signature_pointers;
+	for (size_t i = 0; i < count; ++i)
+	{
+		message_pointers.push_back (messages[i].bytes.data ());
+		key_pointers.push_back (keys[i].pub.bytes.data ());
+		signature_pointers.push_back (signatures[i].bytes.data ());
+	}
+	std::vector<int> valid (count, 0);
+	ASSERT_FALSE (nano::validate_message_batch (message_pointers.data (), lengths.data (), key_pointers.data (), signature_pointers.data (), count, valid.data ()));
+	ASSERT_EQ (count, static_cast<size_t> (std::count (valid.begin (), valid.end (), 1)));
+
+	signatures[42].bytes[32] ^= 0x1;
+	std::fill (valid.begin (), valid.end (), 0);
+	ASSERT_TRUE (nano::validate_message_batch (message_pointers.data (), lengths.data (), key_pointers.data (), signature_pointers.data (), count, valid.data ()));
+	ASSERT_EQ (0, valid[42]);
+	ASSERT_EQ (count - 1, static_cast<size_t> (std::count (valid.begin (), valid.end (), 1)));
+}
+
 TEST (transaction_block, empty)
 {
 	nano::keypair key1;
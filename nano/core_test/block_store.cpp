@@ -15,7 +15,9 @@
 #include <nano/store/block.hpp>
 #include <nano/store/lmdb/lmdb.hpp>
 #include <nano/store/rocksdb/rocksdb.hpp>
+#include <nano/store/unconfirmed.hpp>
 #include <nano/store/versioning.hpp>
+#include <nano/test_common/ledger_context.hpp>
 #include <nano/test_common/system.hpp>
 #include <nano/test_common/testutil.hpp>
 
@@ -890,6 +892,66 @@ TEST (block_store, account_count)
 	ASSERT_EQ (1, store->account.count (transaction));
 }
 
+TEST (block_store, bulk_loader)
+{
+	nano::logger logger;
+	auto store = nano::make_store (logger, nano::unique_path (), nano::dev::constants);
+	ASSERT_TRUE (!store->init_error ());
+	// Existing key above everything loaded below, forces the non-appending path for LMDB
+	nano::account_info existing{ 1, 2, 3, 4, 5, 6, nano::epoch::epoch_0 };
+	store->account.put (store->tx_begin_write (), nano::account{ 1000 }, existing);
+
+	nano::block_builder builder;
+	auto block = builder
+				 .open ()
+				 .source (0)
+				 .representative (1)
+				 .account (2)
+				 .sign (nano::keypair ().prv, 0)
+				 .work (0)
+				 .build ();
+	block->sideband_set (nano::block_sideband (2, 0, 0, 1, nano::seconds_since_epoch (), nano::epoch::epoch_0, false, false, false, nano::epoch::epoch_0));
+	std::vector<uint8_t> raw;
+	{
+		nano::vectorstream stream (raw);
+		nano::serialize_block (stream, *block);
+		block->sideband ().serialize (stream, block->type ());
+	}
+	{
+		auto loader = store->make_bulk_loader ();
+		// Out of order and duplicated keys, the last put of a key wins
+		for (auto i = 100; i > 0; --i)
+		{
+			loader->account_put (nano::account{ static_cast<uint64_t> (i) }, nano::account_info{ 0, 0, 0, 0, 0, 1, nano::epoch::epoch_0 });
+		}
+		loader->account_put (nano::account{ 50 }, nano::account_info{ 0, 0, 0, 0, 0, 50, nano::epoch::epoch_0 });
+		loader->confirmation_height_put (nano::account{ 2 }, nano::confirmation_height_info{ 1, block->hash () });
+		loader->pending_put (nano::pending_key{ 3, 4 }, nano::pending_info{ 5, 6, nano::epoch::epoch_1 });
+		loader->rep_weight_put (nano::account{ 7 }, 8);
+		loader->pruned_put (9);
+		loader->block_raw_put (block->hash (), raw);
+		loader->flush ();
+		ASSERT_EQ (106, loader->written ());
+	}
+	auto transaction = store->tx_begin_read ();
+	ASSERT_EQ (101, store->account.count (transaction));
+	ASSERT_EQ (1, store->account.get (transaction, nano::account{ 1 })->block_count);
+	ASSERT_EQ (50, store->account.get (transaction, nano::account{ 50 })->block_count);
+	ASSERT_EQ (existing, store->account.get (transaction, nano::account{ 1000 }));
+	nano::confirmation_height_info confirmation_height;
+	ASSERT_FALSE (store->confirmation_height.get (transaction, nano::account{ 2 }, confirmation_height));
+	ASSERT_EQ (block->hash (), confirmation_height.frontier);
+	auto pending = store->pending.get (transaction, nano::pending_key{ 3, 4 });
+	ASSERT_TRUE (pending);
+	ASSERT_EQ (nano::pending_info (5, 6, nano::epoch::epoch_1), *pending);
+	ASSERT_EQ (8, store->rep_weight.get (transaction, nano::account{ 7 }));
+	ASSERT_TRUE (store->pruned.exists (transaction, 9));
+	auto loaded = store->block.get (transaction, block->hash ());
+	ASSERT_NE (nullptr, loaded);
+	ASSERT_EQ (*block, *loaded);
+	ASSERT_EQ (2, loaded->sideband ().height);
+}
+
 TEST (block_store, cemented_count_cache)
 {
 	nano::logger logger;
@@ -1431,6 +1493,38 @@ TEST (mdb_block_store, upgrade_v23_v24)
 	// Testing the upgrade code worked
 	check_correct_state ();
 }
+
+TEST (mdb_block_store, upgrade_v24_v25)
+{
+	if (nano::rocksdb_config::using_rocksdb_in_tests ())
+	{
+		// Direct lmdb operations are used to simulate the old ledger format so this test will not work on RocksDB
+		GTEST_SKIP ();
+	}
+
+	auto path (nano::unique_path () / "data.ldb");
+	nano::logger logger;
+	nano::keypair key;
+
+	// Setting the database to its 24th version state, with an account that has blocks above its confirmation height
+	{
+		nano::store::lmdb::component store (logger, path, nano::dev::constants);
+		auto transaction (store.tx_begin_write ());
+		nano::account_info info{ 1, key.pub, 2, 100, nano::seconds_since_epoch (), 3, nano::epoch::epoch_0 };
+		store.account.put (transaction, key.pub, info);
+		store.confirmation_height.put (transaction, key.pub, { 1, 2 });
+		store.unconfirmed.clear (transaction);
+		store.version.put (transaction, 24);
+	}
+
+	// Testing the upgrade built the index
+	nano::store::lmdb::component store (logger, path, nano::dev::constants);
+	auto transaction (store.tx_begin_read ());
+	ASSERT_EQ (store.version.get (transaction), store.version_current);
+	ASSERT_EQ (1, store.unconfirmed.count (transaction));
+	ASSERT_TRUE (store.unconfirmed.exists (transaction, key.pub));
+	ASSERT_FALSE (store.unconfirmed.exists (transaction, nano::dev::genesis_key.pub));
+}
 }
 
 namespace nano::store::rocksdb
@@ -1761,3 +1855,39 @@ TEST (rocksdb_block_store, tombstone_count)
 	ASSERT_TIMELY_EQ (5s, store->tombstone_map.at (nano::tables::accounts).num_since_last_flush.load (), 1);
 }
 }
+
+TEST (block_store, chain)
+{
+	auto ctx = nano::test::ledger_single_chain (4);
+	auto & store = ctx.store ();
+	auto transaction = store.tx_begin_read ();
+	auto info = store.account.get (transaction, nano::dev::genesis_key.pub);
+	ASSERT_TRUE (info);
+
+	// Whole chain from the open block up to the frontier
+	std::vector<std::shared_ptr<nano::block>> blocks;
+	store.block.chain (transaction, info->open_block, std::numeric_limits<std::size_t>::max (), [&blocks] (nano::store::block_view const & view) {
+		auto block = view.deserialize ();
+		EXPECT_EQ (view.hash, block->hash ());
+		EXPECT_EQ (view.successor (), block->sideband ().successor);
+		blocks.push_back (block);
+	});
+	ASSERT_EQ (info->block_count, blocks.size ());
+	ASSERT_EQ (info->head, blocks.back ()->hash ());
+	for (auto const & block : blocks)
+	{
+		auto stored = store.block.get (transaction, block->hash ());
+		ASSERT_EQ (*stored, *block);
+		ASSERT_EQ (stored->sideband ().height, block->sideband ().height);
+	}
+
+	// Limited by count
+	std::size_t count = 0;
+	store.block.chain (transaction, blocks[1]->hash (), 2, [&count] (nano::store::block_view const &) { ++count; });
+	ASSERT_EQ (2, count);
+
+	// Unknown start block
+	count = 0;
+	store.block.chain (transaction, nano::block_hash{ 1 }, 2, [&count] (nano::store::block_view const &) { ++count; });
+	ASSERT_EQ (0, count);
+}
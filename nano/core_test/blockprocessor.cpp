@@ -9,4 +9,46 @@
 
 #include <gtest/gtest.h>
 
-using namespace std::chrono_literals;
\ No newline at end of file
+using namespace std::chrono_literals;
+
+TEST (block_processor_tuner, initial)
+{
+	nano::block_processor_config config{ nano::dev::network_params.network };
+	nano::block_processor_tuner tuner{ config, 500ms };
+	ASSERT_EQ (nano::block_processor_tuner::initial_batch_size, tuner.batch_size ());
+	ASSERT_EQ (config.batch_latency_target, tuner.refresh_interval ());
+}
+
+// Batches grow on fast storage and shrink on slow storage to keep batches close to the latency target
+TEST (block_processor_tuner, adjust)
+{
+	nano::block_processor_config config{ nano::dev::network_params.network };
+	config.batch_latency_target = 100ms;
+	config.batch_size_min = 16;
+	config.batch_size_max = 64 * 1024;
+
+	nano::block_processor_tuner fast{ config, 500ms };
+	for (int i = 0; i < 32; ++i)
+	{
+		fast.processed (1000, 10ms); // 10us per block
+		fast.committed (1ms);
+	}
+	ASSERT_NEAR (9900, fast.batch_size (), 100);
+	ASSERT_EQ (100ms, fast.refresh_interval ());
+
+	nano::block_processor_tuner slow{ config, 500ms };
+	for (int i = 0; i < 32; ++i)
+	{
+		slow.processed (100, 100ms); // 1ms per block
+		slow.committed (40ms);
+	}
+	ASSERT_NEAR (60, slow.batch_size (), 2);
+	// Commits are slow, refresh less often but never beyond the maximum
+	ASSERT_NEAR (400, slow.refresh_interval ().count (), 5);
+
+	nano::block_processor_tuner stalled{ config, 500ms };
+	stalled.processed (10, 1s);
+	stalled.committed (200ms);
+	ASSERT_EQ (config.batch_size_min, stalled.batch_size ());
+	ASSERT_EQ (500ms, stalled.refresh_interval ());
+}
@@ -5,6 +5,7 @@
 #include <nano/node/bootstrap_ascending/database_scan.hpp>
 #include <nano/node/bootstrap_ascending/service.hpp>
 #include <nano/node/make_store.hpp>
+#include <nano/node/transport/fake.hpp>
 #include <nano/secure/ledger.hpp>
 #include <nano/secure/ledger_set_any.hpp>
 #include <nano/test_common/ledger_context.hpp>
@@ -483,4 +484,73 @@ TEST (bootstrap_ascending, account_database_scanner)
 		}
 		ASSERT_EQ (scanner.completed, 1);
 	}
+	// Partitioned, ranges are disjoint and together cover all accounts
+	{
+		nano::account const middle{ std::numeric_limits<nano::uint256_t>::max () / 2 };
+		nano::bootstrap_ascending::account_database_iterator scanner1{ ctx.ledger (), 0, middle };
+		nano::bootstrap_ascending::account_database_iterator scanner2{ ctx.ledger (), middle, 0 };
+		auto transaction = ctx.store ().tx_begin_read ();
+
+		auto accounts1 = scanner1.next_batch (transaction, 256);
+		auto accounts2 = scanner2.next_batch (transaction, 256);
+		ASSERT_TRUE (std::all_of (accounts1.begin (), accounts1.end (), [&middle] (auto const & account) { return account < middle; }));
+		ASSERT_TRUE (std::none_of (accounts2.begin (), accounts2.end (), [&middle] (auto const & account) { return account < middle; }));
+
+		std::deque<nano::account> accounts;
+		accounts.insert (accounts.end (), accounts1.begin (), accounts1.end ());
+		accounts.insert (accounts.end (), accounts2.begin (), accounts2.end ());
+		ASSERT_EQ (accounts.size (), keys.size () + 1); // +1 for genesis
+		for (auto const & key : keys)
+		{
+			ASSERT_TRUE (std::find (accounts.begin (), accounts.end (), key.pub) != accounts.end ());
+		}
+		ASSERT_EQ (scanner1.completed, 1);
+		ASSERT_EQ (scanner2.completed, 1);
+	}
+}
+
+TEST (bootstrap_ascending, peer_scoring_window)
+{
+	nano::test::system system;
+	auto & node = *system.add_node ();
+	auto channel = std::make_shared<nano::transport::fake::channel> (node);
+
+	nano::bootstrap_ascending_config config;
+	config.channel_limit = 8;
+	config.channel_window = 2;
+	nano::bootstrap_ascending::peer_scoring scoring{ config, nano::dev::network_params.network };
+
+	// Window starts at the configured size
+	ASSERT_FALSE (scoring.try_send_message (channel));
+	ASSERT_EQ (1, scoring.available (channel));
+	ASSERT_FALSE (scoring.try_send_message (channel));
+	ASSERT_TRUE (scoring.try_send_message (channel));
+	ASSERT_EQ (0, scoring.available (channel));
+
+	// Responses widen the window by one while round trips stay close to the fastest one
+	scoring.received_message (channel, 100ms);
+	ASSERT_EQ (2, scoring.available (channel));
+	ASSERT_EQ (100ms, scoring.rtt (channel));
+
+	// Window never exceeds the channel limit
+	for (int i = 0; i < 10; ++i)
+	{
+		scoring.received_message (channel, 100ms);
+	}
+	ASSERT_EQ (7, scoring.available (channel));
+
+	// Slower responses mean requests are queueing at the peer, the window shrinks once the smoothed round trip time grows past twice the fastest
+	for (int i = 0; i < 3; ++i)
+	{
+		scoring.received_message (channel, 400ms);
+	}
+	ASSERT_EQ (197ms, scoring.rtt (channel));
+	ASSERT_EQ (7, scoring.available (channel));
+	scoring.received_message (channel, 400ms);
+	ASSERT_EQ (222ms, scoring.rtt (channel));
+	ASSERT_EQ (6, scoring.available (channel));
+
+	// Timeouts halve the window
+	scoring.timed_out (channel);
+	ASSERT_EQ (3, scoring.available (channel));
 }
\ No newline at end of file
@@ -17,8 +17,21 @@ class responses_helper final
 public:
 	void add (nano::asc_pull_ack const & ack)
 	{
+		// Keep the response as the peer receives it, the server forwards stored blocks in serialized form
+		std::vector<uint8_t> bytes;
+		{
+			nano::vectorstream stream{ bytes };
+			ack.serialize (stream);
+		}
+		nano::bufferstream stream{ bytes.data (), bytes.size () };
+		bool error = false;
+		nano::message_header header{ error, stream };
+		release_assert (!error);
+		nano::asc_pull_ack received{ error, stream, header };
+		release_assert (!error);
+
 		nano::lock_guard<nano::mutex> lock{ mutex };
-		responses.push_back (ack);
+		responses.push_back (received);
 	}
 
 	std::vector<nano::asc_pull_ack> get ()
@@ -0,0 +1,81 @@
+#include <nano/lib/buffer_pool.hpp>
+#include <nano/lib/memory.hpp>
+
+#include <gtest/gtest.h>
+
+#include <thread>
+
+TEST (buffer_pool, size_classes)
+{
+	auto buffer1 = nano::buffer_pool::acquire (8);
+	ASSERT_EQ (8, buffer1->size ());
+	ASSERT_GE (buffer1->capacity (), nano::buffer_pool::min_size);
+
+	auto buffer2 = nano::buffer_pool::acquire (1000);
+	ASSERT_EQ (1000, buffer2->size ());
+	ASSERT_GE (buffer2->capacity (), 1024);
+
+	auto buffer3 = nano::buffer_pool::acquire (0, 5000);
+	ASSERT_TRUE (buffer3->empty ());
+	ASSERT_GE (buffer3->capacity (), 8192);
+
+	// Larger than the biggest class, served directly
+	auto buffer4 = nano::buffer_pool::acquire (nano::buffer_pool::max_size + 1);
+	ASSERT_EQ (nano::buffer_pool::max_size + 1, buffer4->size ());
+}
+
+TEST (buffer_pool, reuse)
+{
+	// This might be turned off, e.g on Mac for instance, so don't do this test
+	if (!nano::get_use_memory_pools ())
+	{
+		GTEST_SKIP ();
+	}
+
+	auto buffer1 = nano::buffer_pool::acquire (3000);
+	auto data1 = buffer1->data ();
+	buffer1.reset ();
+
+	// Released buffers are handed out again by the same thread, cleared and resized to the requested size
+	auto buffer2 = nano::buffer_pool::acquire (2500);
+	ASSERT_EQ (data1, buffer2->data ());
+	ASSERT_EQ (2500, buffer2->size ());
+
+	// A buffer which grew while in use is kept in the class matching its new capacity
+	buffer2->resize (20000);
+	auto data2 = buffer2->data ();
+	buffer2.reset ();
+	auto buffer3 = nano::buffer_pool::acquire (10000);
+	ASSERT_EQ (data2, buffer3->data ());
+}
+
+TEST (buffer_pool, release_other_thread)
+{
+	if (!nano::get_use_memory_pools ())
+	{
+		GTEST_SKIP ();
+	}
+
+	auto outstanding = [] () {
+		auto info = nano::buffer_pool::container_info ();
+		for (auto const & [name, child] : info.children ())
+		{
+			if (name == "65536")
+			{
+				return child.entries ().front ().size;
+			}
+		}
+		return std::size_t{ 0 };
+	};
+
+	auto const initial = outstanding ();
+	auto buffer = nano::buffer_pool::acquire (40000);
+	ASSERT_EQ (initial + 1, outstanding ());
+
+	// Buffers are commonly released from a different thread than the one which acquired them, e.g. after a write completes
+	std::thread thread ([buffer = std::move (buffer)] () mutable {
+		buffer.reset ();
+	});
+	thread.join ();
+	ASSERT_EQ (initial, outstanding ());
+}
\ No newline at end of file
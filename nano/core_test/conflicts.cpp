@@ -208,3 +208,15 @@ TEST (vote_uniquer, cleanup)
 	auto vote5 = uniquer.unique (vote1);
 	ASSERT_EQ (1, uniquer.size ());
 }
+
+TEST (vote_uniquer, find)
+{
+	nano::vote_uniquer uniquer;
+	nano::keypair key;
+	auto vote1 = std::make_shared<nano::vote> (key.pub, key.prv, 0, 0, std::vector<nano::block_hash>{ nano::block_hash{ 0 } });
+	ASSERT_EQ (nullptr, uniquer.find (vote1->full_hash ()));
+	ASSERT_EQ (vote1, uniquer.unique (vote1->full_hash (), vote1));
+	ASSERT_EQ (vote1, uniquer.find (vote1->full_hash ()));
+	auto vote2 = std::make_shared<nano::vote> (*vote1);
+	ASSERT_EQ (vote1, uniquer.unique (vote2->full_hash (), vote2));
+}
\ No newline at end of file
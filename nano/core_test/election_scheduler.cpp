@@ -330,4 +330,49 @@ TEST (election_scheduler_bucket, max_blocks)
 	// Ensure correct order
 	ASSERT_EQ (blocks[0], block1 ());
 	ASSERT_EQ (blocks[1], block0 ());
-}
\ No newline at end of file
+}
+
+TEST (election_scheduler_bucket, enqueue)
+{
+	nano::test::system system;
+	auto & node = *system.add_node ();
+
+	nano::scheduler::priority_bucket_config bucket_config;
+	nano::scheduler::bucket bucket{ 0, bucket_config, node.active, node.stats };
+	bucket.enqueue (2000, block0 ());
+	bucket.enqueue (1000, block1 ());
+	ASSERT_FALSE (bucket.empty ());
+	// Enqueued blocks are sorted into the bucket on the next access
+	ASSERT_EQ (2, bucket.size ());
+	bucket.enqueue (1000, block1 ());
+	ASSERT_TRUE (bucket.push (900, block2 ()));
+	ASSERT_EQ (1, node.stats.count (nano::stat::type::election_bucket, nano::stat::detail::insert_failed));
+	auto blocks = bucket.blocks ();
+	ASSERT_EQ (3, blocks.size ());
+	ASSERT_EQ (blocks[0], block2 ());
+	ASSERT_EQ (blocks[1], block1 ());
+	ASSERT_EQ (blocks[2], block0 ());
+}
+
+TEST (election_scheduler_bucket, enqueue_max_blocks)
+{
+	nano::test::system system;
+	auto & node = *system.add_node ();
+
+	nano::scheduler::priority_bucket_config bucket_config{
+		.max_blocks = 2
+	};
+	nano::scheduler::bucket bucket{ 0, bucket_config, node.active, node.stats };
+	ASSERT_TRUE (bucket.enqueue (1000, block0 ()));
+	ASSERT_TRUE (bucket.enqueue (2000, block1 ()));
+	ASSERT_TRUE (bucket.enqueue (3000, block2 ())); // Exceeds max_blocks, sorted in right away and dropped
+	ASSERT_EQ (1, node.stats.count (nano::stat::type::election_bucket, nano::stat::detail::insert_failed));
+	ASSERT_FALSE (bucket.enqueue (2500, block2 ())); // Rejected without locking the bucket
+	ASSERT_EQ (2, node.stats.count (nano::stat::type::election_bucket, nano::stat::detail::insert_failed));
+	ASSERT_TRUE (bucket.enqueue (1500, block3 ())); // Evicts 2000
+	ASSERT_EQ (2, bucket.size ());
+	auto blocks = bucket.blocks ();
+	ASSERT_EQ (2, blocks.size ());
+	ASSERT_EQ (blocks[0], block0 ());
+	ASSERT_EQ (blocks[1], block3 ());
+}
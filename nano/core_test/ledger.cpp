@@ -12,7 +12,10 @@
 #include <nano/node/vote_router.hpp>
 #include <nano/secure/ledger_set_any.hpp>
 #include <nano/secure/ledger_set_confirmed.hpp>
+#include <nano/secure/ledger_snapshot.hpp>
+#include <nano/secure/ledger_validator.hpp>
 #include <nano/store/rocksdb/rocksdb.hpp>
+#include <nano/store/unconfirmed.hpp>
 #include <nano/test_common/ledger_context.hpp>
 #include <nano/test_common/make_store.hpp>
 #include <nano/test_common/system.hpp>
@@ -335,6 +338,90 @@ TEST (ledger, rollback_receiver)
 	ASSERT_FALSE (ledger.any.pending_get (transaction, nano::pending_key{ key2.pub, hash1 }));
 }
 
+// The unconfirmed index must contain exactly the accounts with blocks above their confirmation height
+TEST (ledger, unconfirmed_index)
+{
+	auto ctx = nano::test::ledger_empty ();
+	auto & ledger = ctx.ledger ();
+	auto & store = ctx.store ();
+	auto transaction = ledger.tx_begin_write ();
+	auto & pool = ctx.pool ();
+	ASSERT_EQ (0, store.unconfirmed.count (transaction));
+
+	nano::keypair key;
+	nano::block_builder builder;
+	auto send1 = builder
+				 .state ()
+				 .account (nano::dev::genesis_key.pub)
+				 .previous (nano::dev::genesis->hash ())
+				 .representative (nano::dev::genesis_key.pub)
+				 .balance (nano::dev::constants.genesis_amount - 100)
+				 .link (key.pub)
+				 .sign (nano::dev::genesis_key.prv, nano::dev::genesis_key.pub)
+				 .work (*pool.generate (nano::dev::genesis->hash ()))
+				 .build ();
+	ASSERT_EQ (nano::block_status::progress, ledger.process (transaction, send1));
+	ASSERT_TRUE (store.unconfirmed.exists (transaction, nano::dev::genesis_key.pub));
+	auto open = builder
+				.state ()
+				.account (key.pub)
+				.previous (0)
+				.representative (key.pub)
+				.balance (100)
+				.link (send1->hash ())
+				.sign (key.prv, key.pub)
+				.work (*pool.generate (key.pub))
+				.build ();
+	ASSERT_EQ (nano::block_status::progress, ledger.process (transaction, open));
+	ASSERT_TRUE (store.unconfirmed.exists (transaction, key.pub));
+	ASSERT_EQ (2, store.unconfirmed.count (transaction));
+
+	// Cementing the frontiers empties the index
+	ASSERT_EQ (2, ledger.confirm (transaction, open->hash ()).size ());
+	ASSERT_EQ (0, store.unconfirmed.count (transaction));
+
+	auto send2 = builder
+				 .state ()
+				 .account (nano::dev::genesis_key.pub)
+				 .previous (send1->hash ())
+				 .representative (nano::dev::genesis_key.pub)
+				 .balance (nano::dev::constants.genesis_amount - 200)
+				 .link (key.pub)
+				 .sign (nano::dev::genesis_key.prv, nano::dev::genesis_key.pub)
+				 .work (*pool.generate (send1->hash ()))
+				 .build ();
+	auto send3 = builder
+				 .state ()
+				 .account (nano::dev::genesis_key.pub)
+				 .previous (send2->hash ())
+				 .representative (nano::dev::genesis_key.pub)
+				 .balance (nano::dev::constants.genesis_amount - 300)
+				 .link (key.pub)
+				 .sign (nano::dev::genesis_key.prv, nano::dev::genesis_key.pub)
+				 .work (*pool.generate (send2->hash ()))
+				 .build ();
+	ASSERT_EQ (nano::block_status::progress, ledger.process (transaction, send2));
+	ASSERT_EQ (nano::block_status::progress, ledger.process (transaction, send3));
+	ASSERT_EQ (1, store.unconfirmed.count (transaction));
+
+	// Rolling back while unconfirmed blocks remain keeps the account
+	ASSERT_FALSE (ledger.rollback (transaction, send3->hash ()));
+	ASSERT_TRUE (store.unconfirmed.exists (transaction, nano::dev::genesis_key.pub));
+
+	// Rolling back to the confirmation height removes it
+	ASSERT_FALSE (ledger.rollback (transaction, send2->hash ()));
+	ASSERT_FALSE (store.unconfirmed.exists (transaction, nano::dev::genesis_key.pub));
+
+	// Rebuilding from the account and confirmation height tables gives the same result
+	ASSERT_EQ (nano::block_status::progress, ledger.process (transaction, send2));
+	transaction.commit ();
+	auto store_transaction = store.tx_begin_write ();
+	store.unconfirmed.clear (store_transaction);
+	store.rebuild_unconfirmed (store_transaction);
+	ASSERT_EQ (1, store.unconfirmed.count (store_transaction));
+	ASSERT_TRUE (store.unconfirmed.exists (store_transaction, nano::dev::genesis_key.pub));
+}
+
 TEST (ledger, rollback_representation)
 {
 	auto ctx = nano::test::ledger_empty ();
@@ -3290,6 +3377,94 @@ TEST (ledger, state_rollback_received_send)
 	ASSERT_EQ (store.account.count (transaction), ledger.account_count ());
 }
 
+// Blocks depending on the rolled back block are collected up front and rolled back in one batch
+TEST (ledger, rollback_dependents)
+{
+	auto ctx = nano::test::ledger_empty ();
+	auto & ledger = ctx.ledger ();
+	auto & store = ctx.store ();
+	auto transaction = ledger.tx_begin_write ();
+	auto & pool = ctx.pool ();
+	nano::keypair key;
+	nano::block_builder builder;
+	auto send1 = builder
+				 .state ()
+				 .account (nano::dev::genesis_key.pub)
+				 .previous (nano::dev::genesis->hash ())
+				 .representative (nano::dev::genesis_key.pub)
+				 .balance (nano::dev::constants.genesis_amount - nano::Knano_ratio)
+				 .link (key.pub)
+				 .sign (nano::dev::genesis_key.prv, nano::dev::genesis_key.pub)
+				 .work (*pool.generate (nano::dev::genesis->hash ()))
+				 .build ();
+	ASSERT_EQ (nano::block_status::progress, ledger.process (transaction, send1));
+	auto open = builder
+				.state ()
+				.account (key.pub)
+				.previous (0)
+				.representative (key.pub)
+				.balance (nano::Knano_ratio)
+				.link (send1->hash ())
+				.sign (key.prv, key.pub)
+				.work (*pool.generate (key.pub))
+				.build ();
+	ASSERT_EQ (nano::block_status::progress, ledger.process (transaction, open));
+	auto send2 = builder
+				 .state ()
+				 .account (key.pub)
+				 .previous (open->hash ())
+				 .representative (key.pub)
+				 .balance (nano::Knano_ratio - 1)
+				 .link (nano::dev::genesis_key.pub)
+				 .sign (key.prv, key.pub)
+				 .work (*pool.generate (open->hash ()))
+				 .build ();
+	ASSERT_EQ (nano::block_status::progress, ledger.process (transaction, send2));
+	auto receive = builder
+				   .state ()
+				   .account (nano::dev::genesis_key.pub)
+				   .previous (send1->hash ())
+				   .representative (nano::dev::genesis_key.pub)
+				   .balance (nano::dev::constants.genesis_amount - nano::Knano_ratio + 1)
+				   .link (send2->hash ())
+				   .sign (nano::dev::genesis_key.prv, nano::dev::genesis_key.pub)
+				   .work (*pool.generate (send1->hash ()))
+				   .build ();
+	ASSERT_EQ (nano::block_status::progress, ledger.process (transaction, receive));
+
+	// Confirmed blocks can't be rolled back
+	ASSERT_FALSE (ledger.rollback_dependents (transaction, nano::dev::genesis->hash ()));
+
+	auto dependents = ledger.rollback_dependents (transaction, send1->hash ());
+	ASSERT_TRUE (dependents);
+	ASSERT_EQ (4, dependents->size ());
+	ASSERT_EQ (receive->hash (), (*dependents)[0]->hash ());
+	ASSERT_EQ (send1->hash (), (*dependents)[1]->hash ());
+	ASSERT_EQ (send2->hash (), (*dependents)[2]->hash ());
+	ASSERT_EQ (open->hash (), (*dependents)[3]->hash ());
+	// Planning doesn't modify the ledger
+	ASSERT_TRUE (ledger.any.block_exists (transaction, open->hash ()));
+	ASSERT_EQ (5, ledger.block_count ());
+
+	std::vector<std::shared_ptr<nano::block>> list;
+	ASSERT_FALSE (ledger.rollback (transaction, send1->hash (), list));
+	ASSERT_EQ (4, list.size ());
+	for (auto const & block : list)
+	{
+		ASSERT_FALSE (ledger.any.block_exists (transaction, block->hash ()));
+	}
+	ASSERT_EQ (1, ledger.block_count ());
+	ASSERT_EQ (nano::dev::genesis->hash (), ledger.any.account_head (transaction, nano::dev::genesis_key.pub));
+	ASSERT_FALSE (ledger.any.block_successor (transaction, nano::dev::genesis->hash ()));
+	ASSERT_EQ (nano::dev::constants.genesis_amount, ledger.any.account_balance (transaction, nano::dev::genesis_key.pub));
+	ASSERT_EQ (nano::dev::constants.genesis_amount, ledger.weight (nano::dev::genesis_key.pub));
+	ASSERT_EQ (0, ledger.weight (key.pub));
+	ASSERT_FALSE (ledger.any.account_get (transaction, key.pub));
+	ASSERT_FALSE (ledger.any.pending_get (transaction, nano::pending_key{ key.pub, send1->hash () }));
+	ASSERT_FALSE (ledger.any.pending_get (transaction, nano::pending_key{ nano::dev::genesis_key.pub, send2->hash () }));
+	ASSERT_EQ (store.account.count (transaction), ledger.account_count ());
+}
+
 TEST (ledger, state_rep_change_rollback)
 {
 	auto ctx = nano::test::ledger_empty ();
@@ -5485,6 +5660,78 @@ TEST (ledger, migrate_lmdb_to_rocksdb)
 	ASSERT_EQ (rocksdb_store.final_vote.get (rocksdb_transaction, nano::root (send->previous ()))[0], nano::block_hash (2));
 }
 
+TEST (ledger, snapshot_export_import)
+{
+	auto ctx1 = nano::test::ledger_send_receive ();
+	auto file = nano::unique_path () / "ledger.snapshot";
+	{
+		auto transaction = ctx1.ledger ().tx_begin_write ();
+		ctx1.ledger ().confirm (transaction, ctx1.blocks ().back ()->hash ());
+	}
+	nano::ledger_snapshot snapshot1{ ctx1.ledger (), ctx1.logger (), 2 };
+	ASSERT_FALSE (snapshot1.write (file));
+
+	auto ctx2 = nano::test::ledger_empty ();
+	nano::ledger_snapshot snapshot2{ ctx2.ledger (), ctx2.logger (), 2 };
+	ASSERT_FALSE (snapshot2.read (file));
+
+	auto & store1 = ctx1.store ();
+	auto & store2 = ctx2.store ();
+	auto transaction1 = store1.tx_begin_read ();
+	auto transaction2 = store2.tx_begin_read ();
+	ASSERT_EQ (store1.block.count (transaction1), store2.block.count (transaction2));
+	ASSERT_EQ (store1.account.count (transaction1), store2.account.count (transaction2));
+	ASSERT_EQ (store1.rep_weight.count (transaction1), store2.rep_weight.count (transaction2));
+	ASSERT_EQ (store1.unconfirmed.count (transaction1), store2.unconfirmed.count (transaction2));
+	for (auto const & block : ctx1.blocks ())
+	{
+		auto imported = store2.block.get (transaction2, block->hash ());
+		ASSERT_NE (nullptr, imported);
+		ASSERT_EQ (*block, *imported);
+		ASSERT_EQ (block->sideband ().height, imported->sideband ().height);
+		ASSERT_EQ (block->sideband ().successor, imported->sideband ().successor);
+	}
+	ASSERT_EQ (store1.account.get (transaction1, nano::dev::genesis_key.pub), store2.account.get (transaction2, nano::dev::genesis_key.pub));
+	auto height1 = store1.confirmation_height.get (transaction1, nano::dev::genesis_key.pub);
+	auto height2 = store2.confirmation_height.get (transaction2, nano::dev::genesis_key.pub);
+	ASSERT_TRUE (height1 && height2);
+	ASSERT_EQ (height1->height, height2->height);
+	ASSERT_EQ (height1->frontier, height2->frontier);
+	ASSERT_EQ (store1.rep_weight.get (transaction1, nano::dev::genesis_key.pub), store2.rep_weight.get (transaction2, nano::dev::genesis_key.pub));
+}
+
+// Importing must fail when a chunk does not match its digest or the ledger is not empty, without modifying the ledger
+TEST (ledger, snapshot_import_errors)
+{
+	auto ctx1 = nano::test::ledger_send_receive ();
+	auto file = nano::unique_path () / "ledger.snapshot";
+	nano::ledger_snapshot snapshot1{ ctx1.ledger (), ctx1.logger (), 1 };
+	ASSERT_FALSE (snapshot1.write (file));
+
+	// Not empty
+	ASSERT_TRUE (snapshot1.read (file));
+
+	// Corrupt a byte inside the payload of the last non-empty chunk (representative weights)
+	{
+		std::fstream stream{ file, std::ios::in | std::ios::out | std::ios::binary };
+		stream.seekp (-64, std::ios::end);
+		char byte;
+		stream.read (&byte, 1);
+		stream.seekp (-64, std::ios::end);
+		byte = static_cast<char> (byte ^ 0xff);
+		stream.write (&byte, 1);
+	}
+	auto ctx2 = nano::test::ledger_empty ();
+	nano::ledger_snapshot snapshot2{ ctx2.ledger (), ctx2.logger (), 1 };
+	ASSERT_TRUE (snapshot2.read (file));
+
+	// The ledger is left untouched when verification fails
+	auto transaction = ctx2.store ().tx_begin_read ();
+	ASSERT_TRUE (ctx2.store ().block.exists (transaction, nano::dev::genesis->hash ()));
+	ASSERT_EQ (1, ctx2.store ().account.count (transaction));
+	ASSERT_EQ (1, ctx2.store ().confirmation_height.count (transaction));
+}
+
 TEST (ledger, is_send_genesis)
 {
 	auto ctx = nano::test::ledger_empty ();
@@ -5648,6 +5895,31 @@ TEST (ledger, cement_bounded_diamond)
 	}));
 }
 
+// Tests that cementing a chain writes the confirmation height of the account once instead of once per block
+TEST (ledger, cement_coalesced_height_writes)
+{
+	auto ctx = nano::test::ledger_single_chain (64);
+	auto & ledger = ctx.ledger ();
+	auto bottom = ctx.blocks ().back ();
+
+	std::deque<std::shared_ptr<nano::block>> confirmed;
+	{
+		auto tx = ledger.tx_begin_write ();
+		confirmed = ledger.confirm (tx, bottom->hash ());
+	}
+	ASSERT_EQ (confirmed.size (), ctx.blocks ().size ());
+	// A write per block would be one per confirmed block, refreshing the transaction may add a few more
+	ASSERT_LT (ctx.stats ().count (nano::stat::type::confirmation_height, nano::stat::detail::height_writes), confirmed.size ());
+	ASSERT_EQ (ctx.stats ().count (nano::stat::type::confirmation_height, nano::stat::detail::blocks_confirmed), confirmed.size ());
+
+	auto tx = ledger.tx_begin_read ();
+	auto info = ctx.store ().confirmation_height.get (tx, nano::dev::genesis_key.pub);
+	ASSERT_TRUE (info);
+	ASSERT_EQ (bottom->sideband ().height, info->height);
+	ASSERT_EQ (bottom->hash (), info->frontier);
+	ASSERT_EQ (ctx.blocks ().size () + 1, ledger.cemented_count ());
+}
+
 // Test that nullopt can be returned when there are no receivable entries
 TEST (ledger_receivable, upper_bound_account_none)
 {
@@ -5856,3 +6128,76 @@ TEST (ledger_transaction, write_wait_order)
 	// Signal to continue and drop the third transaction
 	latch3.count_down ();
 }
+
+TEST (ledger, validator)
+{
+	auto ctx = nano::test::ledger_diamond (3);
+	auto & ledger = ctx.ledger ();
+	// Upgrade genesis so the epoch signer path is exercised as well
+	{
+		auto transaction = ledger.tx_begin_write ();
+		auto info = ledger.any.account_get (transaction, nano::dev::genesis_key.pub);
+		ASSERT_TRUE (info);
+		nano::block_builder builder;
+		auto epoch = builder
+					 .state ()
+					 .account (nano::dev::genesis_key.pub)
+					 .previous (info->head)
+					 .representative (info->representative)
+					 .balance (info->balance)
+					 .link (ledger.epoch_link (nano::epoch::epoch_1))
+					 .sign (nano::dev::genesis_key.prv, nano::dev::genesis_key.pub)
+					 .work (*ctx.pool ().generate (info->head))
+					 .build ();
+		ASSERT_EQ (nano::block_status::progress, ledger.process (transaction, epoch));
+	}
+	std::vector<std::string> errors;
+	nano::mutex mutex;
+	auto on_error = [&] (std::string const & message) {
+		nano::lock_guard<nano::mutex> guard{ mutex };
+		errors.push_back (message);
+	};
+	nano::ledger_validator validator{ ledger, 4, on_error };
+	validator.validate_accounts ();
+	validator.validate_pending ();
+	ASSERT_TRUE (errors.empty ());
+	ASSERT_EQ (0, validator.errors ());
+	auto transaction = ctx.store ().tx_begin_read ();
+	ASSERT_EQ (ctx.store ().account.count (transaction), validator.accounts ());
+	ASSERT_EQ (ctx.store ().block.count (transaction), validator.blocks ());
+	uint64_t pending = 0;
+	for (auto i = ctx.store ().pending.begin (transaction), n = ctx.store ().pending.end (transaction); i != n; ++i)
+	{
+		++pending;
+	}
+	ASSERT_EQ (pending, validator.pending ());
+}
+
+// A corrupted signature is found by the batch verification and reported once
+TEST (ledger, validator_invalid_signature)
+{
+	auto ctx = nano::test::ledger_diamond (3);
+	auto & store = ctx.store ();
+	auto hash = ctx.blocks ().back ()->hash ();
+	{
+		auto transaction = store.tx_begin_write ();
+		auto block = store.block.get (transaction, hash);
+		ASSERT_NE (nullptr, block);
+		auto signature = block->block_signature ();
+		signature.bytes[32] ^= 0x1;
+		block->signature_set (signature);
+		store.block.put (transaction, hash, *block);
+	}
+	std::vector<std::string> errors;
+	nano::mutex mutex;
+	auto on_error = [&] (std::string const & message) {
+		nano::lock_guard<nano::mutex> guard{ mutex };
+		errors.push_back (message);
+	};
+	nano::ledger_validator validator{ ctx.ledger (), 2, on_error };
+	validator.validate_accounts ();
+	ASSERT_EQ (1, validator.errors ());
+	ASSERT_EQ (1, errors.size ());
+	ASSERT_NE (std::string::npos, errors.front ().find ("Invalid signature"));
+	ASSERT_NE (std::string::npos, errors.front ().find (hash.to_string ()));
+}
@@ -1,9 +1,18 @@
+#include <nano/lib/blocks.hpp>
 #include <nano/lib/logging.hpp>
+#include <nano/lib/trace_recorder.hpp>
+#include <nano/secure/common.hpp>
+#include <nano/secure/utility.hpp>
 #include <nano/test_common/testutil.hpp>
 
 #include <gtest/gtest.h>
 
+#include <fstream>
+#include <optional>
 #include <ostream>
+#include <sstream>
+#include <thread>
+#include <unordered_map>
 
 using namespace std::chrono_literals;
 
@@ -59,6 +68,151 @@ TEST (tracing, no_move)
 	logger.trace (nano::log::type::test, nano::log::detail::test, nano::log::arg{ "non_moveable", nm });
 }
 
+// Decoded binary traces should read the same as events traced in the standard format
+TEST (trace_recorder, decode)
+{
+	auto path = nano::unique_path () / "test.trace";
+	nano::block_hash hash{ 123 };
+	std::shared_ptr<nano::block> empty;
+	non_copyable nc;
+	{
+		nano::log::trace_recorder recorder{ path };
+		recorder.start ();
+		recorder.record (nano::object_stream_config::default_config (), nano::log::type::test, nano::log::detail::test, 1000,
+		nano::log::arg{ "count", 42 },
+		nano::log::arg{ "flag", true },
+		nano::log::arg{ "level", nano::log::level::debug },
+		nano::log::arg{ "hash", hash },
+		nano::log::arg{ "block", nano::dev::genesis },
+		nano::log::arg{ "empty", empty },
+		nano::log::arg{ "ratio", 0.5 },
+		nano::log::arg{ "non_copyable", nc });
+		recorder.stop ();
+		ASSERT_EQ (1, recorder.recorded ());
+		ASSERT_EQ (0, recorder.dropped ());
+	}
+
+	std::stringstream expected;
+	expected << nano::streamed_args (nano::object_stream_config::default_config (),
+	nano::log::arg{ "event", std::string{ "test::test" } },
+	nano::log::arg{ "time", int64_t{ 1000 } },
+	nano::log::arg{ "count", 42 },
+	nano::log::arg{ "flag", true },
+	nano::log::arg{ "level", nano::log::level::debug },
+	nano::log::arg{ "hash", hash },
+	nano::log::arg{ "block", nano::dev::genesis },
+	nano::log::arg{ "empty", empty },
+	nano::log::arg{ "ratio", 0.5 },
+	nano::log::arg{ "non_copyable", nc });
+	expected << "\n";
+
+	std::ifstream file{ path, std::ios::binary };
+	nano::log::trace_decoder decoder{ file };
+	std::stringstream decoded;
+	ASSERT_TRUE (decoder.next (decoded));
+	ASSERT_EQ (expected.str (), decoded.str ());
+	ASSERT_FALSE (decoder.next (decoded));
+}
+
+TEST (trace_recorder, multiple_threads)
+{
+	auto path = nano::unique_path () / "test.trace";
+	size_t const thread_count = 4;
+	size_t const event_count = 1000;
+	uint64_t recorded = 0;
+	{
+		nano::log::trace_recorder recorder{ path, nano::log::trace_recorder::default_ring_size, 1ms };
+		recorder.start ();
+		std::vector<std::thread> threads;
+		for (size_t i = 0; i < thread_count; ++i)
+		{
+			threads.emplace_back ([&recorder, i] () {
+				for (size_t n = 0; n < event_count; ++n)
+				{
+					recorder.record (nano::object_stream_config::default_config (), nano::log::type::test, nano::log::detail::test, n, nano::log::arg{ "thread", i });
+				}
+			});
+		}
+		for (auto & thread : threads)
+		{
+			thread.join ();
+		}
+		recorder.stop ();
+		ASSERT_EQ (thread_count * event_count, recorder.recorded () + recorder.dropped ());
+		recorded = recorder.recorded ();
+	}
+	ASSERT_GT (recorded, 0);
+
+	// Every event that can appear in the trace, mapped to the thread and sequence number that recorded it
+	std::unordered_map<std::string, std::pair<size_t, size_t>> expected;
+	for (size_t i = 0; i < thread_count; ++i)
+	{
+		for (size_t n = 0; n < event_count; ++n)
+		{
+			std::stringstream event;
+			event << nano::streamed_args (nano::object_stream_config::default_config (),
+			nano::log::arg{ "event", std::string{ "test::test" } },
+			nano::log::arg{ "time", static_cast<int64_t> (n) },
+			nano::log::arg{ "thread", i });
+			event << "\n";
+			expected.emplace (event.str (), std::make_pair (i, n));
+		}
+	}
+
+	// All recorded events decode intact, and events of each thread keep their order even if some were dropped
+	std::ifstream file{ path, std::ios::binary };
+	nano::log::trace_decoder decoder{ file };
+	std::vector<std::optional<size_t>> last (thread_count);
+	size_t count = 0;
+	while (true)
+	{
+		std::stringstream decoded;
+		if (!decoder.next (decoded))
+		{
+			break;
+		}
+		auto existing = expected.find (decoded.str ());
+		ASSERT_NE (expected.end (), existing) << decoded.str ();
+		auto const [thread, n] = existing->second;
+		if (last[thread])
+		{
+			ASSERT_LT (*last[thread], n);
+		}
+		last[thread] = n;
+		++count;
+	}
+	ASSERT_EQ (recorded, count);
+}
+
+// Records which don't fit in the ring are dropped instead of blocking the caller
+TEST (trace_ring, full)
+{
+	nano::log::trace_ring ring{ 64 };
+	std::vector<uint8_t> record (40, 1);
+	ASSERT_TRUE (ring.push (record));
+	ASSERT_FALSE (ring.push (record));
+	ASSERT_EQ (1, ring.recorded ());
+	ASSERT_EQ (1, ring.dropped ());
+
+	std::vector<uint8_t> output;
+	ASSERT_EQ (40, ring.pop (output));
+	ASSERT_EQ (record, output);
+	ASSERT_EQ (0, ring.size ());
+
+	// Wraps around the end of the buffer
+	std::vector<uint8_t> second (40, 2);
+	ASSERT_TRUE (ring.push (second));
+	output.clear ();
+	ASSERT_EQ (40, ring.pop (output));
+	ASSERT_EQ (second, output);
+}
+
+TEST (trace_decoder, invalid_file)
+{
+	std::stringstream stream{ "not a trace file" };
+	ASSERT_THROW (nano::log::trace_decoder{ stream }, std::runtime_error);
+}
+
 TEST (log_parse, parse_level)
 {
 	ASSERT_EQ (nano::log::parse_level ("error"), nano::log::level::error);
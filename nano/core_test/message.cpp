@@ -634,6 +634,68 @@ TEST (message, asc_pull_ack_serialization_blocks)
 	ASSERT_TRUE (nano::at_end (stream));
 }
 
+// Blocks appended in serialized form are received like regular blocks, after them
+TEST (message, asc_pull_ack_serialization_blocks_serialized)
+{
+	nano::asc_pull_ack original{ nano::dev::network_params.network };
+	original.id = 11;
+	original.type = nano::asc_pull_type::blocks;
+
+	std::vector<std::shared_ptr<nano::block>> blocks;
+	nano::asc_pull_ack::blocks_payload original_payload{};
+	for (int n = 0; n < nano::asc_pull_ack::blocks_payload::max_blocks; ++n)
+	{
+		auto block = random_block ();
+		blocks.push_back (block);
+		if (n < nano::asc_pull_ack::blocks_payload::max_blocks / 2)
+		{
+			original_payload.blocks.push_back (block);
+		}
+		else
+		{
+			std::vector<uint8_t> block_bytes;
+			{
+				nano::vectorstream stream{ block_bytes };
+				block->serialize (stream);
+			}
+			original_payload.append_serialized (block->type (), block_bytes);
+		}
+	}
+	ASSERT_EQ (nano::asc_pull_ack::blocks_payload::max_blocks, original_payload.size ());
+
+	original.payload = original_payload;
+	original.update_header ();
+
+	// Serialize
+	std::vector<uint8_t> bytes;
+	{
+		nano::vectorstream stream{ bytes };
+		original.serialize (stream);
+	}
+	nano::bufferstream stream{ bytes.data (), bytes.size () };
+
+	// Header
+	bool error = false;
+	nano::message_header header (error, stream);
+	ASSERT_FALSE (error);
+
+	// Message
+	nano::asc_pull_ack message (error, stream, header);
+	ASSERT_FALSE (error);
+
+	nano::asc_pull_ack::blocks_payload message_payload;
+	ASSERT_NO_THROW (message_payload = std::get<nano::asc_pull_ack::blocks_payload> (message.payload));
+	ASSERT_EQ (0, message_payload.serialized_count);
+
+	// Compare blocks
+	ASSERT_EQ (blocks.size (), message_payload.blocks.size ());
+	ASSERT_TRUE (std::equal (blocks.begin (), blocks.end (), message_payload.blocks.begin (), message_payload.blocks.end (), [] (auto a, auto b) {
+		return *a == *b;
+	}));
+
+	ASSERT_TRUE (nano::at_end (stream));
+}
+
 TEST (message, asc_pull_ack_serialization_account_info)
 {
 	nano::asc_pull_ack original{ nano::dev::network_params.network };
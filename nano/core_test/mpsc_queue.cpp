@@ -0,0 +1,70 @@
+#include <nano/lib/mpsc_queue.hpp>
+
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+TEST (mpsc_queue, construction)
+{
+	nano::mpsc_queue<int> queue;
+	ASSERT_TRUE (queue.empty ());
+	ASSERT_TRUE (queue.pop_all ().empty ());
+}
+
+TEST (mpsc_queue, order)
+{
+	nano::mpsc_queue<int> queue;
+	ASSERT_TRUE (queue.push (1));
+	ASSERT_FALSE (queue.push (2));
+	ASSERT_FALSE (queue.push (3));
+	ASSERT_FALSE (queue.empty ());
+	auto items = queue.pop_all ();
+	ASSERT_TRUE (queue.empty ());
+	ASSERT_EQ (items, (std::deque<int>{ 1, 2, 3 }));
+	// Detaching the items makes the next push the first one again
+	ASSERT_TRUE (queue.push (4));
+	ASSERT_EQ (queue.pop_all (), std::deque<int>{ 4 });
+}
+
+TEST (mpsc_queue, multithreaded)
+{
+	nano::mpsc_queue<std::pair<int, int>> queue;
+	int const thread_count = 4;
+	int const item_count = 10000;
+
+	std::vector<std::thread> threads;
+	for (int n = 0; n < thread_count; ++n)
+	{
+		threads.emplace_back ([&queue, n] () {
+			for (int i = 0; i < item_count; ++i)
+			{
+				queue.push ({ n, i });
+			}
+		});
+	}
+
+	// Consume concurrently with the producers, items from each producer must come out in the order they were pushed
+	std::vector<int> next (thread_count, 0);
+	int total = 0;
+	auto consume = [&] () {
+		for (auto const & [n, i] : queue.pop_all ())
+		{
+			ASSERT_EQ (next[n], i);
+			++next[n];
+			++total;
+		}
+	};
+	while (total < thread_count * item_count)
+	{
+		consume ();
+		std::this_thread::yield ();
+	}
+	for (auto & thread : threads)
+	{
+		thread.join ();
+	}
+	consume ();
+	ASSERT_EQ (thread_count * item_count, total);
+	ASSERT_TRUE (queue.empty ());
+}
@@ -7,6 +7,9 @@
 
 #include <gtest/gtest.h>
 
+#include <atomic>
+#include <thread>
+
 TEST (network_filter, apply)
 {
 	nano::network_filter filter (4);
@@ -163,4 +166,40 @@ TEST (network_filter, expire)
 
 	ASSERT_FALSE (filter.check (2)); // Entry with epoch 1 should be expired
 	ASSERT_FALSE (filter.apply (2)); // Entry with epoch 1 should be replaced
+}
+
+/*
+ * Ensure that when many threads apply the same digests concurrently, each digest is reported as new exactly once
+ */
+TEST (network_filter, concurrent_apply)
+{
+	auto const count = 4096;
+	auto const thread_count = 8;
+	// Filter large enough for every digest to get its own slot
+	nano::network_filter filter{ count };
+	std::atomic<int> unique{ 0 };
+	std::vector<std::thread> threads;
+	for (int i = 0; i < thread_count; ++i)
+	{
+		threads.emplace_back ([&filter, &unique, count, i] () {
+			for (int n = 0; n < count; ++n)
+			{
+				// Every thread walks the digests from a different starting point to increase contention on individual slots
+				nano::network_filter::digest_t digest{ (n + i * 512) % count + 1 };
+				if (!filter.apply (digest))
+				{
+					++unique;
+				}
+			}
+		});
+	}
+	for (auto & thread : threads)
+	{
+		thread.join ();
+	}
+	ASSERT_EQ (count, unique);
+	for (int n = 1; n <= count; ++n)
+	{
+		ASSERT_TRUE (filter.check (n));
+	}
 }
\ No newline at end of file
@@ -1695,6 +1695,51 @@ TEST (node, online_reps)
 	ASSERT_EQ (node1.config.online_weight_minimum, node1.online_reps.trended ());
 }
 
+// Samples are tracked in memory, the trended weight and quorum should match what a full scan of the table gives
+TEST (node, online_reps_samples)
+{
+	nano::test::system system;
+	auto & node = *system.add_node ();
+	auto const max_samples = node.network_params.node.max_weight_samples;
+	{
+		auto transaction = node.store.tx_begin_write ();
+		for (uint64_t i = 1; i < max_samples; ++i)
+		{
+			node.store.online_weight.put (transaction, i, nano::amount{ i * nano::Knano_ratio });
+		}
+		node.online_reps.load_samples (transaction);
+	}
+	auto expected_trend = [&node] () {
+		std::vector<nano::uint128_t> items{ node.config.online_weight_minimum.number () };
+		auto transaction = node.store.tx_begin_read ();
+		for (auto i = node.store.online_weight.begin (transaction), n = node.store.online_weight.end (transaction); i != n; ++i)
+		{
+			items.push_back (i->second.number ());
+		}
+		std::sort (items.begin (), items.end ());
+		return items[items.size () / 2];
+	};
+	auto expected_delta = [&node] () {
+		auto weight = std::max ({ node.online_reps.online (), node.online_reps.trended (), node.config.online_weight_minimum.number () });
+		return (nano::uint256_t{ weight } * nano::online_reps::online_weight_quorum / 100).convert_to<nano::uint128_t> ();
+	};
+	ASSERT_EQ (expected_trend (), node.online_reps.trended ());
+	ASSERT_EQ (expected_delta (), node.online_reps.delta ());
+
+	node.online_reps.observe (nano::dev::genesis_key.pub);
+	ASSERT_EQ (expected_delta (), node.online_reps.delta ());
+	for (int i = 0; i < 3; ++i)
+	{
+		node.online_reps.sample ();
+		ASSERT_EQ (max_samples, node.store.online_weight.count (node.store.tx_begin_read ()));
+		ASSERT_EQ (expected_trend (), node.online_reps.trended ());
+		ASSERT_EQ (expected_delta (), node.online_reps.delta ());
+	}
+	// The two oldest samples made room for the newer ones
+	auto transaction = node.store.tx_begin_read ();
+	ASSERT_EQ (3, node.store.online_weight.begin (transaction)->first);
+}
+
 TEST (node, online_reps_rep_crawler)
 {
 	nano::test::system system;
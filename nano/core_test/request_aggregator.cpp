@@ -54,14 +54,15 @@ TEST (request_aggregator, one)
 	ASSERT_TIMELY (3s, node.aggregator.empty ());
 	ASSERT_TIMELY (3s, 0 < node.stats.count (nano::stat::type::requests, nano::stat::detail::requests_generated_votes));
 
-	// Already cached
-	// TODO: This is outdated, aggregator should not be using cache
+	// Already cached, the generated vote is sent again
 	node.aggregator.request (request, dummy_channel);
 	ASSERT_TIMELY (3s, node.aggregator.empty ());
 	ASSERT_TIMELY_EQ (3s, 3, node.stats.count (nano::stat::type::aggregator, nano::stat::detail::aggregator_accepted));
 	ASSERT_TIMELY_EQ (3s, 0, node.stats.count (nano::stat::type::aggregator, nano::stat::detail::aggregator_dropped));
 	ASSERT_TIMELY_EQ (3s, 1, node.stats.count (nano::stat::type::requests, nano::stat::detail::requests_unknown));
-	ASSERT_TIMELY_EQ (3s, 2, node.stats.count (nano::stat::type::requests, nano::stat::detail::requests_generated_votes));
+	ASSERT_TIMELY_EQ (3s, 1, node.stats.count (nano::stat::type::requests, nano::stat::detail::requests_generated_votes));
+	ASSERT_TIMELY_EQ (3s, 1, node.stats.count (nano::stat::type::requests, nano::stat::detail::requests_cached_votes));
+	ASSERT_EQ (1, node.stats.count (nano::stat::type::request_aggregator, nano::stat::detail::reply_cache_hit));
 	ASSERT_TIMELY_EQ (3s, 0, node.stats.count (nano::stat::type::requests, nano::stat::detail::requests_cannot_vote));
 	ASSERT_TIMELY_EQ (3s, 2, node.stats.count (nano::stat::type::message, nano::stat::detail::confirm_ack, nano::stat::dir::out));
 }
@@ -191,8 +192,10 @@ TEST (request_aggregator, two)
 	ASSERT_EQ (2, node.stats.count (nano::stat::type::aggregator, nano::stat::detail::aggregator_accepted));
 	ASSERT_EQ (0, node.stats.count (nano::stat::type::aggregator, nano::stat::detail::aggregator_dropped));
 	ASSERT_TIMELY_EQ (3s, 0, node.stats.count (nano::stat::type::requests, nano::stat::detail::requests_unknown));
-	ASSERT_TIMELY_EQ (3s, 4, node.stats.count (nano::stat::type::requests, nano::stat::detail::requests_generated_hashes));
-	ASSERT_TIMELY_EQ (3s, 2, node.stats.count (nano::stat::type::requests, nano::stat::detail::requests_generated_votes));
+	ASSERT_TIMELY_EQ (3s, 2, node.stats.count (nano::stat::type::requests, nano::stat::detail::requests_generated_hashes));
+	ASSERT_TIMELY_EQ (3s, 1, node.stats.count (nano::stat::type::requests, nano::stat::detail::requests_generated_votes));
+	ASSERT_TIMELY_EQ (3s, 2, node.stats.count (nano::stat::type::requests, nano::stat::detail::requests_cached_hashes));
+	ASSERT_TIMELY_EQ (3s, 1, node.stats.count (nano::stat::type::requests, nano::stat::detail::requests_cached_votes));
 	ASSERT_TIMELY_EQ (3s, 0, node.stats.count (nano::stat::type::requests, nano::stat::detail::requests_cannot_vote));
 	ASSERT_TIMELY_EQ (3s, 2, node.stats.count (nano::stat::type::message, nano::stat::detail::confirm_ack, nano::stat::dir::out));
 	// Make sure the cached vote is for both hashes
@@ -246,8 +249,7 @@ TEST (request_aggregator, two_endpoints)
 	ASSERT_TIMELY_EQ (5s, 1, node1.stats.count (nano::stat::type::requests, nano::stat::detail::requests_generated_votes));
 	ASSERT_TIMELY_EQ (3s, 0, node1.stats.count (nano::stat::type::requests, nano::stat::detail::requests_cannot_vote));
 
-	// For the second request, aggregator should use the cache
-	// TODO: This is outdated, aggregator should not be using cache
+	// For the second request, aggregator should use the reply cache
 	node1.aggregator.request (request, dummy_channel1);
 	ASSERT_TIMELY (5s, node1.aggregator.empty ());
 
@@ -255,8 +257,9 @@ TEST (request_aggregator, two_endpoints)
 	ASSERT_EQ (0, node1.stats.count (nano::stat::type::aggregator, nano::stat::detail::aggregator_dropped));
 
 	ASSERT_TIMELY_EQ (5s, 0, node1.stats.count (nano::stat::type::requests, nano::stat::detail::requests_unknown));
-	ASSERT_TIMELY_EQ (5s, 2, node1.stats.count (nano::stat::type::requests, nano::stat::detail::requests_generated_hashes));
-	ASSERT_TIMELY_EQ (5s, 2, node1.stats.count (nano::stat::type::requests, nano::stat::detail::requests_generated_votes));
+	ASSERT_TIMELY_EQ (5s, 1, node1.stats.count (nano::stat::type::requests, nano::stat::detail::requests_generated_hashes));
+	ASSERT_TIMELY_EQ (5s, 1, node1.stats.count (nano::stat::type::requests, nano::stat::detail::requests_generated_votes));
+	ASSERT_TIMELY_EQ (5s, 1, node1.stats.count (nano::stat::type::requests, nano::stat::detail::requests_cached_votes));
 	ASSERT_TIMELY_EQ (3s, 0, node1.stats.count (nano::stat::type::requests, nano::stat::detail::requests_cannot_vote));
 }
 
@@ -446,3 +449,97 @@ TEST (request_aggregator, cannot_vote)
 	ASSERT_EQ (0, node.stats.count (nano::stat::type::requests, nano::stat::detail::requests_unknown));
 	ASSERT_TIMELY (3s, 1 <= node.stats.count (nano::stat::type::message, nano::stat::detail::confirm_ack, nano::stat::dir::out));
 }
+
+TEST (request_aggregator, reply_cache_disabled)
+{
+	nano::test::system system;
+	nano::node_config node_config = system.default_config ();
+	node_config.backlog_population.enable = false;
+	node_config.request_aggregator.reply_cache_age = 0ms;
+	auto & node (*system.add_node (node_config));
+	system.wallet (0)->insert_adhoc (nano::dev::genesis_key.prv);
+	nano::block_builder builder;
+	auto send1 = builder
+				 .state ()
+				 .account (nano::dev::genesis_key.pub)
+				 .previous (nano::dev::genesis->hash ())
+				 .representative (nano::dev::genesis_key.pub)
+				 .balance (nano::dev::constants.genesis_amount - nano::Knano_ratio)
+				 .link (nano::dev::genesis_key.pub)
+				 .sign (nano::dev::genesis_key.prv, nano::dev::genesis_key.pub)
+				 .work (*node.work_generate_blocking (nano::dev::genesis->hash ()))
+				 .build ();
+	ASSERT_EQ (nano::block_status::progress, node.ledger.process (node.ledger.tx_begin_write (), send1));
+	nano::test::confirm (node.ledger, send1);
+
+	std::vector<std::pair<nano::block_hash, nano::root>> request{ { send1->hash (), send1->root () } };
+	auto dummy_channel = nano::test::fake_channel (node);
+	node.aggregator.request (request, dummy_channel);
+	ASSERT_TIMELY_EQ (3s, 1, node.stats.count (nano::stat::type::requests, nano::stat::detail::requests_generated_votes));
+
+	// Every request generates a new vote
+	node.aggregator.request (request, dummy_channel);
+	ASSERT_TIMELY_EQ (3s, 2, node.stats.count (nano::stat::type::requests, nano::stat::detail::requests_generated_votes));
+	ASSERT_EQ (0, node.stats.count (nano::stat::type::requests, nano::stat::detail::requests_cached_votes));
+	ASSERT_EQ (0, node.stats.count (nano::stat::type::request_aggregator, nano::stat::detail::reply_cache_hit));
+}
+
+TEST (reply_vote_cache, find)
+{
+	nano::reply_vote_cache cache{ 60s, 1024 };
+	nano::keypair key;
+	auto vote = nano::test::make_final_vote (key, { nano::block_hash{ 1 }, nano::block_hash{ 2 } });
+	cache.insert (vote);
+	ASSERT_EQ (2, cache.size ());
+
+	// Multi hash votes are found through each of their hashes
+	ASSERT_EQ (std::vector{ vote }, cache.find (nano::block_hash{ 1 }));
+	ASSERT_EQ (std::vector{ vote }, cache.find (nano::block_hash{ 2 }));
+	ASSERT_TRUE (cache.find (nano::block_hash{ 3 }).empty ());
+
+	// Only final votes are cached
+	cache.insert (nano::test::make_vote (key, { nano::block_hash{ 3 } }, nano::milliseconds_since_epoch ()));
+	ASSERT_EQ (2, cache.size ());
+	ASSERT_TRUE (cache.find (nano::block_hash{ 3 }).empty ());
+
+	nano::keypair key2;
+	auto vote2 = nano::test::make_final_vote (key2, { nano::block_hash{ 1 } });
+	cache.insert (vote2);
+	ASSERT_EQ (2, cache.find (nano::block_hash{ 1 }).size ());
+}
+
+TEST (reply_vote_cache, one_vote_per_representative)
+{
+	nano::reply_vote_cache cache{ 60s, 1024 };
+	nano::keypair key1;
+	nano::keypair key2;
+	cache.insert (nano::test::make_final_vote (key1, { nano::block_hash{ 1 } }));
+	cache.insert (nano::test::make_final_vote (key2, { nano::block_hash{ 1 } }));
+	auto newest = nano::test::make_final_vote (key1, { nano::block_hash{ 1 }, nano::block_hash{ 2 } });
+	cache.insert (newest);
+	ASSERT_EQ (4, cache.size ());
+
+	auto votes = cache.find (nano::block_hash{ 1 });
+	ASSERT_EQ (2, votes.size ());
+	auto vote1 = std::find_if (votes.begin (), votes.end (), [&key1] (auto const & vote) { return vote->account == key1.pub; });
+	ASSERT_NE (votes.end (), vote1);
+	ASSERT_EQ (newest, *vote1);
+	ASSERT_EQ (1, std::count_if (votes.begin (), votes.end (), [&key2] (auto const & vote) { return vote->account == key2.pub; }));
+}
+
+TEST (reply_vote_cache, expiry)
+{
+	nano::reply_vote_cache cache{ 100ms, 2 };
+	nano::keypair key;
+	auto vote = nano::test::make_final_vote (key, { nano::block_hash{ 1 } });
+	cache.insert (vote);
+	ASSERT_FALSE (cache.find (nano::block_hash{ 1 }).empty ());
+	std::this_thread::sleep_for (200ms);
+	ASSERT_TRUE (cache.find (nano::block_hash{ 1 }).empty ());
+
+	// Oldest entries are dropped once over capacity
+	cache.insert (nano::test::make_final_vote (key, { nano::block_hash{ 2 }, nano::block_hash{ 3 }, nano::block_hash{ 4 } }));
+	ASSERT_EQ (2, cache.size ());
+	ASSERT_TRUE (cache.find (nano::block_hash{ 2 }).empty ());
+	ASSERT_FALSE (cache.find (nano::block_hash{ 4 }).empty ());
+}
@@ -474,6 +474,63 @@ TEST (socket, concurrent_writes)
 	{
 		t.join ();
 	}
+
+	// Messages queued while a write is in progress go out together
+	ASSERT_TIMELY_EQ (5s, node->stats.count (nano::stat::type::tcp, nano::stat::detail::tcp_write_message, nano::stat::dir::out), total_message_count);
+	ASSERT_LE (node->stats.count (nano::stat::type::tcp, nano::stat::detail::tcp_write_batch, nano::stat::dir::out), total_message_count);
+	ASSERT_LE (node->stats.count (nano::stat::type::tcp, nano::stat::detail::tcp_write_syscall, nano::stat::dir::out), total_message_count);
+}
+
+namespace
+{
+nano::shared_const_buffer make_buffer (std::size_t size, uint8_t value)
+{
+	return nano::shared_const_buffer{ std::vector<uint8_t> (size, value) };
+}
+}
+
+TEST (socket_queue, weighted_round_robin)
+{
+	nano::transport::socket_queue queue{ 64 };
+	auto const generic_weight = nano::transport::socket_queue::weight (nano::transport::traffic_type::generic);
+	for (std::size_t i = 0; i < 2 * generic_weight; ++i)
+	{
+		ASSERT_TRUE (queue.insert (make_buffer (1, 0), nullptr, nano::transport::traffic_type::generic));
+	}
+	ASSERT_TRUE (queue.insert (make_buffer (1, 1), nullptr, nano::transport::traffic_type::bootstrap));
+	ASSERT_TRUE (queue.insert (make_buffer (1, 1), nullptr, nano::transport::traffic_type::bootstrap));
+
+	// Bootstrap traffic gets its turn after each run of generic traffic instead of waiting for generic traffic to drain
+	auto batch = queue.pop_batch (1024, 1024);
+	ASSERT_EQ (2 * generic_weight + 2, batch.size ());
+	std::vector<uint8_t> order;
+	for (auto const & entry : batch)
+	{
+		order.push_back (entry.buffer.to_bytes ().front ());
+	}
+	std::vector<uint8_t> expected (generic_weight, 0);
+	expected.push_back (1);
+	expected.insert (expected.end (), generic_weight, 0);
+	expected.push_back (1);
+	ASSERT_EQ (expected, order);
+	ASSERT_TRUE (queue.empty ());
+}
+
+TEST (socket_queue, batch_limits)
+{
+	nano::transport::socket_queue queue{ 64 };
+	for (int i = 0; i < 4; ++i)
+	{
+		ASSERT_TRUE (queue.insert (make_buffer (100, 0), nullptr, nano::transport::traffic_type::generic));
+	}
+
+	// Stops before exceeding the byte limit
+	ASSERT_EQ (2, queue.pop_batch (250, 64).size ());
+	// Stops at the entry limit
+	ASSERT_EQ (1, queue.pop_batch (1024, 1).size ());
+	// Oversized messages are still written on their own
+	ASSERT_EQ (1, queue.pop_batch (10, 64).size ());
+	ASSERT_TRUE (queue.pop_batch (1024, 64).empty ());
 }
 
 /**
@@ -283,3 +283,79 @@ TEST (telemetry, ongoing_broadcasts)
 	ASSERT_TIMELY (5s, node1.stats.count (nano::stat::type::telemetry, nano::stat::detail::process) >= 3);
 	ASSERT_TIMELY (5s, node2.stats.count (nano::stat::type::telemetry, nano::stat::detail::process) >= 3)
 }
+
+TEST (telemetry, aggregator)
+{
+	nano::telemetry_aggregator aggregator;
+	ASSERT_FALSE (aggregator.aggregate ());
+
+	auto make = [] (uint64_t block_count, uint8_t major_version) {
+		nano::telemetry_data data;
+		data.block_count = block_count;
+		data.major_version = major_version;
+		data.genesis_block = nano::dev::genesis->hash ();
+		data.timestamp = std::chrono::system_clock::time_point (100ms);
+		return data;
+	};
+	auto data1 = make (10, 27);
+	auto data2 = make (30, 27);
+	auto data3 = make (20, 26);
+	aggregator.insert (data1);
+	aggregator.insert (data2);
+	aggregator.insert (data3);
+	ASSERT_EQ (3, aggregator.size ());
+	auto aggregate = aggregator.aggregate ();
+	ASSERT_TRUE (aggregate);
+	ASSERT_EQ (20, aggregate->block_count);
+	ASSERT_EQ (27, aggregate->major_version);
+	ASSERT_EQ (nano::dev::genesis->hash (), aggregate->genesis_block);
+	ASSERT_EQ (std::chrono::system_clock::time_point (100ms), aggregate->timestamp);
+
+	// Replacing telemetry only changes the aggregate by that entry
+	aggregator.erase (data2);
+	aggregator.insert (make (40, 26));
+	aggregate = aggregator.aggregate ();
+	ASSERT_EQ (3, aggregator.size ());
+	ASSERT_EQ (20, aggregate->block_count);
+	ASSERT_EQ (26, aggregate->major_version);
+
+	aggregator.erase (data1);
+	aggregator.erase (data3);
+	ASSERT_EQ (40, aggregator.aggregate ()->block_count);
+}
+
+TEST (telemetry, snapshot)
+{
+	nano::test::system system;
+	auto & node1 = *system.add_node ();
+	auto & node2 = *system.add_node ();
+
+	ASSERT_TIMELY_EQ (5s, node1.telemetry.snapshot ()->peers.size (), 1);
+	auto snapshot = node1.telemetry.snapshot ();
+	ASSERT_TRUE (snapshot->aggregate);
+	ASSERT_EQ (node2.get_node_id (), snapshot->peers.front ().data.node_id);
+	ASSERT_EQ (nano::dev::genesis->hash (), snapshot->aggregate->genesis_block);
+	ASSERT_GT (node1.stats.count (nano::stat::type::telemetry, nano::stat::detail::snapshot), 0);
+
+	// Binary dump round trip
+	std::vector<uint8_t> bytes;
+	{
+		nano::vectorstream stream{ bytes };
+		snapshot->serialize (stream);
+	}
+	nano::telemetry_snapshot decoded;
+	{
+		nano::bufferstream stream{ bytes.data (), bytes.size () };
+		ASSERT_FALSE (decoded.deserialize (stream));
+	}
+	ASSERT_EQ (1, decoded.peers.size ());
+	ASSERT_EQ (snapshot->peers.front ().endpoint, decoded.peers.front ().endpoint);
+	ASSERT_EQ (snapshot->peers.front ().data, decoded.peers.front ().data);
+	ASSERT_EQ (snapshot->aggregate->block_count, decoded.aggregate->block_count);
+	ASSERT_EQ (std::chrono::floor<std::chrono::milliseconds> (snapshot->generated), decoded.generated);
+
+	// Truncated dumps are rejected
+	nano::telemetry_snapshot truncated;
+	nano::bufferstream stream{ bytes.data (), bytes.size () - 1 };
+	ASSERT_TRUE (truncated.deserialize (stream));
+}
@@ -191,12 +191,14 @@ TEST (toml, daemon_config_deserialize_defaults)
 	ASSERT_EQ (conf.node.unchecked_cutoff_time, defaults.node.unchecked_cutoff_time);
 	ASSERT_EQ (conf.node.use_memory_pools, defaults.node.use_memory_pools);
 	ASSERT_EQ (conf.node.vote_generator_delay, defaults.node.vote_generator_delay);
+	ASSERT_EQ (conf.node.vote_generator_final_read_verification, defaults.node.vote_generator_final_read_verification);
 	ASSERT_EQ (conf.node.vote_minimum, defaults.node.vote_minimum);
 	ASSERT_EQ (conf.node.work_peers, defaults.node.work_peers);
 	ASSERT_EQ (conf.node.work_threads, defaults.node.work_threads);
 	ASSERT_EQ (conf.node.max_queued_requests, defaults.node.max_queued_requests);
 	ASSERT_EQ (conf.node.request_aggregator_threads, defaults.node.request_aggregator_threads);
 	ASSERT_EQ (conf.node.max_unchecked_blocks, defaults.node.max_unchecked_blocks);
+	ASSERT_EQ (conf.node.account_cache_size, defaults.node.account_cache_size);
 	ASSERT_EQ (conf.node.backlog_population.enable, defaults.node.backlog_population.enable);
 	ASSERT_EQ (conf.node.backlog_population.batch_size, defaults.node.backlog_population.batch_size);
 	ASSERT_EQ (conf.node.backlog_population.frequency, defaults.node.backlog_population.frequency);
@@ -262,6 +264,9 @@ TEST (toml, daemon_config_deserialize_defaults)
 	ASSERT_EQ (conf.node.block_processor.priority_live, defaults.node.block_processor.priority_live);
 	ASSERT_EQ (conf.node.block_processor.priority_bootstrap, defaults.node.block_processor.priority_bootstrap);
 	ASSERT_EQ (conf.node.block_processor.priority_local, defaults.node.block_processor.priority_local);
+	ASSERT_EQ (conf.node.block_processor.batch_size_min, defaults.node.block_processor.batch_size_min);
+	ASSERT_EQ (conf.node.block_processor.batch_size_max, defaults.node.block_processor.batch_size_max);
+	ASSERT_EQ (conf.node.block_processor.batch_latency_target, defaults.node.block_processor.batch_latency_target);
 
 	ASSERT_EQ (conf.node.vote_processor.max_pr_queue, defaults.node.vote_processor.max_pr_queue);
 	ASSERT_EQ (conf.node.vote_processor.max_non_pr_queue, defaults.node.vote_processor.max_non_pr_queue);
@@ -273,7 +278,9 @@ TEST (toml, daemon_config_deserialize_defaults)
 	ASSERT_EQ (conf.node.bootstrap_ascending.enable_database_scan, defaults.node.bootstrap_ascending.enable_database_scan);
 	ASSERT_EQ (conf.node.bootstrap_ascending.enable_dependency_walker, defaults.node.bootstrap_ascending.enable_dependency_walker);
 	ASSERT_EQ (conf.node.bootstrap_ascending.channel_limit, defaults.node.bootstrap_ascending.channel_limit);
+	ASSERT_EQ (conf.node.bootstrap_ascending.channel_window, defaults.node.bootstrap_ascending.channel_window);
 	ASSERT_EQ (conf.node.bootstrap_ascending.database_rate_limit, defaults.node.bootstrap_ascending.database_rate_limit);
+	ASSERT_EQ (conf.node.bootstrap_ascending.database_threads, defaults.node.bootstrap_ascending.database_threads);
 	ASSERT_EQ (conf.node.bootstrap_ascending.database_warmup_ratio, defaults.node.bootstrap_ascending.database_warmup_ratio);
 	ASSERT_EQ (conf.node.bootstrap_ascending.max_pull_count, defaults.node.bootstrap_ascending.max_pull_count);
 	ASSERT_EQ (conf.node.bootstrap_ascending.request_timeout, defaults.node.bootstrap_ascending.request_timeout);
@@ -289,6 +296,8 @@ TEST (toml, daemon_config_deserialize_defaults)
 	ASSERT_EQ (conf.node.request_aggregator.max_queue, defaults.node.request_aggregator.max_queue);
 	ASSERT_EQ (conf.node.request_aggregator.threads, defaults.node.request_aggregator.threads);
 	ASSERT_EQ (conf.node.request_aggregator.batch_size, defaults.node.request_aggregator.batch_size);
+	ASSERT_EQ (conf.node.request_aggregator.reply_cache_age, defaults.node.request_aggregator.reply_cache_age);
+	ASSERT_EQ (conf.node.request_aggregator.reply_cache_size, defaults.node.request_aggregator.reply_cache_size);
 
 	ASSERT_EQ (conf.node.message_processor.threads, defaults.node.message_processor.threads);
 	ASSERT_EQ (conf.node.message_processor.max_queue, defaults.node.message_processor.max_queue);
@@ -455,6 +464,7 @@ TEST (toml, daemon_config_deserialize_no_defaults)
 	unchecked_cutoff_time = 999
 	use_memory_pools = false
 	vote_generator_delay = 999
+	vote_generator_final_read_verification = false
 	vote_minimum = "999"
 	work_peers = ["dev.org:999"]
 	work_threads = 999
@@ -462,6 +472,7 @@ TEST (toml, daemon_config_deserialize_no_defaults)
 	max_queued_requests = 999
 	request_aggregator_threads = 999
 	max_unchecked_blocks = 999
+	account_cache_size = 999
 	frontiers_confirmation = "always"
 	enable_upnp = false
 
@@ -476,6 +487,9 @@ TEST (toml, daemon_config_deserialize_no_defaults)
 	priority_live = 999
 	priority_bootstrap = 999
 	priority_local = 999
+	batch_size_min = 999
+	batch_size_max = 9999
+	batch_latency_target = 999
 
 	[node.active_elections]
 	size = 999
@@ -602,7 +616,9 @@ TEST (toml, daemon_config_deserialize_no_defaults)
 	enable_database_scan = false
 	enable_dependency_walker = false
 	channel_limit = 999
+	channel_window = 999
 	database_rate_limit = 999
+	database_threads = 999
 	database_warmup_ratio = 999
 	max_pull_count = 999
 	request_timeout = 999
@@ -620,6 +636,8 @@ TEST (toml, daemon_config_deserialize_no_defaults)
 	max_queue = 999
 	threads = 999
 	batch_size = 999
+	reply_cache_age = 999
+	reply_cache_size = 999
 
 	[node.message_processor]
 	threads = 999
@@ -678,6 +696,7 @@ TEST (toml, daemon_config_deserialize_no_defaults)
 	ASSERT_NE (conf.node.io_threads, defaults.node.io_threads);
 	ASSERT_NE (conf.node.max_work_generate_multiplier, defaults.node.max_work_generate_multiplier);
 	ASSERT_NE (conf.node.max_unchecked_blocks, defaults.node.max_unchecked_blocks);
+	ASSERT_NE (conf.node.account_cache_size, defaults.node.account_cache_size);
 	ASSERT_NE (conf.node.network_threads, defaults.node.network_threads);
 	ASSERT_NE (conf.node.background_threads, defaults.node.background_threads);
 	ASSERT_NE (conf.node.secondary_work_peers, defaults.node.secondary_work_peers);
@@ -698,6 +717,7 @@ TEST (toml, daemon_config_deserialize_no_defaults)
 	ASSERT_NE (conf.node.unchecked_cutoff_time, defaults.node.unchecked_cutoff_time);
 	ASSERT_NE (conf.node.use_memory_pools, defaults.node.use_memory_pools);
 	ASSERT_NE (conf.node.vote_generator_delay, defaults.node.vote_generator_delay);
+	ASSERT_NE (conf.node.vote_generator_final_read_verification, defaults.node.vote_generator_final_read_verification);
 	ASSERT_NE (conf.node.vote_minimum, defaults.node.vote_minimum);
 	ASSERT_NE (conf.node.work_peers, defaults.node.work_peers);
 	ASSERT_NE (conf.node.work_threads, defaults.node.work_threads);
@@ -769,6 +789,9 @@ TEST (toml, daemon_config_deserialize_no_defaults)
 	ASSERT_NE (conf.node.block_processor.priority_live, defaults.node.block_processor.priority_live);
 	ASSERT_NE (conf.node.block_processor.priority_bootstrap, defaults.node.block_processor.priority_bootstrap);
 	ASSERT_NE (conf.node.block_processor.priority_local, defaults.node.block_processor.priority_local);
+	ASSERT_NE (conf.node.block_processor.batch_size_min, defaults.node.block_processor.batch_size_min);
+	ASSERT_NE (conf.node.block_processor.batch_size_max, defaults.node.block_processor.batch_size_max);
+	ASSERT_NE (conf.node.block_processor.batch_latency_target, defaults.node.block_processor.batch_latency_target);
 
 	ASSERT_NE (conf.node.vote_processor.max_pr_queue, defaults.node.vote_processor.max_pr_queue);
 	ASSERT_NE (conf.node.vote_processor.max_non_pr_queue, defaults.node.vote_processor.max_non_pr_queue);
@@ -780,7 +803,9 @@ TEST (toml, daemon_config_deserialize_no_defaults)
 	ASSERT_NE (conf.node.bootstrap_ascending.enable_database_scan, defaults.node.bootstrap_ascending.enable_database_scan);
 	ASSERT_NE (conf.node.bootstrap_ascending.enable_dependency_walker, defaults.node.bootstrap_ascending.enable_dependency_walker);
 	ASSERT_NE (conf.node.bootstrap_ascending.channel_limit, defaults.node.bootstrap_ascending.channel_limit);
+	ASSERT_NE (conf.node.bootstrap_ascending.channel_window, defaults.node.bootstrap_ascending.channel_window);
 	ASSERT_NE (conf.node.bootstrap_ascending.database_rate_limit, defaults.node.bootstrap_ascending.database_rate_limit);
+	ASSERT_NE (conf.node.bootstrap_ascending.database_threads, defaults.node.bootstrap_ascending.database_threads);
 	ASSERT_NE (conf.node.bootstrap_ascending.database_warmup_ratio, defaults.node.bootstrap_ascending.database_warmup_ratio);
 	ASSERT_NE (conf.node.bootstrap_ascending.max_pull_count, defaults.node.bootstrap_ascending.max_pull_count);
 	ASSERT_NE (conf.node.bootstrap_ascending.request_timeout, defaults.node.bootstrap_ascending.request_timeout);
@@ -796,6 +821,8 @@ TEST (toml, daemon_config_deserialize_no_defaults)
 	ASSERT_NE (conf.node.request_aggregator.max_queue, defaults.node.request_aggregator.max_queue);
 	ASSERT_NE (conf.node.request_aggregator.threads, defaults.node.request_aggregator.threads);
 	ASSERT_NE (conf.node.request_aggregator.batch_size, defaults.node.request_aggregator.batch_size);
+	ASSERT_NE (conf.node.request_aggregator.reply_cache_age, defaults.node.request_aggregator.reply_cache_age);
+	ASSERT_NE (conf.node.request_aggregator.reply_cache_size, defaults.node.request_aggregator.reply_cache_size);
 
 	ASSERT_NE (conf.node.message_processor.threads, defaults.node.message_processor.threads);
 	ASSERT_NE (conf.node.message_processor.max_queue, defaults.node.message_processor.max_queue);
@@ -280,3 +280,80 @@ TEST (unchecked, multiple_get)
 	auto unchecked5 = unchecked.get (block2->hash ());
 	ASSERT_EQ (unchecked5.size (), 0);
 }
+
+namespace nano
+{
+// Entries are spread across shards and each shard evicts its oldest entries first once full
+TEST (unchecked, eviction)
+{
+	nano::test::system system{};
+	unsigned const max = 4 * nano::unchecked_map::shard_count;
+	nano::unchecked_map unchecked{ max, system.stats, false };
+	nano::block_builder builder;
+	std::vector<std::shared_ptr<nano::block>> blocks;
+	for (auto i = 0; i < 10 * max; ++i)
+	{
+		// Shards are selected by the sum of the dependency qwords, so consecutive values cycle through every shard
+		nano::block_hash dependency{ 0 };
+		dependency.qwords[0] = i;
+		auto block = builder
+					 .send ()
+					 .previous (dependency)
+					 .destination (1)
+					 .balance (2)
+					 .sign (nano::keypair ().prv, 4)
+					 .work (5)
+					 .build ();
+		ASSERT_EQ (&unchecked.shard_for (dependency), &unchecked.shards[i % nano::unchecked_map::shard_count]);
+		unchecked.put (block->previous (), nano::unchecked_info (block));
+		blocks.push_back (block);
+	}
+	ASSERT_EQ (unchecked.count (), max);
+	// Every shard received the same number of entries and was trimmed to its own limit
+	for (auto const & shard : unchecked.shards)
+	{
+		ASSERT_EQ (shard.entries.size (), unchecked.max_shard_entries);
+	}
+	// The most recently inserted blocks are kept in every shard, older ones are evicted
+	for (size_t i = 0; i < blocks.size (); ++i)
+	{
+		auto const & block = blocks[i];
+		ASSERT_EQ (i >= blocks.size () - max, unchecked.exists (nano::unchecked_key{ block->previous (), block->hash () }));
+	}
+}
+}
+
+// Triggering a batch of dependencies notifies all blocks waiting for any of them and removes them
+TEST (unchecked, trigger_batch)
+{
+	nano::test::system system{};
+	nano::unchecked_map unchecked{ max_unchecked_blocks, system.stats, false };
+	std::atomic<size_t> satisfied{ 0 };
+	unchecked.satisfied.add ([&satisfied] (nano::unchecked_info const &) {
+		++satisfied;
+	});
+	unchecked.start ();
+	nano::block_builder builder;
+	std::deque<nano::hash_or_account> dependencies;
+	for (auto i = 0; i < 8; ++i)
+	{
+		auto block = builder
+					 .send ()
+					 .previous (i + 1)
+					 .destination (1)
+					 .balance (2)
+					 .sign (nano::keypair ().prv, 4)
+					 .work (5)
+					 .build ();
+		unchecked.put (block->previous (), nano::unchecked_info (block));
+		if (i % 2 == 0)
+		{
+			dependencies.push_back (block->previous ());
+		}
+	}
+	ASSERT_EQ (8, unchecked.count ());
+	unchecked.trigger (dependencies);
+	ASSERT_TIMELY_EQ (5s, 4, satisfied);
+	ASSERT_TIMELY_EQ (5s, 4, unchecked.count ());
+	unchecked.stop ();
+}
@@ -367,4 +367,58 @@ TEST (vote_cache, age_cutoff)
 
 	// After 3 seconds the entry should be removed
 	ASSERT_TIMELY (5s, vote_cache.top (0).empty ());
+}
+
+/*
+ * Ensure interned representative ids are released once no entry refers to them
+ */
+TEST (vote_cache, representatives_released)
+{
+	nano::test::system system;
+	nano::vote_cache_config cfg;
+	cfg.max_size = 2;
+	nano::vote_cache vote_cache{ cfg, system.stats };
+	vote_cache.rep_weight_query = rep_weight_query ();
+
+	auto representatives = [&vote_cache] () -> std::size_t {
+		auto info = vote_cache.container_info ();
+		for (auto const & [name, child] : info.children ())
+		{
+			if (name == "representatives")
+			{
+				return child.entries ().front ().size;
+			}
+		}
+		return 0;
+	};
+
+	auto hash1 = nano::test::random_hash ();
+	auto hash2 = nano::test::random_hash ();
+	auto hash3 = nano::test::random_hash ();
+	auto rep1 = create_rep (7);
+	auto rep2 = create_rep (9);
+	auto rep3 = create_rep (11);
+	vote_cache.insert (nano::test::make_vote (rep1, { hash1, hash2 }, 1024 * 1024));
+	vote_cache.insert (nano::test::make_vote (rep2, { hash2 }, 1024 * 1024));
+	ASSERT_EQ (2, vote_cache.size ());
+	ASSERT_EQ (2, vote_cache.find (hash2).size ());
+	ASSERT_EQ (2, representatives ());
+
+	// Overfilling drops the oldest entry (hash1) but rep1 is still referenced by hash2
+	vote_cache.insert (nano::test::make_vote (rep3, { hash3 }, 1024 * 1024));
+	ASSERT_EQ (2, vote_cache.size ());
+	ASSERT_TRUE (vote_cache.find (hash1).empty ());
+	ASSERT_EQ (3, representatives ());
+
+	vote_cache.erase (hash2);
+	ASSERT_EQ (1, representatives ());
+	vote_cache.erase (hash3);
+	ASSERT_EQ (0, representatives ());
+
+	// Ids are recycled for new representatives
+	vote_cache.insert (nano::test::make_vote (rep2, { hash1 }, 1024 * 1024));
+	auto peek = vote_cache.find (hash1);
+	ASSERT_EQ (1, peek.size ());
+	ASSERT_EQ (rep2.pub, peek.front ()->account);
+	ASSERT_EQ (1, representatives ());
 }
\ No newline at end of file
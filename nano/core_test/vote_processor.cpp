@@ -348,3 +348,34 @@ TEST (vote, empty_hashes)
 	nano::keypair key;
 	auto vote = std::make_shared<nano::vote> (key.pub, key.prv, 0, 0, std::vector<nano::block_hash>{} /* empty */);
 }
+
+/**
+ * Test that a vote parsed in place from its serialized form matches the original
+ */
+TEST (vote, view)
+{
+	nano::keypair key;
+	std::vector<nano::block_hash> hashes{ nano::block_hash{ 1 }, nano::block_hash{ 2 }, nano::block_hash{ 3 } };
+	auto vote = std::make_shared<nano::vote> (key.pub, key.prv, nano::vote::timestamp_min * 3, 0, hashes);
+	std::vector<uint8_t> bytes;
+	{
+		nano::vectorstream stream (bytes);
+		vote->serialize (stream);
+	}
+
+	auto view = nano::vote_view::parse (bytes);
+	ASSERT_TRUE (view);
+	ASSERT_EQ (key.pub, view->account ());
+	ASSERT_EQ (3, view->hash_count ());
+	ASSERT_EQ (vote->hash (), view->hash ());
+	ASSERT_EQ (vote->full_hash (), view->full_hash ());
+	auto vote2 = view->to_vote ();
+	ASSERT_EQ (*vote, *vote2);
+	ASSERT_FALSE (vote2->validate ());
+
+	// Truncated hash and missing header
+	ASSERT_FALSE (nano::vote_view::parse ({ bytes.data (), bytes.size () - 1 }));
+	ASSERT_FALSE (nano::vote_view::parse ({ bytes.data (), nano::vote::size (0) - 1 }));
+	// A vote without hashes is still well formed
+	ASSERT_TRUE (nano::vote_view::parse ({ bytes.data (), nano::vote::size (0) }));
+}
@@ -106,9 +106,119 @@ TEST (vote_generator, multiple_representatives)
 			return vote_a->account == account;
 		}));
 		ASSERT_NE (votes.end (), existing);
+		ASSERT_FALSE ((*existing)->validate ());
 	}
 }
 
+TEST (vote_generator, final_read_verification)
+{
+	nano::test::system system (1);
+	auto & node (*system.nodes[0]);
+	ASSERT_TRUE (node.config.vote_generator_final_read_verification);
+	auto epoch1 = system.upgrade_genesis_epoch (node, nano::epoch::epoch_1);
+	system.wallet (0)->insert_adhoc (nano::dev::genesis_key.prv);
+	node.final_generator.add (epoch1->root (), epoch1->hash ());
+	ASSERT_TIMELY (5s, !node.history.votes (epoch1->root (), epoch1->hash (), true).empty ());
+	auto transaction = node.ledger.tx_begin_read ();
+	auto final_votes = node.store.final_vote.get (transaction, epoch1->root ());
+	ASSERT_EQ (1, final_votes.size ());
+	ASSERT_EQ (epoch1->hash (), final_votes[0]);
+	ASSERT_EQ (0, node.stats.count (nano::stat::type::vote_generator, nano::stat::detail::generator_final_conflict));
+}
+
+// A final vote for a competing block stored after verification must not be overwritten or voted against
+TEST (vote_generator, final_conflict)
+{
+	nano::test::system system (1);
+	auto & node (*system.nodes[0]);
+	auto epoch1 = system.upgrade_genesis_epoch (node, nano::epoch::epoch_1);
+	{
+		auto transaction = node.ledger.tx_begin_write ();
+		ASSERT_TRUE (node.store.final_vote.put (transaction, epoch1->qualified_root (), nano::block_hash{ 1 }));
+	}
+	system.wallet (0)->insert_adhoc (nano::dev::genesis_key.prv);
+	node.final_generator.add (epoch1->root (), epoch1->hash ());
+	ASSERT_TIMELY_EQ (5s, 1, node.stats.count (nano::stat::type::vote_generator, nano::stat::detail::generator_final_conflict));
+	ASSERT_TRUE (node.history.votes (epoch1->root (), epoch1->hash (), true).empty ());
+	auto transaction = node.ledger.tx_begin_read ();
+	auto final_votes = node.store.final_vote.get (transaction, epoch1->root ());
+	ASSERT_EQ (1, final_votes.size ());
+	ASSERT_EQ (nano::block_hash{ 1 }, final_votes[0]);
+}
+
+namespace nano
+{
+// Candidates rolled back or conflicted between the read and write passes must not get a final vote
+TEST (vote_generator, final_race)
+{
+	nano::test::system system (1);
+	auto & node (*system.nodes[0]);
+	auto epoch1 = system.upgrade_genesis_epoch (node, nano::epoch::epoch_1);
+	ASSERT_NE (nullptr, epoch1);
+	auto & generator = node.final_generator;
+
+	// Competing final vote stored after verification
+	auto verified = generator.verify_final ({ { epoch1->root (), epoch1->hash () } });
+	ASSERT_EQ (1, verified.size ());
+	{
+		auto transaction = node.ledger.tx_begin_write ();
+		ASSERT_TRUE (node.store.final_vote.put (transaction, epoch1->qualified_root (), nano::block_hash{ 1 }));
+	}
+	ASSERT_TRUE (generator.store_final (verified).empty ());
+	ASSERT_EQ (1, node.stats.count (nano::stat::type::vote_generator, nano::stat::detail::generator_final_conflict));
+	{
+		auto transaction = node.ledger.tx_begin_write ();
+		node.store.final_vote.del (transaction, epoch1->root ());
+	}
+
+	// Block rolled back after verification
+	verified = generator.verify_final ({ { epoch1->root (), epoch1->hash () } });
+	ASSERT_EQ (1, verified.size ());
+	ASSERT_FALSE (node.ledger.rollback (node.ledger.tx_begin_write (), epoch1->hash ()));
+	ASSERT_TRUE (generator.store_final (verified).empty ());
+	ASSERT_EQ (2, node.stats.count (nano::stat::type::vote_generator, nano::stat::detail::generator_final_conflict));
+	auto transaction = node.ledger.tx_begin_read ();
+	ASSERT_TRUE (node.store.final_vote.get (transaction, epoch1->root ()).empty ());
+}
+
+// Votes for many representatives are shared between the generator thread and the signing workers
+TEST (vote_generator, sign_parallel)
+{
+	nano::test::system system;
+	nano::node_config config = system.default_config ();
+	config.signature_checker_threads = 4;
+	auto & node = *system.add_node (config);
+	ASSERT_EQ (4, node.vote_signing_workers.get_num_threads ());
+
+	std::vector<std::pair<nano::public_key, nano::raw_key>> keys;
+	for (auto i = 0; i < 64; ++i)
+	{
+		nano::keypair key;
+		keys.emplace_back (key.pub, key.prv);
+	}
+	std::vector<nano::block_hash> hashes{ nano::block_hash{ 1 }, nano::block_hash{ 2 } };
+	auto votes = node.generator.sign (keys, hashes);
+	ASSERT_EQ (keys.size (), votes.size ());
+	for (std::size_t i = 0; i < keys.size (); ++i)
+	{
+		ASSERT_NE (nullptr, votes[i]);
+		ASSERT_EQ (keys[i].first, votes[i]->account);
+		ASSERT_EQ (hashes, votes[i]->hashes);
+		ASSERT_FALSE (votes[i]->validate ());
+	}
+	ASSERT_LT (0, node.stats.count (nano::stat::type::vote_generator, nano::stat::detail::generator_signed_by_worker));
+}
+}
+
+TEST (vote_generator, signing_workers_voting_disabled)
+{
+	nano::test::system system;
+	nano::node_config config = system.default_config ();
+	config.enable_voting = false;
+	auto & node = *system.add_node (config);
+	ASSERT_EQ (0, node.vote_signing_workers.get_num_threads ());
+}
+
 TEST (vote_spacing, basic)
 {
 	nano::vote_spacing spacing{ std::chrono::milliseconds{ 100 } };
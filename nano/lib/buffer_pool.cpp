@@ -0,0 +1,237 @@
+#include <nano/lib/buffer_pool.hpp>
+#include <nano/lib/locks.hpp>
+#include <nano/lib/memory.hpp>
+#include <nano/lib/utility.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <optional>
+#include <string>
+
+namespace
+{
+using buffer_ptr = std::unique_ptr<std::vector<uint8_t>>;
+
+std::size_t constexpr class_count = std::countr_zero (nano::buffer_pool::max_size) - std::countr_zero (nano::buffer_pool::min_size) + 1;
+
+std::size_t class_bytes (std::size_t index)
+{
+	return nano::buffer_pool::min_size << index;
+}
+
+/** Smallest class holding at least \p size bytes, none if larger than the biggest class */
+std::optional<std::size_t> class_for_size (std::size_t size)
+{
+	if (size > nano::buffer_pool::max_size)
+	{
+		return std::nullopt;
+	}
+	auto rounded = std::bit_ceil (std::max (size, nano::buffer_pool::min_size));
+	return std::countr_zero (rounded) - std::countr_zero (nano::buffer_pool::min_size);
+}
+
+/** Largest class not exceeding \p capacity, buffers which grew past the biggest class or are too small are not kept */
+std::optional<std::size_t> class_for_capacity (std::size_t capacity)
+{
+	if (capacity < nano::buffer_pool::min_size || capacity > nano::buffer_pool::max_size)
+	{
+		return std::nullopt;
+	}
+	return std::countr_zero (std::bit_floor (capacity)) - std::countr_zero (nano::buffer_pool::min_size);
+}
+
+class global_pool
+{
+public:
+	bool put (std::size_t index, buffer_ptr & buffer)
+	{
+		nano::lock_guard<nano::mutex> guard{ mutex };
+		if (free_bytes + class_bytes (index) > nano::buffer_pool::global_limit)
+		{
+			return false;
+		}
+		free_bytes += class_bytes (index);
+		free[index].push_back (std::move (buffer));
+		return true;
+	}
+
+	buffer_ptr take (std::size_t index)
+	{
+		nano::lock_guard<nano::mutex> guard{ mutex };
+		auto & list = free[index];
+		if (list.empty ())
+		{
+			return nullptr;
+		}
+		auto result = std::move (list.back ());
+		list.pop_back ();
+		free_bytes -= class_bytes (index);
+		return result;
+	}
+
+	std::size_t free_count (std::size_t index) const
+	{
+		nano::lock_guard<nano::mutex> guard{ mutex };
+		return free[index].size ();
+	}
+
+public:
+	std::array<std::atomic<uint64_t>, class_count> outstanding{};
+	std::array<std::atomic<uint64_t>, class_count> cached{};
+	std::atomic<uint64_t> allocated{ 0 };
+	std::atomic<uint64_t> reused{ 0 };
+
+private:
+	std::array<std::vector<buffer_ptr>, class_count> free;
+	std::size_t free_bytes{ 0 };
+	mutable nano::mutex mutex;
+};
+
+/** Never destroyed, buffers may still be released while static objects are being torn down */
+global_pool & global ()
+{
+	static auto * instance = new global_pool;
+	return *instance;
+}
+
+/** Trivially destructible so it can still be read while thread local objects are being destroyed */
+thread_local bool local_destroyed{ false };
+
+class local_cache
+{
+public:
+	~local_cache ()
+	{
+		local_destroyed = true;
+		// Hand cached buffers to other threads
+		for (std::size_t index = 0; index < class_count; ++index)
+		{
+			for (auto & buffer : buffers[index])
+			{
+				global ().cached[index]--;
+				global ().put (index, buffer);
+			}
+		}
+	}
+
+	bool put (std::size_t index, buffer_ptr & buffer)
+	{
+		auto & list = buffers[index];
+		if (list.size () >= nano::buffer_pool::local_cache_size)
+		{
+			return false;
+		}
+		list.push_back (std::move (buffer));
+		global ().cached[index]++;
+		return true;
+	}
+
+	buffer_ptr take (std::size_t index)
+	{
+		auto & list = buffers[index];
+		if (list.empty ())
+		{
+			return nullptr;
+		}
+		auto result = std::move (list.back ());
+		list.pop_back ();
+		global ().cached[index]--;
+		return result;
+	}
+
+private:
+	std::array<std::vector<buffer_ptr>, class_count> buffers;
+};
+
+local_cache * local ()
+{
+	if (local_destroyed)
+	{
+		return nullptr;
+	}
+	thread_local local_cache cache;
+	return &cache;
+}
+
+class deleter
+{
+public:
+	std::size_t index;
+
+	void operator() (std::vector<uint8_t> * buffer_a) const
+	{
+		buffer_ptr buffer{ buffer_a };
+		global ().outstanding[index]--;
+
+		// Buffer might have been resized past its original class while in use
+		if (auto index_l = class_for_capacity (buffer->capacity ()))
+		{
+			buffer->clear ();
+			auto cache = local ();
+			if (cache && cache->put (*index_l, buffer))
+			{
+				return;
+			}
+			global ().put (*index_l, buffer);
+		}
+		// Freed here unless ownership was passed to one of the free lists
+	}
+};
+}
+
+auto nano::buffer_pool::acquire (std::size_t size, std::size_t capacity) -> buffer_t
+{
+	auto index = class_for_size (std::max (size, capacity));
+	if (!index || !nano::get_use_memory_pools ())
+	{
+		auto result = std::make_shared<std::vector<uint8_t>> ();
+		result->reserve (std::max (size, capacity));
+		result->resize (size);
+		return result;
+	}
+
+	auto & pool = global ();
+	buffer_ptr buffer;
+	if (auto cache = local ())
+	{
+		buffer = cache->take (*index);
+	}
+	if (!buffer)
+	{
+		buffer = pool.take (*index);
+	}
+	if (buffer)
+	{
+		pool.reused++;
+	}
+	else
+	{
+		pool.allocated++;
+		buffer = std::make_unique<std::vector<uint8_t>> ();
+		buffer->reserve (class_bytes (*index));
+	}
+	debug_assert (buffer->empty () && buffer->capacity () >= class_bytes (*index));
+	buffer->resize (size);
+	pool.outstanding[*index]++;
+	return buffer_t{ buffer.release (), deleter{ *index } };
+}
+
+nano::container_info nano::buffer_pool::container_info ()
+{
+	auto & pool = global ();
+
+	nano::container_info info;
+	for (std::size_t index = 0; index < class_count; ++index)
+	{
+		nano::container_info class_info;
+		class_info.put ("outstanding", pool.outstanding[index], class_bytes (index));
+		class_info.put ("free", pool.free_count (index), class_bytes (index));
+		class_info.put ("thread_cached", pool.cached[index], class_bytes (index));
+		info.add (std::to_string (class_bytes (index)), class_info);
+	}
+	info.put ("allocated", pool.allocated);
+	info.put ("reused", pool.reused);
+	return info;
+}
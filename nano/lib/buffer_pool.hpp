@@ -0,0 +1,39 @@
+#pragma once
+
+#include <nano/lib/container_info.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace nano
+{
+/**
+ * Process wide pool of byte buffers for network reads and message serialization, so connections don't each hold on to
+ * their own worst case sized buffer and sending a message doesn't hit the allocator every time.
+ * Buffers are grouped in power of two size classes. Released buffers go to a small per thread cache first and overflow into
+ * a global free list, both bounded, anything beyond that is freed. Pooling is bypassed when memory pools are disabled.
+ * @note This class is thread-safe.
+ */
+class buffer_pool final
+{
+public:
+	using buffer_t = std::shared_ptr<std::vector<uint8_t>>;
+
+	/** Smallest and largest size class, larger requests are served directly by the allocator */
+	static std::size_t constexpr min_size = 256;
+	static std::size_t constexpr max_size = 128 * 1024;
+	/** Buffers kept per size class in every thread's cache */
+	static std::size_t constexpr local_cache_size = 8;
+	/** Total bytes kept in the global free lists */
+	static std::size_t constexpr global_limit = 32 * 1024 * 1024;
+
+	/**
+	 * Returns a buffer resized to \p size with capacity for at least \p capacity bytes (rounded up to the size class)
+	 * The buffer goes back to the pool once the last reference to it is dropped
+	 */
+	static buffer_t acquire (std::size_t size, std::size_t capacity = 0);
+
+	static nano::container_info container_info ();
+};
+}
@@ -26,6 +26,7 @@ bool nano::logger::global_initialized{ false };
 nano::log_config nano::logger::global_config{};
 std::vector<spdlog::sink_ptr> nano::logger::global_sinks{};
 nano::object_stream_config nano::logger::global_tracing_config{};
+std::unique_ptr<nano::log::trace_recorder> nano::logger::global_trace_recorder{};
 
 // By default, use only the tag as the logger name, since only one node is running in the process
 std::function<std::string (nano::log::logger_id, std::string identifier)> nano::logger::global_name_formatter{ [] (nano::log::logger_id logger_id, std::string identifier) {
@@ -126,6 +127,17 @@ void nano::logger::initialize_common (nano::log_config const & config, std::opti
 	spdlog::set_level (to_spdlog_level (config.default_level));
 
 	global_sinks.clear ();
+	global_trace_recorder.reset ();
+
+	auto make_filename = [] () {
+		auto now = std::chrono::system_clock::now ();
+		auto time = std::chrono::system_clock::to_time_t (now);
+
+		auto filename = fmt::format ("log_{:%Y-%m-%d_%H-%M}-{:%S}", fmt::localtime (time), now.time_since_epoch ());
+		std::replace (filename.begin (), filename.end (), '.', '_'); // Replace millisecond dot separator with underscore
+		return filename;
+	};
+	auto const filename = make_filename ();
 
 	// Console setup
 	if (config.console.enable)
@@ -162,12 +174,6 @@ void nano::logger::initialize_common (nano::log_config const & config, std::opti
 		// In cases where data_path is not available, file logging should always be disabled
 		release_assert (data_path);
 
-		auto now = std::chrono::system_clock::now ();
-		auto time = std::chrono::system_clock::to_time_t (now);
-
-		auto filename = fmt::format ("log_{:%Y-%m-%d_%H-%M}-{:%S}", fmt::localtime (time), now.time_since_epoch ());
-		std::replace (filename.begin (), filename.end (), '.', '_'); // Replace millisecond dot separator with underscore
-
 		std::filesystem::path log_path{ data_path.value () / "log" / (filename + ".log") };
 		log_path = std::filesystem::absolute (log_path);
 
@@ -197,6 +203,36 @@ void nano::logger::initialize_common (nano::log_config const & config, std::opti
 		case nano::log::tracing_format::json:
 			global_tracing_config = nano::object_stream_config::json_config ();
 			break;
+		case nano::log::tracing_format::binary:
+			// Only used for values without a binary encoding, which get formatted when recorded
+			global_tracing_config = nano::object_stream_config::default_config ();
+			break;
+	}
+
+	if (config.tracing_format == nano::log::tracing_format::binary && is_tracing_enabled ())
+	{
+		if (data_path)
+		{
+			std::filesystem::path trace_path{ data_path.value () / "log" / (filename + ".trace") };
+			trace_path = std::filesystem::absolute (trace_path);
+
+			try
+			{
+				global_trace_recorder = std::make_unique<nano::log::trace_recorder> (trace_path);
+				global_trace_recorder->start ();
+
+				std::cerr << "Tracing to file: " << trace_path.string () << std::endl;
+			}
+			catch (std::exception const & ex)
+			{
+				global_trace_recorder.reset ();
+				std::cerr << "WARNING: Unable to create trace file, using standard tracing format: " << ex.what () << std::endl;
+			}
+		}
+		else
+		{
+			std::cerr << "WARNING: Binary tracing needs a data path, using standard tracing format" << std::endl;
+		}
 	}
 }
 
@@ -206,6 +242,10 @@ void nano::logger::flush ()
 	{
 		sink->flush ();
 	}
+	if (global_trace_recorder)
+	{
+		global_trace_recorder->flush ();
+	}
 }
 
 /*
@@ -4,6 +4,7 @@
 #include <nano/lib/object_stream.hpp>
 #include <nano/lib/object_stream_adapters.hpp>
 #include <nano/lib/tomlconfig.hpp>
+#include <nano/lib/trace_recorder.hpp>
 
 #include <initializer_list>
 #include <memory>
@@ -165,6 +166,7 @@ private:
 	static std::vector<spdlog::sink_ptr> global_sinks;
 	static std::function<std::string (nano::log::logger_id, std::string identifier)> global_name_formatter;
 	static nano::object_stream_config global_tracing_config;
+	static std::unique_ptr<nano::log::trace_recorder> global_trace_recorder;
 
 	static void initialize_common (nano::log_config const &, std::optional<std::filesystem::path> data_path);
 
@@ -216,8 +218,19 @@ public:
 			// Include info about precise time of the event
 			auto now = std::chrono::high_resolution_clock::now ();
 
-			// TODO: Improve code indentation config
 			auto & logger = get_logger (type, detail);
+
+			// Binary tracing only copies the arguments here, formatting happens when decoding the trace file
+			if (global_trace_recorder)
+			{
+				if (logger.should_log (spdlog::level::trace))
+				{
+					global_trace_recorder->record (global_tracing_config, type, detail, nano::log::microseconds (now), std::forward<Args> (args)...);
+				}
+				return;
+			}
+
+			// TODO: Improve code indentation config
 			logger.trace ("{}",
 			nano::streamed_args (global_tracing_config,
 			nano::log::arg{ "event", event_formatter{ type, detail } },
@@ -181,6 +181,7 @@ enum class tracing_format
 {
 	standard,
 	json,
+	binary, // Recorded asynchronously to a trace file, see `nano::log::trace_recorder`
 };
 }
 
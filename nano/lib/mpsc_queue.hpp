@@ -0,0 +1,66 @@
+#pragma once
+
+#include <atomic>
+#include <deque>
+
+namespace nano
+{
+/**
+ * Unbounded multi producer queue where pushing never takes a lock
+ * Items are linked into an atomic list with a single compare-exchange, the consumer detaches the whole list at once and
+ * gets the items back in insertion order. Since items are only ever taken all together there is no ABA problem.
+ * @note This class is thread-safe.
+ */
+template <typename T>
+class mpsc_queue final
+{
+public:
+	mpsc_queue () = default;
+	mpsc_queue (mpsc_queue const &) = delete;
+	mpsc_queue & operator= (mpsc_queue const &) = delete;
+
+	~mpsc_queue ()
+	{
+		pop_all ();
+	}
+
+	/** Returns true if the queue was empty before */
+	bool push (T value)
+	{
+		auto item = new node{ std::move (value), head.load (std::memory_order_relaxed) };
+		while (!head.compare_exchange_weak (item->next, item, std::memory_order_release, std::memory_order_relaxed))
+		{
+		}
+		return item->next == nullptr;
+	}
+
+	/** Takes all items pushed so far, oldest first */
+	std::deque<T> pop_all ()
+	{
+		std::deque<T> result;
+		auto current = head.exchange (nullptr, std::memory_order_acquire);
+		while (current != nullptr)
+		{
+			result.push_front (std::move (current->value));
+			auto next = current->next;
+			delete current;
+			current = next;
+		}
+		return result;
+	}
+
+	bool empty () const
+	{
+		return head.load (std::memory_order_acquire) == nullptr;
+	}
+
+private:
+	struct node
+	{
+		T value;
+		node * next;
+	};
+
+	std::atomic<node *> head{ nullptr };
+};
+}
@@ -1,13 +1,14 @@
 #include <nano/crypto_lib/random_pool.hpp>
 #include <nano/lib/blocks.hpp>
-#include <nano/lib/locks.hpp>
 #include <nano/lib/network_filter.hpp>
 #include <nano/lib/stream.hpp>
 #include <nano/secure/common.hpp>
 
+#include <thread>
+
 nano::network_filter::network_filter (size_t size_a, epoch_t age_cutoff_a) :
-	items (size_a, { 0 }),
-	age_cutoff{ age_cutoff_a }
+	age_cutoff{ age_cutoff_a },
+	items (size_a)
 {
 	nano::random_pool::generate_block (key, key.size ());
 }
@@ -15,20 +16,83 @@ nano::network_filter::network_filter (size_t size_a, epoch_t age_cutoff_a) :
 void nano::network_filter::update (epoch_t epoch_inc)
 {
 	debug_assert (epoch_inc > 0);
-	nano::lock_guard<nano::mutex> lock{ mutex };
-	current_epoch += epoch_inc;
+	current_epoch.fetch_add (epoch_inc, std::memory_order_relaxed);
 }
 
-bool nano::network_filter::compare (entry const & existing, digest_t const & digest) const
+uint64_t nano::network_filter::lock (entry & element) const
+{
+	auto sequence = element.sequence.load (std::memory_order_relaxed);
+	while (true)
+	{
+		if (sequence % 2 == 0)
+		{
+			if (element.sequence.compare_exchange_weak (sequence, sequence + 1, std::memory_order_acquire, std::memory_order_relaxed))
+			{
+				// Slot data must not become visible before the odd sequence
+				std::atomic_thread_fence (std::memory_order_release);
+				return sequence;
+			}
+		}
+		else
+		{
+			// Writers only hold a slot for a few stores
+			std::this_thread::yield ();
+			sequence = element.sequence.load (std::memory_order_relaxed);
+		}
+	}
+}
+
+void nano::network_filter::unlock (entry & element, uint64_t sequence) const
+{
+	debug_assert (element.sequence.load () == sequence + 1);
+	element.sequence.store (sequence + 2, std::memory_order_release);
+}
+
+void nano::network_filter::store (entry & element, digest_t const & digest, epoch_t epoch) const
+{
+	debug_assert (element.sequence.load () % 2 == 1);
+	element.digest_high.store (static_cast<uint64_t> (digest >> 64), std::memory_order_relaxed);
+	element.digest_low.store (static_cast<uint64_t> (digest), std::memory_order_relaxed);
+	element.epoch.store (epoch, std::memory_order_relaxed);
+}
+
+bool nano::network_filter::matches (uint64_t digest_high, uint64_t digest_low, epoch_t epoch, digest_t const & digest) const
 {
-	debug_assert (!mutex.try_lock ());
 	// Only consider digests to be the same if the epoch is within the age cutoff
-	return existing.digest == digest && existing.epoch + age_cutoff >= current_epoch;
+	return digest_high == static_cast<uint64_t> (digest >> 64) && digest_low == static_cast<uint64_t> (digest) && epoch + age_cutoff >= current_epoch.load (std::memory_order_relaxed);
+}
+
+bool nano::network_filter::compare (entry const & existing, digest_t const & digest) const
+{
+	while (true)
+	{
+		auto sequence = existing.sequence.load (std::memory_order_acquire);
+		if (sequence % 2 == 0)
+		{
+			auto digest_high = existing.digest_high.load (std::memory_order_relaxed);
+			auto digest_low = existing.digest_low.load (std::memory_order_relaxed);
+			auto epoch = existing.epoch.load (std::memory_order_relaxed);
+			std::atomic_thread_fence (std::memory_order_acquire);
+			if (existing.sequence.load (std::memory_order_relaxed) == sequence)
+			{
+				return matches (digest_high, digest_low, epoch, digest);
+			}
+		}
+		else
+		{
+			std::this_thread::yield ();
+		}
+	}
+}
+
+bool nano::network_filter::compare_locked (entry const & existing, digest_t const & digest) const
+{
+	debug_assert (existing.sequence.load () % 2 == 1);
+	return matches (existing.digest_high.load (std::memory_order_relaxed), existing.digest_low.load (std::memory_order_relaxed), existing.epoch.load (std::memory_order_relaxed), digest);
 }
 
 bool nano::network_filter::apply (uint8_t const * bytes_a, size_t count_a, nano::uint128_t * digest_out)
 {
-	// Get hash before locking
 	auto digest = hash (bytes_a, count_a);
 	if (digest_out)
 	{
@@ -39,15 +103,22 @@ bool nano::network_filter::apply (uint8_t const * bytes_a, size_t count_a, nano:
 
 bool nano::network_filter::apply (digest_t const & digest)
 {
-	nano::lock_guard<nano::mutex> lock{ mutex };
-
 	auto & element = get_element (digest);
-	bool existed = compare (element, digest);
+
+	// Duplicates are the common case when flooded, avoid taking the slot for those
+	if (compare (element, digest))
+	{
+		return true;
+	}
+
+	auto const sequence = lock (element);
+	bool existed = compare_locked (element, digest);
 	if (!existed)
 	{
 		// Replace likely old element with a new one
-		element = { digest, current_epoch };
+		store (element, digest, current_epoch.load (std::memory_order_relaxed));
 	}
+	unlock (element, sequence);
 	return existed;
 }
 
@@ -58,31 +129,26 @@ bool nano::network_filter::check (uint8_t const * bytes, size_t count) const
 
 bool nano::network_filter::check (digest_t const & digest) const
 {
-	nano::lock_guard<nano::mutex> lock{ mutex };
 	auto & element = get_element (digest);
 	return compare (element, digest);
 }
 
 void nano::network_filter::clear (digest_t const & digest)
 {
-	nano::lock_guard<nano::mutex> lock{ mutex };
 	auto & element = get_element (digest);
-	if (compare (element, digest))
+	auto const sequence = lock (element);
+	if (compare_locked (element, digest))
 	{
-		element = { 0 };
+		store (element, 0, 0);
 	}
+	unlock (element, sequence);
 }
 
 void nano::network_filter::clear (std::vector<digest_t> const & digests)
 {
-	nano::lock_guard<nano::mutex> lock{ mutex };
 	for (auto const & digest : digests)
 	{
-		auto & element = get_element (digest);
-		if (compare (element, digest))
-		{
-			element = { 0 };
-		}
+		clear (digest);
 	}
 }
 
@@ -99,8 +165,12 @@ void nano::network_filter::clear (OBJECT const & object_a)
 
 void nano::network_filter::clear ()
 {
-	nano::lock_guard<nano::mutex> lock{ mutex };
-	items.assign (items.size (), { 0 });
+	for (auto & element : items)
+	{
+		auto const sequence = lock (element);
+		store (element, 0, 0);
+		unlock (element, sequence);
+	}
 }
 
 template <typename OBJECT>
@@ -116,7 +186,6 @@ nano::uint128_t nano::network_filter::hash (OBJECT const & object_a) const
 
 auto nano::network_filter::get_element (nano::uint128_t const & hash_a) -> entry &
 {
-	debug_assert (!mutex.try_lock ());
 	debug_assert (items.size () > 0);
 	size_t index (hash_a % items.size ());
 	return items[index];
@@ -124,7 +193,6 @@ auto nano::network_filter::get_element (nano::uint128_t const & hash_a) -> entry
 
 auto nano::network_filter::get_element (nano::uint128_t const & hash_a) const -> entry const &
 {
-	debug_assert (!mutex.try_lock ());
 	debug_assert (items.size () > 0);
 	size_t index (hash_a % items.size ());
 	return items[index];
@@ -6,13 +6,17 @@
 #include <cryptopp/seckey.h>
 #include <cryptopp/siphash.h>
 
+#include <atomic>
+#include <vector>
+
 namespace nano
 {
 /**
  * A probabilistic duplicate filter based on directed map caches, using SipHash 2/4/128
  * The probability of false negatives (unique packet marked as duplicate) is the probability of a 128-bit SipHash collision.
  * The probability of false positives (duplicate packet marked as unique) shrinks with a larger filter.
- * @note This class is thread-safe.
+ * @note This class is thread-safe. There is no global lock, every slot is guarded by its own sequence word (see `entry`),
+ * so concurrent readers never block and writers only contend when hitting the same slot.
  */
 class network_filter final
 {
@@ -85,30 +89,44 @@ public:
 
 private:
 	epoch_t const age_cutoff;
-	epoch_t current_epoch{ 0 };
+	std::atomic<epoch_t> current_epoch{ 0 };
 
 	using siphash_t = CryptoPP::SipHash<2, 4, true>;
 	CryptoPP::SecByteBlock key{ siphash_t::KEYLENGTH };
 
-	mutable nano::mutex mutex{ mutex_identifier (mutexes::network_filter) };
-
 private:
+	/**
+	 * Digest and epoch stored as separate words, kept consistent with a sequence lock:
+	 * writers move `sequence` from even to odd with a CAS, update the slot and release it by bumping `sequence` to the next even value.
+	 * Readers retry whenever `sequence` was odd or changed while they were reading.
+	 */
 	struct entry
 	{
-		digest_t digest;
-		epoch_t epoch;
+		std::atomic<uint64_t> sequence{ 0 };
+		std::atomic<uint64_t> digest_high{ 0 };
+		std::atomic<uint64_t> digest_low{ 0 };
+		std::atomic<epoch_t> epoch{ 0 };
 	};
 
 	std::vector<entry> items;
 
 	/**
 	 * Get element from digest.
-	 * @note must have a lock on mutex
 	 * @return a reference to the element with key \p hash_a
 	 **/
 	entry & get_element (digest_t const & hash);
 	entry const & get_element (digest_t const & hash) const;
 
+	/** Acquires exclusive access to the slot, returns the sequence value to pass to `unlock` */
+	uint64_t lock (entry &) const;
+	void unlock (entry &, uint64_t sequence) const;
+	/** Must be called with the slot locked */
+	void store (entry &, digest_t const & digest, epoch_t epoch) const;
+
+	/** Lock free read, consistent with writers */
 	bool compare (entry const & existing, digest_t const & digest) const;
+	/** Must be called with the slot locked */
+	bool compare_locked (entry const & existing, digest_t const & digest) const;
+	bool matches (uint64_t digest_high, uint64_t digest_low, epoch_t epoch, digest_t const & digest) const;
 };
 }
@@ -428,6 +428,11 @@ bool nano::validate_message (nano::public_key const & public_key, nano::uint256_
 	return validate_message (public_key, message.bytes.data (), sizeof (message.bytes), signature);
 }
 
+bool nano::validate_message_batch (unsigned char const ** messages, size_t * lengths, unsigned char const ** public_keys, unsigned char const ** signatures, size_t num, int * valid)
+{
+	return 0 != ed25519_sign_open_batch (messages, lengths, public_keys, signatures, num, valid);
+}
+
 nano::uint128_union::uint128_union (std::string const & string_a)
 {
 	auto error (decode_hex (string_a));
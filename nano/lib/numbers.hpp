@@ -264,6 +264,11 @@ nano::signature sign_message (nano::raw_key const &, nano::public_key const &, n
 nano::signature sign_message (nano::raw_key const &, nano::public_key const &, uint8_t const *, size_t);
 bool validate_message (nano::public_key const &, nano::uint256_union const &, nano::signature const &);
 bool validate_message (nano::public_key const &, uint8_t const *, size_t, nano::signature const &);
+/**
+ * Verifies \p num signatures at once, which is considerably faster than checking them one by one
+ * \p valid receives 1 for every valid signature and 0 for every invalid one. Returns true if any signature is invalid
+ */
+bool validate_message_batch (unsigned char const ** messages, size_t * lengths, unsigned char const ** public_keys, unsigned char const ** signatures, size_t num, int * valid);
 nano::raw_key deterministic_key (nano::raw_key const &, uint32_t);
 nano::public_key pub_key (nano::raw_key const &);
 
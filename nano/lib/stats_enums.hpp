@@ -19,6 +19,7 @@ enum class type
 	block,
 	ledger,
 	rollback,
+	account_cache,
 	bootstrap,
 	network,
 	tcp_server,
@@ -295,6 +296,9 @@ enum class detail
 	tcp_connect_error,
 	tcp_read_error,
 	tcp_write_error,
+	tcp_write_batch,
+	tcp_write_message,
+	tcp_write_syscall,
 
 	// tcp_listener
 	accept_success,
@@ -335,10 +339,19 @@ enum class detail
 	// ipc
 	invocations,
 
+	// account cache
+	hit_account,
+	miss_account,
+	hit_height,
+	miss_height,
+	hit_confirmed,
+	miss_confirmed,
+
 	// confirmation height
 	blocks_confirmed,
 	blocks_confirmed_unbounded,
 	blocks_confirmed_bounded,
+	height_writes,
 
 	// request aggregator
 	aggregator_accepted,
@@ -357,6 +370,8 @@ enum class detail
 	// request_aggregator
 	request_hashes,
 	overfill_hashes,
+	reply_cache_hit,
+	reply_cache_miss,
 	normal_vote,
 	final_vote,
 
@@ -375,12 +390,15 @@ enum class detail
 	empty_payload,
 	cleanup_outdated,
 	erase_stale,
+	snapshot,
 
 	// vote generator
 	generator_broadcasts,
 	generator_replies,
 	generator_replies_discarded,
 	generator_spacing,
+	generator_final_conflict,
+	generator_signed_by_worker,
 
 	// hinting
 	missing_block,
@@ -443,6 +461,7 @@ enum class detail
 	duplicate_request,
 	invalid_response_type,
 	timestamp_reset,
+	pipelined,
 
 	// bootstrap ascending accounts
 	prioritize,
@@ -546,9 +565,15 @@ enum class sample
 	_invalid = 0, // Default value, should not be used
 
 	active_election_duration,
+	blockprocessor_batch_size,
+	blockprocessor_commit_duration,
+	blockprocessor_refresh_interval,
 	bootstrap_tag_duration,
 	rep_response_time,
+	tcp_write_batch_messages,
 	vote_generator_final_hashes,
+	vote_generator_final_verify_duration,
+	vote_generator_final_write_duration,
 	vote_generator_hashes,
 
 	_last // Must be the last enum
@@ -160,6 +160,12 @@ std::string nano::thread_role::get_string (nano::thread_role::name role)
 		case nano::thread_role::name::monitor:
 			thread_role_name_string = "Monitor";
 			break;
+		case nano::thread_role::name::vote_signing:
+			thread_role_name_string = "Vote signing";
+			break;
+		case nano::thread_role::name::trace_writer:
+			thread_role_name_string = "Trace writer";
+			break;
 		default:
 			debug_assert (false && "nano::thread_role::get_string unhandled thread role");
 	}
@@ -60,6 +60,8 @@ enum class name
 	stats,
 	vote_router,
 	monitor,
+	vote_signing,
+	trace_writer,
 };
 
 std::string_view to_string (name);
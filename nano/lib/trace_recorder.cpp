@@ -0,0 +1,512 @@
+#include <nano/lib/blocks.hpp>
+#include <nano/lib/stream.hpp>
+#include <nano/lib/thread_roles.hpp>
+#include <nano/lib/trace_recorder.hpp>
+#include <nano/lib/utility.hpp>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <limits>
+
+/*
+ * Trace file layout, all integers in native byte order:
+ *   header:  magic (8 bytes), version (u32), type count (u16) + names, detail count (u16) + names; names are u8 length + bytes
+ *   record:  length (u32), time (i64), type (u16), detail (u16), argument count (u8), arguments
+ *   argument: name (u8 length + bytes), kind (u8 trace_value), value
+ *   block value: length (u32), block in wire format, sideband flag (u8), sideband
+ * Enum names are stored in the header so files stay readable after log types or details are added or reordered.
+ */
+
+namespace
+{
+std::array<char, 8> constexpr trace_magic{ 'N', 'A', 'N', 'O', 'T', 'R', 'C', 'E' };
+uint32_t constexpr trace_version = 1;
+
+template <class T>
+void write_raw (std::ostream & os, T const & value)
+{
+	os.write (reinterpret_cast<char const *> (&value), sizeof (value));
+}
+
+template <class T>
+T read_raw (std::istream & is)
+{
+	T value;
+	if (!is.read (reinterpret_cast<char *> (&value), sizeof (value)))
+	{
+		throw std::runtime_error ("Truncated trace file header");
+	}
+	return value;
+}
+
+template <class Enum>
+void write_names (std::ostream & os)
+{
+	auto const count = static_cast<uint16_t> (Enum::_last);
+	write_raw (os, count);
+	for (uint16_t i = 0; i < count; ++i)
+	{
+		auto name = magic_enum::enum_name (static_cast<Enum> (i));
+		auto const size = static_cast<uint8_t> (std::min<std::size_t> (name.size (), std::numeric_limits<uint8_t>::max ()));
+		write_raw (os, size);
+		os.write (name.data (), size);
+	}
+}
+
+std::vector<std::string> read_names (std::istream & is)
+{
+	std::vector<std::string> result (read_raw<uint16_t> (is));
+	for (auto & name : result)
+	{
+		name.resize (read_raw<uint8_t> (is));
+		if (!is.read (name.data (), name.size ()))
+		{
+			throw std::runtime_error ("Truncated trace file header");
+		}
+	}
+	return result;
+}
+
+class thread_ring
+{
+public:
+	uint64_t recorder_id{ std::numeric_limits<uint64_t>::max () };
+	std::shared_ptr<nano::log::trace_ring> ring;
+};
+
+thread_local thread_ring local;
+
+std::atomic<uint64_t> next_recorder_id{ 0 };
+}
+
+/*
+ * trace_encoder
+ */
+
+nano::log::trace_encoder::trace_encoder (std::vector<uint8_t> & buffer_a, nano::object_stream_config const & config_a, nano::log::type type, nano::log::detail detail, int64_t time) :
+	buffer{ buffer_a },
+	config{ config_a },
+	start{ buffer_a.size () }
+{
+	append (uint32_t{ 0 }); // Length, patched by finish ()
+	append (time);
+	append (static_cast<uint16_t> (type));
+	append (static_cast<uint16_t> (detail));
+	append (uint8_t{ 0 }); // Argument count, patched by finish ()
+}
+
+void nano::log::trace_encoder::finish ()
+{
+	uint32_t const length = static_cast<uint32_t> (buffer.size () - start - sizeof (uint32_t));
+	std::memcpy (buffer.data () + start, &length, sizeof (length));
+	buffer[start + sizeof (uint32_t) + sizeof (int64_t) + 2 * sizeof (uint16_t)] = count;
+}
+
+void nano::log::trace_encoder::begin (std::string_view name, trace_value kind)
+{
+	debug_assert (count < std::numeric_limits<uint8_t>::max ());
+	++count;
+	auto const size = static_cast<uint8_t> (std::min<std::size_t> (name.size (), std::numeric_limits<uint8_t>::max ()));
+	append (size);
+	buffer.insert (buffer.end (), name.begin (), name.begin () + size);
+	append (kind);
+}
+
+void nano::log::trace_encoder::append_string (std::string_view value)
+{
+	append (static_cast<uint32_t> (value.size ()));
+	buffer.insert (buffer.end (), value.begin (), value.end ());
+}
+
+void nano::log::trace_encoder::append_block (nano::block const & block)
+{
+	auto const offset = buffer.size ();
+	append (uint32_t{ 0 });
+	{
+		nano::vectorstream stream{ buffer };
+		nano::serialize_block (stream, block);
+		nano::write (stream, static_cast<uint8_t> (block.has_sideband ()));
+		if (block.has_sideband ())
+		{
+			block.sideband ().serialize (stream, block.type ());
+		}
+	}
+	uint32_t const size = static_cast<uint32_t> (buffer.size () - offset - sizeof (uint32_t));
+	std::memcpy (buffer.data () + offset, &size, sizeof (size));
+}
+
+/*
+ * trace_ring
+ */
+
+nano::log::trace_ring::trace_ring (std::size_t capacity_a) :
+	capacity{ capacity_a },
+	data{ std::make_unique<uint8_t[]> (capacity_a) }
+{
+	release_assert (std::has_single_bit (capacity));
+}
+
+bool nano::log::trace_ring::push (std::span<uint8_t const> record)
+{
+	auto const head_l = head.load (std::memory_order_relaxed);
+	auto const tail_l = tail.load (std::memory_order_acquire);
+	if (record.size () > capacity - (head_l - tail_l))
+	{
+		dropped_m.store (dropped_m.load (std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+		return false;
+	}
+	copy_in (head_l, record.data (), record.size ());
+	head.store (head_l + record.size (), std::memory_order_release);
+	recorded_m.store (recorded_m.load (std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+	return true;
+}
+
+void nano::log::trace_ring::copy_in (uint64_t position, uint8_t const * source, std::size_t size)
+{
+	auto const offset = position & (capacity - 1);
+	auto const first = std::min (size, capacity - offset);
+	std::memcpy (data.get () + offset, source, first);
+	std::memcpy (data.get (), source + first, size - first);
+}
+
+std::size_t nano::log::trace_ring::pop (std::vector<uint8_t> & output)
+{
+	auto const tail_l = tail.load (std::memory_order_relaxed);
+	auto const head_l = head.load (std::memory_order_acquire);
+	auto const size = static_cast<std::size_t> (head_l - tail_l);
+	if (size == 0)
+	{
+		return 0;
+	}
+	auto const offset = tail_l & (capacity - 1);
+	auto const first = std::min (size, capacity - offset);
+	output.insert (output.end (), data.get () + offset, data.get () + offset + first);
+	output.insert (output.end (), data.get (), data.get () + (size - first));
+	tail.store (head_l, std::memory_order_release);
+	return size;
+}
+
+std::size_t nano::log::trace_ring::size () const
+{
+	return static_cast<std::size_t> (head.load (std::memory_order_acquire) - tail.load (std::memory_order_acquire));
+}
+
+uint64_t nano::log::trace_ring::recorded () const
+{
+	return recorded_m.load (std::memory_order_relaxed);
+}
+
+uint64_t nano::log::trace_ring::dropped () const
+{
+	return dropped_m.load (std::memory_order_relaxed);
+}
+
+/*
+ * trace_recorder
+ */
+
+nano::log::trace_recorder::trace_recorder (std::filesystem::path const & path, std::size_t ring_size_a, std::chrono::milliseconds interval_a) :
+	id{ next_recorder_id++ },
+	ring_size{ std::bit_ceil (ring_size_a) },
+	interval{ interval_a }
+{
+	if (path.has_parent_path ())
+	{
+		std::filesystem::create_directories (path.parent_path ());
+	}
+	file.open (path, std::ios::binary | std::ios::trunc);
+	if (!file)
+	{
+		throw std::runtime_error ("Unable to open trace file: " + path.string ());
+	}
+	file.write (trace_magic.data (), trace_magic.size ());
+	write_raw (file, trace_version);
+	write_names<nano::log::type> (file);
+	write_names<nano::log::detail> (file);
+	file.flush ();
+}
+
+nano::log::trace_recorder::~trace_recorder ()
+{
+	// Owned by the logger statics, which can be destroyed without an explicit shutdown
+	stop ();
+}
+
+void nano::log::trace_recorder::start ()
+{
+	debug_assert (!thread.joinable ());
+
+	thread = std::thread ([this] {
+		nano::thread_role::set (nano::thread_role::name::trace_writer);
+		run ();
+	});
+}
+
+void nano::log::trace_recorder::stop ()
+{
+	{
+		nano::lock_guard<nano::mutex> guard{ mutex };
+		stopped = true;
+	}
+	condition.notify_all ();
+	if (thread.joinable ())
+	{
+		thread.join ();
+	}
+	drain ();
+}
+
+void nano::log::trace_recorder::run ()
+{
+	nano::unique_lock<nano::mutex> lock{ mutex };
+	while (!stopped)
+	{
+		condition.wait_for (lock, interval);
+		lock.unlock ();
+		drain ();
+		lock.lock ();
+	}
+}
+
+void nano::log::trace_recorder::drain ()
+{
+	nano::lock_guard<nano::mutex> drain_guard{ drain_mutex };
+	{
+		nano::lock_guard<nano::mutex> guard{ mutex };
+		for (auto const & ring : rings)
+		{
+			ring->pop (output);
+		}
+		// Only the recorder still references rings of threads which exited, nothing can be pushed to them anymore
+		std::erase_if (rings, [this] (auto const & ring) {
+			if (ring.use_count () == 1 && ring->size () == 0)
+			{
+				retired_recorded += ring->recorded ();
+				retired_dropped += ring->dropped ();
+				return true;
+			}
+			return false;
+		});
+	}
+	if (!output.empty ())
+	{
+		file.write (reinterpret_cast<char const *> (output.data ()), output.size ());
+		file.flush ();
+		output.clear ();
+	}
+}
+
+void nano::log::trace_recorder::flush ()
+{
+	drain ();
+}
+
+void nano::log::trace_recorder::push (std::vector<uint8_t> const & record)
+{
+	local_ring ().push (record);
+}
+
+nano::log::trace_ring & nano::log::trace_recorder::local_ring ()
+{
+	// Rings are registered once per thread, recording afterwards doesn't touch any shared state
+	if (local.recorder_id != id || !local.ring)
+	{
+		local.ring = std::make_shared<trace_ring> (ring_size);
+		local.recorder_id = id;
+
+		nano::lock_guard<nano::mutex> guard{ mutex };
+		rings.push_back (local.ring);
+	}
+	return *local.ring;
+}
+
+std::vector<uint8_t> & nano::log::trace_recorder::scratch ()
+{
+	thread_local std::vector<uint8_t> buffer;
+	return buffer;
+}
+
+uint64_t nano::log::trace_recorder::recorded () const
+{
+	nano::lock_guard<nano::mutex> guard{ mutex };
+	auto result = retired_recorded;
+	for (auto const & ring : rings)
+	{
+		result += ring->recorded ();
+	}
+	return result;
+}
+
+uint64_t nano::log::trace_recorder::dropped () const
+{
+	nano::lock_guard<nano::mutex> guard{ mutex };
+	auto result = retired_dropped;
+	for (auto const & ring : rings)
+	{
+		result += ring->dropped ();
+	}
+	return result;
+}
+
+/*
+ * trace_decoder
+ */
+
+namespace
+{
+/** Value which was already formatted when the event was recorded */
+class preformatted
+{
+public:
+	std::string_view text;
+};
+
+void stream_as_value (preformatted const & value, nano::object_stream_context & ctx)
+{
+	ctx.begin_stream () << value.text;
+}
+
+/** Bounds checked cursor over a single record */
+class record_reader
+{
+public:
+	std::span<uint8_t const> data;
+	std::size_t position{ 0 };
+
+	std::span<uint8_t const> take (std::size_t size)
+	{
+		if (size > data.size () - position)
+		{
+			throw std::runtime_error ("Corrupted trace record");
+		}
+		auto result = data.subspan (position, size);
+		position += size;
+		return result;
+	}
+
+	template <class T>
+	T take ()
+	{
+		T value;
+		auto bytes = take (sizeof (value));
+		std::memcpy (&value, bytes.data (), sizeof (value));
+		return value;
+	}
+
+	std::string_view take_string (std::size_t size)
+	{
+		auto bytes = take (size);
+		return { reinterpret_cast<char const *> (bytes.data ()), bytes.size () };
+	}
+};
+}
+
+nano::log::trace_decoder::trace_decoder (std::istream & stream_a) :
+	stream{ stream_a }
+{
+	std::array<char, 8> magic{};
+	if (!stream.read (magic.data (), magic.size ()) || magic != trace_magic)
+	{
+		throw std::runtime_error ("Not a trace file");
+	}
+	if (auto version = read_raw<uint32_t> (stream); version != trace_version)
+	{
+		throw std::runtime_error ("Unsupported trace file version: " + std::to_string (version));
+	}
+	type_names = read_names (stream);
+	detail_names = read_names (stream);
+}
+
+std::string_view nano::log::trace_decoder::name_of (std::vector<std::string> const & names, uint16_t index) const
+{
+	return index < names.size () ? std::string_view{ names[index] } : std::string_view{ "unknown" };
+}
+
+bool nano::log::trace_decoder::next (std::ostream & os, nano::object_stream_config const & config)
+{
+	uint32_t length;
+	if (!stream.read (reinterpret_cast<char *> (&length), sizeof (length)))
+	{
+		if (stream.gcount () == 0)
+		{
+			return false; // Clean end of the trace
+		}
+		throw std::runtime_error ("Truncated trace record");
+	}
+	record.resize (length);
+	if (!stream.read (reinterpret_cast<char *> (record.data ()), length))
+	{
+		throw std::runtime_error ("Truncated trace record");
+	}
+
+	record_reader reader{ record };
+	auto const time = reader.take<int64_t> ();
+	auto const type = reader.take<uint16_t> ();
+	auto const detail = reader.take<uint16_t> ();
+	auto const count = reader.take<uint8_t> ();
+
+	// Same leading fields as `nano::logger::trace` writes for the text formats
+	nano::object_stream obs{ os, config };
+	obs.write ("event", std::string{ name_of (type_names, type) } + "::" + std::string{ name_of (detail_names, detail) });
+	obs.write ("time", time);
+
+	for (uint8_t i = 0; i < count; ++i)
+	{
+		auto const name = reader.take_string (reader.take<uint8_t> ());
+		auto const kind = static_cast<trace_value> (reader.take<uint8_t> ());
+		switch (kind)
+		{
+			case trace_value::null:
+				obs.write (name, preformatted{ config.null_value });
+				break;
+			case trace_value::boolean:
+				obs.write (name, reader.take<uint8_t> () != 0);
+				break;
+			case trace_value::signed_integer:
+				obs.write (name, reader.take<int64_t> ());
+				break;
+			case trace_value::unsigned_integer:
+				obs.write (name, reader.take<uint64_t> ());
+				break;
+			case trace_value::floating:
+				obs.write (name, reader.take<double> ());
+				break;
+			case trace_value::string:
+				obs.write (name, std::string{ reader.take_string (reader.take<uint32_t> ()) });
+				break;
+			case trace_value::text:
+				obs.write (name, preformatted{ reader.take_string (reader.take<uint32_t> ()) });
+				break;
+			case trace_value::number:
+			{
+				nano::uint256_union value;
+				auto bytes = reader.take (value.bytes.size ());
+				std::copy (bytes.begin (), bytes.end (), value.bytes.begin ());
+				obs.write (name, value);
+				break;
+			}
+			case trace_value::block:
+			{
+				auto bytes = reader.take (reader.take<uint32_t> ());
+				nano::bufferstream block_stream{ bytes.data (), bytes.size () };
+				auto block = nano::deserialize_block (block_stream);
+				uint8_t has_sideband{ 0 };
+				if (block && !nano::try_read (block_stream, has_sideband) && has_sideband)
+				{
+					nano::block_sideband sideband;
+					if (!sideband.deserialize (block_stream, block->type ()))
+					{
+						block->sideband_set (sideband);
+					}
+				}
+				obs.write (name, block);
+				break;
+			}
+			default:
+				throw std::runtime_error ("Unknown trace value kind: " + std::to_string (static_cast<int> (kind)));
+		}
+	}
+	os << config.newline;
+	return true;
+}
@@ -0,0 +1,273 @@
+#pragma once
+
+#include <nano/lib/locks.hpp>
+#include <nano/lib/logging_enums.hpp>
+#include <nano/lib/object_stream.hpp>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <concepts>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <istream>
+#include <memory>
+#include <span>
+#include <sstream>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <magic_enum.hpp>
+
+namespace nano
+{
+class block;
+}
+
+namespace nano::log
+{
+/**
+ * Kind tag stored in front of every argument of a binary trace record
+ * Part of the trace file format, only ever append new kinds
+ */
+enum class trace_value : uint8_t
+{
+	null,
+	boolean,
+	signed_integer,
+	unsigned_integer,
+	floating,
+	string, // Strings and enum names, quoted when decoded
+	text, // Preformatted on the calling thread, for types without a binary encoding
+	number, // 256 bit values: hashes, accounts, links, roots
+	block,
+};
+
+/**
+ * Serializes a single trace event into a binary trace record
+ * Plain values are copied as is and blocks are stored in their wire format, formatting is left to the decoder.
+ * Only types without a binary encoding are formatted on the calling thread.
+ */
+class trace_encoder final
+{
+public:
+	trace_encoder (std::vector<uint8_t> & buffer, nano::object_stream_config const &, nano::log::type, nano::log::detail, int64_t time);
+
+	template <class T>
+	void write (std::string_view name, T const & value)
+	{
+		if constexpr (std::is_same_v<T, bool>)
+		{
+			begin (name, trace_value::boolean);
+			append (static_cast<uint8_t> (value));
+		}
+		else if constexpr (std::is_enum_v<T>)
+		{
+			if (auto enum_name = magic_enum::enum_name (value); !enum_name.empty ())
+			{
+				begin (name, trace_value::string);
+				append_string (enum_name);
+			}
+			else
+			{
+				write (name, static_cast<std::underlying_type_t<T>> (value));
+			}
+		}
+		else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>)
+		{
+			begin (name, trace_value::signed_integer);
+			append (static_cast<int64_t> (value));
+		}
+		else if constexpr (std::is_integral_v<T>)
+		{
+			begin (name, trace_value::unsigned_integer);
+			append (static_cast<uint64_t> (value));
+		}
+		else if constexpr (std::is_floating_point_v<T>)
+		{
+			begin (name, trace_value::floating);
+			append (static_cast<double> (value));
+		}
+		else if constexpr (std::is_convertible_v<T const &, std::string_view>)
+		{
+			begin (name, trace_value::string);
+			append_string (value);
+		}
+		else if constexpr (std::is_base_of_v<nano::block, T>)
+		{
+			begin (name, trace_value::block);
+			append_block (value);
+		}
+		else if constexpr (requires { { value.bytes } -> std::same_as<std::array<uint8_t, 32> const &>; })
+		{
+			begin (name, trace_value::number);
+			buffer.insert (buffer.end (), value.bytes.begin (), value.bytes.end ());
+		}
+		else if constexpr (requires { static_cast<bool> (value); *value; })
+		{
+			// Smart pointers and optionals
+			if (value)
+			{
+				write (name, *value);
+			}
+			else
+			{
+				begin (name, trace_value::null);
+			}
+		}
+		else
+		{
+			std::ostringstream os;
+			nano::object_stream_context ctx{ os, config };
+			using nano::stream_as_value;
+			stream_as_value (value, ctx);
+			begin (name, trace_value::text);
+			append_string (os.view ());
+		}
+	}
+
+	/** Patches the record header, the record must not be used afterwards */
+	void finish ();
+
+private:
+	void begin (std::string_view name, trace_value);
+	void append_string (std::string_view);
+	void append_block (nano::block const &);
+
+	template <class T>
+	void append (T const & value)
+	{
+		static_assert (std::is_trivially_copyable_v<T>);
+		auto const * bytes = reinterpret_cast<uint8_t const *> (&value);
+		buffer.insert (buffer.end (), bytes, bytes + sizeof (value));
+	}
+
+private:
+	std::vector<uint8_t> & buffer;
+	nano::object_stream_config const & config;
+	std::size_t const start;
+	uint8_t count{ 0 };
+};
+
+/**
+ * Byte ring holding length prefixed trace records of a single thread
+ * Only the owning thread pushes and only the trace writer thread pops, neither side ever waits for the other.
+ * Records which don't fit into the free space are dropped instead of blocking the producer.
+ */
+class trace_ring final
+{
+public:
+	/** @param capacity must be a power of two */
+	explicit trace_ring (std::size_t capacity);
+
+	/** Producer side, returns false if the record was dropped */
+	bool push (std::span<uint8_t const> record);
+	/** Consumer side, appends all complete records to \p output, returns number of bytes taken */
+	std::size_t pop (std::vector<uint8_t> & output);
+
+	std::size_t size () const;
+	uint64_t recorded () const;
+	uint64_t dropped () const;
+
+private:
+	void copy_in (uint64_t position, uint8_t const * data, std::size_t size);
+
+private:
+	std::size_t const capacity;
+	std::unique_ptr<uint8_t[]> data;
+
+	alignas (64) std::atomic<uint64_t> head{ 0 }; // Advanced by the producer
+	std::atomic<uint64_t> recorded_m{ 0 }; // Written by the producer only
+	std::atomic<uint64_t> dropped_m{ 0 }; // Written by the producer only
+	alignas (64) std::atomic<uint64_t> tail{ 0 }; // Advanced by the consumer
+};
+
+/**
+ * Asynchronous binary trace sink, used when the tracing format is `binary`
+ * Events are encoded into a ring owned by the calling thread, a background thread periodically drains all rings into the trace file.
+ * Recording an event never takes a lock once the thread has its ring, events are dropped when a ring is full.
+ * Trace files are turned back into text with `trace_decoder`.
+ */
+class trace_recorder final
+{
+public:
+	static std::size_t constexpr default_ring_size = 256 * 1024;
+
+	trace_recorder (std::filesystem::path const & path, std::size_t ring_size = default_ring_size, std::chrono::milliseconds interval = std::chrono::milliseconds{ 100 });
+	~trace_recorder ();
+
+	void start ();
+	void stop ();
+
+	template <class... Args>
+	void record (nano::object_stream_config const & config, nano::log::type type, nano::log::detail detail, int64_t time, Args &&... args)
+	{
+		auto & buffer = scratch ();
+		buffer.clear ();
+		trace_encoder encoder{ buffer, config, type, detail, time };
+		((encoder.write (args.name, args.value)), ...);
+		encoder.finish ();
+		push (buffer);
+	}
+
+	/** Blocks until all events recorded so far are written to the trace file */
+	void flush ();
+
+	uint64_t recorded () const;
+	uint64_t dropped () const;
+
+private:
+	void push (std::vector<uint8_t> const & record);
+	trace_ring & local_ring ();
+	void run ();
+	void drain ();
+
+	static std::vector<uint8_t> & scratch ();
+
+private:
+	uint64_t const id;
+	std::size_t const ring_size;
+	std::chrono::milliseconds const interval;
+
+	std::ofstream file;
+	std::vector<std::shared_ptr<trace_ring>> rings;
+	std::vector<uint8_t> output;
+
+	uint64_t retired_recorded{ 0 };
+	uint64_t retired_dropped{ 0 };
+
+	bool stopped{ false };
+	mutable nano::mutex mutex;
+	nano::mutex drain_mutex; // Serializes drains from the writer thread and explicit flushes
+	nano::condition_variable condition;
+	std::thread thread;
+};
+
+/**
+ * Reads binary trace files, writing each event as a line in the same layout the text tracing formats use
+ */
+class trace_decoder final
+{
+public:
+	/** @throws std::runtime_error if the stream does not start with a trace file header */
+	explicit trace_decoder (std::istream &);
+
+	/**
+	 * Decodes the next event into \p os
+	 * @returns false once the end of the trace is reached
+	 * @throws std::runtime_error on corrupted records
+	 */
+	bool next (std::ostream & os, nano::object_stream_config const & = nano::object_stream_config::default_config ());
+
+private:
+	std::string_view name_of (std::vector<std::string> const & names, uint16_t index) const;
+
+private:
+	std::istream & stream;
+	std::vector<std::string> type_names;
+	std::vector<std::string> detail_names;
+	std::vector<uint8_t> record;
+};
+}
@@ -23,7 +23,16 @@ public:
 		}
 
 		// Types used as value need to provide full_hash()
-		Key hash = value->full_hash ();
+		return unique (value->full_hash (), value);
+	}
+
+	/**
+	 * Same as above, for callers which already computed the full hash of \p value
+	 */
+	std::shared_ptr<Value> unique (Key const & hash, std::shared_ptr<Value> const & value)
+	{
+		debug_assert (value != nullptr);
+		debug_assert (hash == value->full_hash ());
 
 		nano::lock_guard<nano::mutex> guard{ mutex };
 
@@ -45,6 +54,19 @@ public:
 		return value;
 	}
 
+	/**
+	 * @return live instance with the given full hash, or nullptr if there is none
+	 */
+	std::shared_ptr<Value> find (Key const & hash) const
+	{
+		nano::lock_guard<nano::mutex> guard{ mutex };
+		if (auto existing = values.find (hash); existing != values.end ())
+		{
+			return existing->second.lock ();
+		}
+		return nullptr;
+	}
+
 	std::size_t size () const
 	{
 		nano::lock_guard<nano::mutex> guard{ mutex };
@@ -2,6 +2,7 @@
 #include <nano/lib/blocks.hpp>
 #include <nano/lib/cli.hpp>
 #include <nano/lib/thread_runner.hpp>
+#include <nano/lib/trace_recorder.hpp>
 #include <nano/lib/utility.hpp>
 #include <nano/nano_node/daemon.hpp>
 #include <nano/node/active_elections.hpp>
@@ -15,7 +16,11 @@
 #include <nano/node/transport/inproc.hpp>
 #include <nano/secure/ledger.hpp>
 #include <nano/secure/ledger_set_any.hpp>
+#include <nano/secure/ledger_validator.hpp>
+#include <nano/store/account.hpp>
+#include <nano/store/confirmation_height.hpp>
 #include <nano/store/pending.hpp>
+#include <nano/store/unconfirmed.hpp>
 
 #include <boost/dll/runtime_symbol_info.hpp>
 #include <boost/format.hpp>
@@ -32,6 +37,7 @@
 #include <boost/unordered_map.hpp>
 #include <boost/unordered_set.hpp>
 
+#include <map>
 #include <numeric>
 #include <sstream>
 
@@ -121,6 +127,7 @@ int main (int argc, char * const * argv)
 		("debug_output_last_backtrace_dump", "Displays the contents of the latest backtrace in the event of a nano_node crash")
 		("debug_generate_crash_report", "Consolidates the nano_node_backtrace.dump file. Requires addr2line installed on Linux")
 		("debug_sys_logging", "Test the system logger")
+		("debug_trace_decode", "Decode a binary trace file given with --file into text")
 		("debug_verify_profile", "Profile signature verification")
 		("debug_verify_profile_batch", "Profile batch signature verification")
 		("debug_profile_bootstrap", "Profile bootstrap style blocks processing (at least 10GB of free storage space required)")
@@ -1351,6 +1358,30 @@ int main (int argc, char * const * argv)
 				std::cout.write (reinterpret_cast<char const *> (seed.bytes.data ()), seed.bytes.size ());
 			}
 		}
+		else if (vm.count ("debug_trace_decode"))
+		{
+			if (vm.count ("file") == 1)
+			{
+				std::ifstream stream{ vm["file"].as<std::string> (), std::ios::binary };
+				try
+				{
+					nano::log::trace_decoder decoder{ stream };
+					while (decoder.next (std::cout))
+					{
+					}
+				}
+				catch (std::runtime_error const & ex)
+				{
+					std::cerr << "Error decoding trace file: " << ex.what () << std::endl;
+					result = -1;
+				}
+			}
+			else
+			{
+				std::cerr << "debug_trace_decode requires one <file> option\n";
+				result = -1;
+			}
+		}
 		else if (vm.count ("debug_rpc"))
 		{
 			std::string rpc_input_l;
@@ -1386,7 +1417,7 @@ int main (int argc, char * const * argv)
 			nano::inactive_node inactive_node (data_path, node_flags);
 			auto node = inactive_node.node;
 			bool const silent (vm.count ("silent"));
-			unsigned threads_count (1);
+			unsigned threads_count (nano::hardware_concurrency ());
 			auto threads_it = vm.find ("threads");
 			if (threads_it != vm.end ())
 			{
@@ -1397,425 +1428,66 @@ int main (int argc, char * const * argv)
 				}
 			}
 			threads_count = std::max (1u, threads_count);
-			std::vector<std::thread> threads;
-			nano::mutex mutex;
-			nano::condition_variable condition;
-			std::atomic<bool> finished (false);
-			std::deque<std::pair<nano::account, nano::account_info>> accounts;
-			std::atomic<size_t> count (0);
-			std::atomic<uint64_t> block_count (0);
-			std::atomic<uint64_t> errors (0);
-
-			auto print_error_message = [&silent, &errors] (std::string const & error_message_a) {
+
+			auto print_error_message = [&silent] (std::string const & error_message_a) {
 				if (!silent)
 				{
 					static nano::mutex cerr_mutex;
 					nano::lock_guard<nano::mutex> lock{ cerr_mutex };
 					std::cerr << error_message_a;
 				}
-				++errors;
-			};
-
-			auto start_threads = [node, &threads_count, &threads, &mutex, &condition, &finished] (auto const & function_a, auto & deque_a) {
-				for (auto i (0U); i < threads_count; ++i)
-				{
-					threads.emplace_back ([&function_a, node, &mutex, &condition, &finished, &deque_a] () {
-						auto transaction = node->ledger.tx_begin_read ();
-						nano::unique_lock<nano::mutex> lock{ mutex };
-						while (!deque_a.empty () || !finished)
-						{
-							while (deque_a.empty () && !finished)
-							{
-								condition.wait (lock);
-							}
-							if (!deque_a.empty ())
-							{
-								auto pair (deque_a.front ());
-								deque_a.pop_front ();
-								lock.unlock ();
-								function_a (node, transaction, pair.first, pair.second);
-								lock.lock ();
-							}
-						}
-					});
-				}
 			};
+			nano::ledger_validator validator{ node->ledger, threads_count, print_error_message };
 
-			auto check_account = [&print_error_message, &silent, &count, &block_count] (std::shared_ptr<nano::node> const & node, nano::secure::read_transaction const & transaction, nano::account const & account, nano::account_info const & info) {
-				++count;
-				if (!silent && (count % 20000) == 0)
-				{
-					std::cout << boost::str (boost::format ("%1% accounts validated\n") % count);
-				}
-				nano::confirmation_height_info confirmation_height_info;
-				node->store.confirmation_height.get (transaction, account, confirmation_height_info);
-
-				if (confirmation_height_info.height > info.block_count)
-				{
-					print_error_message (boost::str (boost::format ("Confirmation height %1% greater than block count %2% for account: %3%\n") % confirmation_height_info.height % info.block_count % account.to_account ()));
-				}
-
-				auto hash (info.open_block);
-				nano::block_hash calculated_hash (0);
-				auto block = node->ledger.any.block_get (transaction, hash); // Block data
-				uint64_t height (0);
-				if (node->ledger.pruning && confirmation_height_info.height != 0)
-				{
-					hash = confirmation_height_info.frontier;
-					block = node->ledger.any.block_get (transaction, hash);
-					// Iteration until pruned block
-					bool pruned_block (false);
-					while (!pruned_block && !block->previous ().is_zero ())
-					{
-						auto previous_block = node->ledger.any.block_get (transaction, block->previous ());
-						if (previous_block != nullptr)
-						{
-							hash = previous_block->hash ();
-							block = previous_block;
-						}
-						else
-						{
-							pruned_block = true;
-							if (!node->store.pruned.exists (transaction, block->previous ()))
-							{
-								print_error_message (boost::str (boost::format ("Pruned previous block does not exist %1%\n") % block->previous ().to_string ()));
-							}
-						}
-					}
-					calculated_hash = block->previous ();
-					height = block->sideband ().height - 1;
-					if (!node->ledger.any.block_exists_or_pruned (transaction, info.open_block))
-					{
-						print_error_message (boost::str (boost::format ("Open block does not exist %1%\n") % info.open_block.to_string ()));
-					}
-				}
-				uint64_t previous_timestamp (0);
-				nano::account calculated_representative{};
-				while (!hash.is_zero () && block != nullptr)
-				{
-					++block_count;
-					auto const & sideband (block->sideband ());
-					// Check for state & open blocks if account field is correct
-					if (block->type () == nano::block_type::open || block->type () == nano::block_type::state)
-					{
-						if (block->account () != account)
-						{
-							print_error_message (boost::str (boost::format ("Incorrect account field for block %1%\n") % hash.to_string ()));
-						}
-					}
-					// Check if sideband account is correct
-					else if (sideband.account != account)
-					{
-						print_error_message (boost::str (boost::format ("Incorrect sideband account for block %1%\n") % hash.to_string ()));
-					}
-					// Check if previous field is correct
-					if (calculated_hash != block->previous ())
-					{
-						print_error_message (boost::str (boost::format ("Incorrect previous field for block %1%\n") % hash.to_string ()));
-					}
-					// Check if previous & type for open blocks are correct
-					if (height == 0 && !block->previous ().is_zero ())
-					{
-						print_error_message (boost::str (boost::format ("Incorrect previous for open block %1%\n") % hash.to_string ()));
-					}
-					if (height == 0 && block->type () != nano::block_type::open && block->type () != nano::block_type::state)
-					{
-						print_error_message (boost::str (boost::format ("Incorrect type for open block %1%\n") % hash.to_string ()));
-					}
-					// Check if block data is correct (calculating hash)
-					calculated_hash = block->hash ();
-					if (calculated_hash != hash)
-					{
-						print_error_message (boost::str (boost::format ("Invalid data inside block %1% calculated hash: %2%\n") % hash.to_string () % calculated_hash.to_string ()));
-					}
-					// Check if block signature is correct
-					if (validate_message (account, hash, block->block_signature ()))
-					{
-						bool invalid (true);
-						// Epoch blocks
-						if (block->type () == nano::block_type::state)
-						{
-							auto & state_block (static_cast<nano::state_block &> (*block.get ()));
-							nano::amount prev_balance (0);
-							bool error_or_pruned (false);
-							if (!state_block.hashables.previous.is_zero ())
-							{
-								prev_balance = node->ledger.any.block_balance (transaction, state_block.hashables.previous).value_or (0);
-							}
-							if (node->ledger.is_epoch_link (state_block.hashables.link))
-							{
-								if ((state_block.hashables.balance == prev_balance && !error_or_pruned) || (node->ledger.pruning && error_or_pruned && block->sideband ().details.is_epoch))
-								{
-									invalid = validate_message (node->ledger.epoch_signer (block->link_field ().value ()), hash, block->block_signature ());
-								}
-							}
-						}
-						if (invalid)
-						{
-							print_error_message (boost::str (boost::format ("Invalid signature for block %1%\n") % hash.to_string ()));
-						}
-					}
-					// Validate block details set in the sideband
-					bool block_details_error = false;
-					if (block->type () != nano::block_type::state)
-					{
-						// Not state
-						block_details_error = sideband.details.is_send || sideband.details.is_receive || sideband.details.is_epoch;
-					}
-					else
-					{
-						auto prev_balance = node->ledger.any.block_balance (transaction, block->previous ());
-						if (!node->ledger.pruning || prev_balance)
-						{
-							if (block->balance () < prev_balance.value ())
-							{
-								// State send
-								block_details_error = !sideband.details.is_send || sideband.details.is_receive || sideband.details.is_epoch;
-							}
-							else
-							{
-								if (block->is_change ())
-								{
-									// State change
-									block_details_error = sideband.details.is_send || sideband.details.is_receive || sideband.details.is_epoch;
-								}
-								else if (block->balance () == prev_balance.value () && node->ledger.is_epoch_link (block->link_field ().value ()))
-								{
-									// State epoch
-									block_details_error = !sideband.details.is_epoch || sideband.details.is_send || sideband.details.is_receive;
-								}
-								else
-								{
-									// State receive
-									block_details_error = !sideband.details.is_receive || sideband.details.is_send || sideband.details.is_epoch;
-									block_details_error |= !node->ledger.any.block_exists_or_pruned (transaction, block->source ());
-								}
-							}
-						}
-						else if (!node->store.pruned.exists (transaction, block->previous ()))
-						{
-							print_error_message (boost::str (boost::format ("Previous pruned block does not exist %1%\n") % block->previous ().to_string ()));
-						}
-					}
-					if (block_details_error)
-					{
-						print_error_message (boost::str (boost::format ("Incorrect sideband block details for block %1%\n") % hash.to_string ()));
-					}
-					// Check link epoch version
-					if (sideband.details.is_receive && (!node->ledger.pruning || !node->store.pruned.exists (transaction, block->source ())))
-					{
-						if (sideband.source_epoch != node->ledger.version (*block))
-						{
-							print_error_message (boost::str (boost::format ("Incorrect source epoch for block %1%\n") % hash.to_string ()));
-						}
-					}
-					// Check if block work value is correct
-					if (node->network_params.work.difficulty (*block) < node->network_params.work.threshold (block->work_version (), block->sideband ().details))
-					{
-						print_error_message (boost::str (boost::format ("Invalid work for block %1% value: %2%\n") % hash.to_string () % nano::to_string_hex (block->block_work ())));
-					}
-					// Check if sideband height is correct
-					++height;
-					if (sideband.height != height)
-					{
-						print_error_message (boost::str (boost::format ("Incorrect sideband height for block %1%. Sideband: %2%. Expected: %3%\n") % hash.to_string () % sideband.height % height));
-					}
-					// Check if sideband timestamp is after previous timestamp
-					if (sideband.timestamp < previous_timestamp)
-					{
-						print_error_message (boost::str (boost::format ("Incorrect sideband timestamp for block %1%\n") % hash.to_string ()));
-					}
-					previous_timestamp = sideband.timestamp;
-					// Calculate representative block
-					if (block->type () == nano::block_type::open || block->type () == nano::block_type::change || block->type () == nano::block_type::state)
-					{
-						calculated_representative = block->representative_field ().value ();
-					}
-					// Retrieving successor block hash
-					hash = node->ledger.any.block_successor (transaction, hash).value_or (0);
-					// Retrieving block data
-					if (!hash.is_zero ())
-					{
-						block = node->ledger.any.block_get (transaction, hash);
-					}
-				}
-				// Check if required block exists
-				if (!hash.is_zero () && block == nullptr)
-				{
-					print_error_message (boost::str (boost::format ("Required block in account %1% chain was not found in ledger: %2%\n") % account.to_account () % hash.to_string ()));
-				}
-				// Check account block count
-				if (info.block_count != height)
-				{
-					print_error_message (boost::str (boost::format ("Incorrect block count for account %1%. Actual: %2%. Expected: %3%\n") % account.to_account () % height % info.block_count));
-				}
-				// Check account head block (frontier)
-				if (info.head != calculated_hash)
-				{
-					print_error_message (boost::str (boost::format ("Incorrect frontier for account %1%. Actual: %2%. Expected: %3%\n") % account.to_account () % calculated_hash.to_string () % info.head.to_string ()));
-				}
-				// Check account representative block
-				if (info.representative != calculated_representative)
-				{
-					print_error_message (boost::str (boost::format ("Incorrect representative for account %1%. Actual: %2%. Expected: %3%\n") % account.to_account () % calculated_representative.to_string () % info.representative.to_string ()));
-				}
-			};
-
-			start_threads (check_account, accounts);
-
+			// Periodically report progress while the validation threads are running
+			nano::mutex progress_mutex;
+			nano::condition_variable progress_condition;
+			bool progress_stopped{ false };
+			std::thread progress_thread;
 			if (!silent)
 			{
-				std::cout << boost::str (boost::format ("Performing %1% threads blocks hash, signature, work validation...\n") % threads_count);
-			}
-			size_t const accounts_deque_overflow (32 * 1024);
-			auto transaction = node->ledger.tx_begin_read ();
-			for (auto i (node->store.account.begin (transaction)), n (node->store.account.end (transaction)); i != n; ++i)
-			{
-				{
-					nano::unique_lock<nano::mutex> lock{ mutex };
-					if (accounts.size () > accounts_deque_overflow)
+				progress_thread = std::thread ([&validator, &progress_mutex, &progress_condition, &progress_stopped] () {
+					auto const start = std::chrono::steady_clock::now ();
+					nano::unique_lock<nano::mutex> lock{ progress_mutex };
+					while (!progress_condition.wait_for (lock, std::chrono::seconds (5), [&progress_stopped] { return progress_stopped; }))
 					{
-						auto wait_ms (250 * accounts.size () / accounts_deque_overflow);
-						auto const wakeup (std::chrono::steady_clock::now () + std::chrono::milliseconds (wait_ms));
-						condition.wait_until (lock, wakeup);
+						auto const elapsed = std::chrono::duration_cast<std::chrono::seconds> (std::chrono::steady_clock::now () - start).count ();
+						auto const blocks = validator.blocks ();
+						std::cout << boost::str (boost::format ("%1% accounts, %2% blocks, %3% pending validated (%4% blocks/sec)\n") % validator.accounts () % blocks % validator.pending () % (blocks / std::max<int64_t> (elapsed, 1)));
 					}
-					accounts.emplace_back (i->first, i->second);
-				}
-				condition.notify_all ();
-			}
-			{
-				nano::lock_guard<nano::mutex> lock{ mutex };
-				finished = true;
-			}
-			condition.notify_all ();
-			for (auto & thread : threads)
-			{
-				thread.join ();
+				});
+				std::cout << boost::str (boost::format ("Performing %1% threads blocks hash, signature, work validation...\n") % threads_count);
 			}
-			threads.clear ();
+
+			validator.validate_accounts ();
 			if (!silent)
 			{
-				std::cout << boost::str (boost::format ("%1% accounts validated\n") % count);
+				std::cout << boost::str (boost::format ("%1% accounts validated\n") % validator.accounts ());
 			}
+			validator.validate_pending ();
 
-			// Validate total block count
-			auto ledger_block_count (node->store.block.count (transaction));
-			if (node->flags.enable_pruning)
+			if (progress_thread.joinable ())
 			{
-				block_count += 1; // Add disconnected genesis block
-			}
-			if (block_count != ledger_block_count)
-			{
-				print_error_message (boost::str (boost::format ("Incorrect total block count. Blocks validated %1%. Block count in database: %2%\n") % block_count % ledger_block_count));
-			}
-
-			// Validate pending blocks
-			count = 0;
-			finished = false;
-			std::deque<std::pair<nano::pending_key, nano::pending_info>> pending;
-
-			auto check_pending = [&print_error_message, &silent, &count] (std::shared_ptr<nano::node> const & node, nano::secure::read_transaction const & transaction, nano::pending_key const & key, nano::pending_info const & info) {
-				++count;
-				if (!silent && (count % 500000) == 0)
-				{
-					std::cout << boost::str (boost::format ("%1% pending blocks validated\n") % count);
-				}
-				// Check block existence
-				auto block = node->ledger.any.block_get (transaction, key.hash);
-				bool pruned (false);
-				if (block == nullptr)
 				{
-					pruned = node->ledger.pruning && node->store.pruned.exists (transaction, key.hash);
-					if (!pruned)
-					{
-						print_error_message (boost::str (boost::format ("Pending block does not exist %1%\n") % key.hash.to_string ()));
-					}
+					nano::lock_guard<nano::mutex> lock{ progress_mutex };
+					progress_stopped = true;
 				}
-				else
-				{
-					// Check if pending destination is correct
-					nano::account destination{};
-					bool previous_pruned = node->ledger.pruning && node->store.pruned.exists (transaction, block->previous ());
-					if (previous_pruned)
-					{
-						block = node->ledger.any.block_get (transaction, key.hash);
-					}
-					if (auto state = dynamic_cast<nano::state_block *> (block.get ()))
-					{
-						if (state->is_send ())
-						{
-							destination = state->hashables.link.as_account ();
-						}
-					}
-					else if (auto send = dynamic_cast<nano::send_block *> (block.get ()))
-					{
-						destination = send->hashables.destination;
-					}
-					else
-					{
-						print_error_message (boost::str (boost::format ("Incorrect type for pending block %1%\n") % key.hash.to_string ()));
-					}
-					if (key.account != destination)
-					{
-						print_error_message (boost::str (boost::format ("Incorrect destination for pending block %1%\n") % key.hash.to_string ()));
-					}
-					// Check if pending source is correct
-					auto account (node->ledger.any.block_account (transaction, key.hash));
-					if (info.source != account && !pruned)
-					{
-						print_error_message (boost::str (boost::format ("Incorrect source for pending block %1%\n") % key.hash.to_string ()));
-					}
-					// Check if pending amount is correct
-					if (!pruned && !previous_pruned)
-					{
-						auto amount (node->ledger.any.block_amount (transaction, key.hash));
-						if (info.amount != amount)
-						{
-							print_error_message (boost::str (boost::format ("Incorrect amount for pending block %1%\n") % key.hash.to_string ()));
-						}
-					}
-				}
-			};
-
-			start_threads (check_pending, pending);
-
-			size_t const pending_deque_overflow (64 * 1024);
-			for (auto i (node->store.pending.begin (transaction)), n (node->store.pending.end (transaction)); i != n; ++i)
-			{
-				{
-					nano::unique_lock<nano::mutex> lock{ mutex };
-					if (pending.size () > pending_deque_overflow)
-					{
-						auto wait_ms (50 * pending.size () / pending_deque_overflow);
-						auto const wakeup (std::chrono::steady_clock::now () + std::chrono::milliseconds (wait_ms));
-						condition.wait_until (lock, wakeup);
-					}
-					pending.emplace_back (i->first, i->second);
-				}
-				condition.notify_all ();
-			}
-			{
-				nano::lock_guard<nano::mutex> lock{ mutex };
-				finished = true;
-			}
-			condition.notify_all ();
-			for (auto & thread : threads)
-			{
-				thread.join ();
+				progress_condition.notify_all ();
+				progress_thread.join ();
 			}
 			if (!silent)
 			{
-				std::cout << boost::str (boost::format ("%1% pending blocks validated\n") % count);
+				std::cout << boost::str (boost::format ("%1% pending blocks validated\n") % validator.pending ());
 				timer.stop ();
 				std::cout << boost::str (boost::format ("%1% %2% validation time\n") % timer.value ().count () % timer.unit ());
 			}
-			if (errors == 0)
+			if (validator.errors () == 0)
 			{
 				std::cout << "Validation status: Ok\n";
 			}
 			else
 			{
-				std::cout << boost::str (boost::format ("Validation status: Failed\n%1% errors found\n") % errors);
+				std::cout << boost::str (boost::format ("Validation status: Failed\n%1% errors found\n") % validator.errors ());
 			}
 		}
 		else if (vm.count ("debug_profile_bootstrap"))
@@ -1911,6 +1583,34 @@ int main (int argc, char * const * argv)
 			nano::inactive_node node (data_path, node_flags);
 			std::cout << "Total cemented block count: " << node.node->ledger.cemented_count () << std::endl;
 		}
+		else if (vm.count ("debug_unconfirmed_frontiers"))
+		{
+			auto inactive_node = nano::default_inactive_node (data_path, vm);
+			auto node = inactive_node->node;
+			auto transaction = node->store.tx_begin_read ();
+
+			// Number of uncemented blocks -> account, frontier, cemented frontier
+			std::multimap<uint64_t, std::tuple<nano::account, nano::block_hash, nano::block_hash>, std::greater<>> unconfirmed_frontiers;
+			for (auto i = node->store.unconfirmed.begin (transaction), n = node->store.unconfirmed.end (transaction); i != n; ++i)
+			{
+				auto const & account = i->first;
+				auto const account_info = node->store.account.get (transaction, account);
+				auto const conf_info = node->store.confirmation_height.get (transaction, account).value_or (nano::confirmation_height_info{});
+				if (account_info && conf_info.height < account_info->block_count)
+				{
+					unconfirmed_frontiers.emplace (account_info->block_count - conf_info.height, std::make_tuple (account, account_info->head, conf_info.frontier));
+				}
+			}
+
+			std::cout << "Account, height delta, frontier, cemented frontier" << std::endl;
+			for (auto const & [height_delta, info] : unconfirmed_frontiers)
+			{
+				auto const & [account, frontier, cemented_frontier] = info;
+				std::cout << account.to_account () << " " << height_delta << " " << frontier.to_string () << " " << cemented_frontier.to_string () << std::endl;
+			}
+
+			std::cout << "\nNumber of unconfirmed frontiers: " << unconfirmed_frontiers.size () << std::endl;
+		}
 		else if (vm.count ("debug_prune"))
 		{
 			auto node_flags = nano::inactive_node_flag_defaults ();
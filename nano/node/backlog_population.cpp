@@ -4,9 +4,9 @@
 #include <nano/node/nodeconfig.hpp>
 #include <nano/node/scheduler/priority.hpp>
 #include <nano/secure/ledger.hpp>
-#include <nano/store/account.hpp>
+#include <nano/secure/ledger_set_any.hpp>
 #include <nano/store/component.hpp>
-#include <nano/store/confirmation_height.hpp>
+#include <nano/store/unconfirmed.hpp>
 
 nano::backlog_population::backlog_population (backlog_population_config const & config_a, nano::scheduler::component & schedulers, nano::ledger & ledger, nano::stats & stats_a) :
 	config{ config_a },
@@ -95,8 +95,9 @@ void nano::backlog_population::populate_backlog (nano::unique_lock<nano::mutex>
 		{
 			auto transaction = ledger.tx_begin_read ();
 
-			auto it = ledger.store.account.begin (transaction, next);
-			auto const end = ledger.store.account.end (transaction);
+			// Only accounts with blocks above their confirmation height are visited
+			auto it = ledger.store.unconfirmed.begin (transaction, next);
+			auto const end = ledger.store.unconfirmed.end (transaction);
 
 			auto should_refresh = [&transaction] () {
 				auto cutoff = std::chrono::steady_clock::now () - 100ms; // TODO: Make this configurable
@@ -108,14 +109,15 @@ void nano::backlog_population::populate_backlog (nano::unique_lock<nano::mutex>
 				stats.inc (nano::stat::type::backlog, nano::stat::detail::total);
 
 				auto const & account = it->first;
-				auto const & account_info = it->second;
-
-				activate (transaction, account, account_info);
+				if (auto account_info = ledger.any.account_get (transaction, account))
+				{
+					activate (transaction, account, *account_info);
+				}
 
 				next = account.number () + 1;
 			}
 
-			done = ledger.store.account.begin (transaction, next) == end;
+			done = ledger.store.unconfirmed.begin (transaction, next) == end;
 		}
 
 		lock.lock ();
@@ -127,7 +129,7 @@ void nano::backlog_population::populate_backlog (nano::unique_lock<nano::mutex>
 
 void nano::backlog_population::activate (secure::transaction const & transaction, nano::account const & account, nano::account_info const & account_info)
 {
-	auto const maybe_conf_info = ledger.store.confirmation_height.get (transaction, account);
+	auto const maybe_conf_info = ledger.confirmation_height (transaction, account);
 	auto const conf_info = maybe_conf_info.value_or (nano::confirmation_height_info{});
 
 	// If conf info is empty then it means then it means nothing is confirmed yet
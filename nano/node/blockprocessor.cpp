@@ -10,6 +10,7 @@
 #include <nano/secure/ledger_set_any.hpp>
 #include <nano/store/component.hpp>
 
+#include <algorithm>
 #include <utility>
 
 /*
@@ -41,7 +42,8 @@ void nano::block_processor::context::set_result (result_t const & result)
 nano::block_processor::block_processor (nano::node & node_a) :
 	config{ node_a.config.block_processor },
 	node (node_a),
-	next_log (std::chrono::steady_clock::now ())
+	next_log (std::chrono::steady_clock::now ()),
+	tuner{ node_a.config.block_processor, node_a.config.block_processor_batch_max_time }
 {
 	batch_processed.add ([this] (auto const & items) {
 		// For every batch item: notify the 'processed' observer.
@@ -212,17 +214,23 @@ void nano::block_processor::rollback_competitor (secure::write_transaction const
 			node.logger.debug (nano::log::type::blockprocessor, "Blocks rolled back: {}", rollback_list.size ());
 		}
 
-		// Deleting from votes cache, stop active transaction
-		for (auto & i : rollback_list)
+		if (!rollback_list.empty ())
 		{
-			rolled_back.notify (i);
+			rolled_back.notify (rollback_list);
 
-			node.history.erase (i->root ());
-			// Stop all rolled back active transactions except initial
-			if (i->hash () != successor->hash ())
+			// Deleting from votes cache, stop active transaction
+			std::vector<nano::root> roots;
+			roots.reserve (rollback_list.size ());
+			for (auto const & i : rollback_list)
 			{
-				node.active.erase (*i);
+				roots.push_back (i->root ());
+				// Stop all rolled back active transactions except initial
+				if (i->hash () != successor->hash ())
+				{
+					node.active.erase (*i);
+				}
 			}
+			node.history.erase (roots);
 		}
 	}
 }
@@ -315,7 +323,12 @@ auto nano::block_processor::process_batch (nano::unique_lock<nano::mutex> & lock
 	debug_assert (!mutex.try_lock ());
 	debug_assert (!queue.empty ());
 
-	auto batch = next_batch (256);
+	auto const batch_size = tuner.batch_size ();
+	auto const refresh_interval = tuner.refresh_interval ();
+	node.stats.sample (nano::stat::sample::blockprocessor_batch_size, batch_size, { 0, config.batch_size_max });
+	node.stats.sample (nano::stat::sample::blockprocessor_refresh_interval, refresh_interval.count (), { 0, node.config.block_processor_batch_max_time.count () });
+
+	auto batch = next_batch (batch_size);
 
 	lock.unlock ();
 
@@ -324,9 +337,21 @@ auto nano::block_processor::process_batch (nano::unique_lock<nano::mutex> & lock
 	nano::timer<std::chrono::milliseconds> timer;
 	timer.start ();
 
+	auto commit = [&] (auto && action) {
+		auto const start = std::chrono::steady_clock::now ();
+		action ();
+		auto const duration = std::chrono::duration_cast<std::chrono::microseconds> (std::chrono::steady_clock::now () - start);
+		tuner.committed (duration);
+		node.stats.sample (nano::stat::sample::blockprocessor_commit_duration, std::chrono::duration_cast<std::chrono::milliseconds> (duration).count (), { 0, 1000 });
+		return duration;
+	};
+
 	// Processing blocks
 	size_t number_of_blocks_processed = 0;
 	size_t number_of_forced_processed = 0;
+	std::chrono::microseconds commit_duration{ 0 };
+	std::chrono::microseconds renew_duration{ 0 };
+	auto const processing_start = std::chrono::steady_clock::now ();
 
 	processed_batch_t processed;
 	for (auto & ctx : batch)
@@ -334,7 +359,14 @@ auto nano::block_processor::process_batch (nano::unique_lock<nano::mutex> & lock
 		auto const hash = ctx.block->hash ();
 		bool const force = ctx.source == nano::block_source::forced;
 
-		transaction.refresh_if_needed ();
+		if (transaction.refresh_needed (refresh_interval))
+		{
+			commit_duration += commit ([&transaction] () { transaction.commit (); });
+			// Waiting for other writers in the write queue says nothing about storage speed, keep it out of both measurements
+			auto const renew_start = std::chrono::steady_clock::now ();
+			transaction.renew ();
+			renew_duration += std::chrono::duration_cast<std::chrono::microseconds> (std::chrono::steady_clock::now () - renew_start);
+		}
 
 		if (force)
 		{
@@ -348,6 +380,13 @@ auto nano::block_processor::process_batch (nano::unique_lock<nano::mutex> & lock
 		processed.emplace_back (result, std::move (ctx));
 	}
 
+	tuner.processed (number_of_blocks_processed, std::chrono::duration_cast<std::chrono::microseconds> (std::chrono::steady_clock::now () - processing_start) - commit_duration - renew_duration);
+	commit ([&transaction] () { transaction.commit (); });
+
+	// Dependencies satisfied by this batch are handed over at once
+	node.unchecked.trigger (unchecked_dependencies);
+	unchecked_dependencies.clear ();
+
 	if (number_of_blocks_processed != 0 && timer.stop () > std::chrono::milliseconds (100))
 	{
 		node.logger.debug (nano::log::type::blockprocessor, "Processed {} blocks ({} forced) in {} {}", number_of_blocks_processed, number_of_forced_processed, timer.value ().count (), timer.unit ());
@@ -455,7 +494,7 @@ nano::block_status nano::block_processor::process_one (secure::write_transaction
 
 void nano::block_processor::queue_unchecked (secure::write_transaction const & transaction_a, nano::hash_or_account const & hash_or_account_a)
 {
-	node.unchecked.trigger (hash_or_account_a);
+	unchecked_dependencies.push_back (hash_or_account_a);
 }
 
 nano::container_info nano::block_processor::container_info () const
@@ -469,6 +508,52 @@ nano::container_info nano::block_processor::container_info () const
 	return info;
 }
 
+/*
+ * block_processor_tuner
+ */
+
+nano::block_processor_tuner::block_processor_tuner (block_processor_config const & config_a, std::chrono::milliseconds max_refresh_interval_a) :
+	config{ config_a },
+	max_refresh_interval{ max_refresh_interval_a }
+{
+}
+
+size_t nano::block_processor_tuner::batch_size () const
+{
+	if (!block_time)
+	{
+		return std::clamp (initial_batch_size, config.batch_size_min, config.batch_size_max);
+	}
+	// Time left for processing once the batch is committed
+	auto const target = std::chrono::duration<double, std::micro> (config.batch_latency_target).count ();
+	auto const budget = std::max (target - commit_time.value_or (0), 0.0);
+	auto const result = static_cast<size_t> (budget / std::max (*block_time, 1.0));
+	return std::clamp (result, config.batch_size_min, config.batch_size_max);
+}
+
+std::chrono::milliseconds nano::block_processor_tuner::refresh_interval () const
+{
+	// Batches running longer than expected commit in between, rarely enough for commits to stay a small fraction of the write time
+	auto const commit_bound = std::chrono::milliseconds (static_cast<int64_t> (commit_time.value_or (0) * 10 / 1000));
+	return std::min (std::max (config.batch_latency_target, commit_bound), max_refresh_interval);
+}
+
+void nano::block_processor_tuner::processed (size_t count, std::chrono::microseconds duration)
+{
+	if (count == 0)
+	{
+		return;
+	}
+	auto const sample = static_cast<double> (std::max<int64_t> (duration.count (), 0)) / count;
+	block_time = block_time ? *block_time + (sample - *block_time) * smoothing : sample;
+}
+
+void nano::block_processor_tuner::committed (std::chrono::microseconds duration)
+{
+	auto const sample = static_cast<double> (duration.count ());
+	commit_time = commit_time ? *commit_time + (sample - *commit_time) * smoothing : sample;
+}
+
 /*
  * block_processor_config
  */
@@ -484,6 +569,9 @@ nano::error nano::block_processor_config::serialize (nano::tomlconfig & toml) co
 	toml.put ("priority_live", priority_live, "Priority for live network blocks. Higher priority gets processed more frequently. \ntype:uint64");
 	toml.put ("priority_bootstrap", priority_bootstrap, "Priority for bootstrap blocks. Higher priority gets processed more frequently. \ntype:uint64");
 	toml.put ("priority_local", priority_local, "Priority for local RPC blocks. Higher priority gets processed more frequently. \ntype:uint64");
+	toml.put ("batch_size_min", batch_size_min, "Minimum number of blocks processed in a single write transaction. \ntype:uint64");
+	toml.put ("batch_size_max", batch_size_max, "Maximum number of blocks processed in a single write transaction. \ntype:uint64");
+	toml.put ("batch_latency_target", batch_latency_target.count (), "Target time to process and commit a batch of blocks. Batch sizes are adjusted from measured processing and commit times to meet it. Lower values favor live block latency, higher values favor bootstrap throughput. \ntype:milliseconds");
 
 	return toml.get_error ();
 }
@@ -495,6 +583,17 @@ nano::error nano::block_processor_config::deserialize (nano::tomlconfig & toml)
 	toml.get ("priority_live", priority_live);
 	toml.get ("priority_bootstrap", priority_bootstrap);
 	toml.get ("priority_local", priority_local);
+	toml.get ("batch_size_min", batch_size_min);
+	toml.get ("batch_size_max", batch_size_max);
+
+	auto batch_latency_target_l = batch_latency_target.count ();
+	toml.get ("batch_latency_target", batch_latency_target_l);
+	batch_latency_target = std::chrono::milliseconds{ batch_latency_target_l };
+
+	if (batch_size_min == 0 || batch_size_min > batch_size_max)
+	{
+		toml.get_error ().set ("batch_size_min must be greater than 0 and not greater than batch_size_max");
+	}
 
 	return toml.get_error ();
 }
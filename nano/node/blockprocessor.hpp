@@ -10,6 +10,7 @@
 #include <memory>
 #include <optional>
 #include <thread>
+#include <vector>
 
 namespace nano
 {
@@ -46,6 +47,41 @@ public:
 	size_t priority_live{ 1 };
 	size_t priority_bootstrap{ 8 };
 	size_t priority_local{ 16 };
+
+	// Bounds for the number of blocks processed in a single write transaction
+	size_t batch_size_min{ 32 };
+	size_t batch_size_max{ 8 * 1024 };
+	// Batches are sized so processing and committing one takes about this long, which bounds how long a live block waits behind a batch
+	std::chrono::milliseconds batch_latency_target{ 100 };
+};
+
+/**
+ * Adjusts the block processor batch size and write transaction refresh interval from measured processing and commit times
+ * Fast storage gets larger batches so each commit is spread over more blocks, slow storage gets smaller batches to keep live blocks responsive.
+ * @note This class is not thread-safe, it is only used by the block processing thread
+ */
+class block_processor_tuner final
+{
+public:
+	block_processor_tuner (block_processor_config const &, std::chrono::milliseconds max_refresh_interval);
+
+	size_t batch_size () const;
+	std::chrono::milliseconds refresh_interval () const;
+
+	/** Records the time spent processing `count` blocks, excluding commits */
+	void processed (size_t count, std::chrono::microseconds duration);
+	void committed (std::chrono::microseconds duration);
+
+	static size_t constexpr initial_batch_size = 256;
+	static double constexpr smoothing = 0.2;
+
+private:
+	block_processor_config const & config;
+	std::chrono::milliseconds const max_refresh_interval;
+
+	// Exponential moving averages in microseconds, empty until the first measurement
+	std::optional<double> block_time;
+	std::optional<double> commit_time;
 };
 
 /**
@@ -102,7 +138,8 @@ public: // Events
 	// The batch observer feeds the processed observer
 	nano::observer_set<nano::block_status const &, context const &> block_processed;
 	nano::observer_set<processed_batch_t const &> batch_processed;
-	nano::observer_set<std::shared_ptr<nano::block> const &> rolled_back;
+	// Blocks rolled back while resolving a single fork, notified as one batch
+	nano::observer_set<std::vector<std::shared_ptr<nano::block>> const &> rolled_back;
 
 private:
 	void run ();
@@ -124,6 +161,11 @@ private:
 
 	std::chrono::steady_clock::time_point next_log;
 
+	block_processor_tuner tuner;
+
+	// Dependencies satisfied by the batch being processed, only accessed by the processing thread
+	std::deque<nano::hash_or_account> unchecked_dependencies;
+
 	bool stopped{ false };
 	nano::condition_variable condition;
 	mutable nano::mutex mutex{ mutex_identifier (mutexes::block_processor) };
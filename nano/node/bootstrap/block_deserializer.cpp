@@ -1,10 +1,11 @@
 #include <nano/lib/blocks.hpp>
+#include <nano/lib/buffer_pool.hpp>
 #include <nano/lib/stream.hpp>
 #include <nano/node/bootstrap/block_deserializer.hpp>
 #include <nano/node/transport/tcp_socket.hpp>
 
 nano::bootstrap::block_deserializer::block_deserializer () :
-	read_buffer{ std::make_shared<std::vector<uint8_t>> () }
+	read_buffer{ nano::buffer_pool::acquire (0, nano::buffer_pool::min_size) }
 {
 }
 
@@ -1,4 +1,5 @@
 #include <nano/lib/blocks.hpp>
+#include <nano/lib/buffer_pool.hpp>
 #include <nano/node/bootstrap/bootstrap_attempt.hpp>
 #include <nano/node/bootstrap/bootstrap_bulk_push.hpp>
 #include <nano/node/bootstrap/bootstrap_legacy.hpp>
@@ -124,10 +125,9 @@ void nano::bulk_push_client::push_block (nano::block const & block_a)
 }
 
 nano::bulk_push_server::bulk_push_server (std::shared_ptr<nano::transport::tcp_server> const & connection_a) :
-	receive_buffer (std::make_shared<std::vector<uint8_t>> ()),
+	receive_buffer (nano::buffer_pool::acquire (256)),
 	connection (connection_a)
 {
-	receive_buffer->resize (256);
 }
 
 void nano::bulk_push_server::throttled_receive ()
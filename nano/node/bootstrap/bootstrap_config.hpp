@@ -36,7 +36,11 @@ public:
 
 	// Maximum number of un-responded requests per channel, should be lower or equal to bootstrap server max queue size
 	std::size_t channel_limit{ 16 };
+	// Initial number of un-responded requests per channel, grows towards channel_limit as responses arrive and shrinks on timeouts
+	std::size_t channel_window{ 4 };
 	std::size_t database_rate_limit{ 256 };
+	// Number of threads scanning disjoint account ranges of the database
+	std::size_t database_threads{ 1 };
 	std::size_t database_warmup_ratio{ 10 };
 	std::size_t max_pull_count{ nano::bootstrap_server::max_blocks };
 	std::chrono::milliseconds request_timeout{ 1000 * 5 };
@@ -1,3 +1,4 @@
+#include <nano/lib/buffer_pool.hpp>
 #include <nano/node/bootstrap/bootstrap.hpp>
 #include <nano/node/bootstrap/bootstrap_attempt.hpp>
 #include <nano/node/bootstrap/bootstrap_connections.hpp>
@@ -19,11 +20,10 @@ nano::bootstrap_client::bootstrap_client (std::shared_ptr<nano::node> const & no
 	node (node_a),
 	channel (channel_a),
 	socket (socket_a),
-	receive_buffer (std::make_shared<std::vector<uint8_t>> ()),
+	receive_buffer (nano::buffer_pool::acquire (256)),
 	start_time_m (std::chrono::steady_clock::now ())
 {
 	++node_a->bootstrap_initiator.connections->connections_count;
-	receive_buffer->resize (256);
 	channel->update_endpoints ();
 }
 
@@ -156,7 +156,7 @@ void nano::bootstrap_server::respond (nano::asc_pull_ack & response, std::shared
 		}
 		void operator() (nano::asc_pull_ack::blocks_payload const & pld)
 		{
-			stats.add (nano::stat::type::bootstrap_server, nano::stat::detail::blocks, nano::stat::dir::out, pld.blocks.size ());
+			stats.add (nano::stat::type::bootstrap_server, nano::stat::detail::blocks, nano::stat::dir::out, pld.size ());
 		}
 		void operator() (nano::asc_pull_ack::account_info_payload const & pld)
 		{
@@ -285,16 +285,17 @@ nano::asc_pull_ack nano::bootstrap_server::prepare_response (secure::transaction
 {
 	debug_assert (count <= max_blocks); // Should be filtered out earlier
 
-	auto blocks = prepare_blocks (transaction, start_block, count);
-	debug_assert (blocks.size () <= count);
+	nano::asc_pull_ack::blocks_payload response_payload{};
+	// Stored blocks are forwarded in their serialized form without deserializing them
+	ledger.store.block.chain (transaction, start_block, count, [&response_payload] (nano::store::block_view const & view) {
+		response_payload.append_serialized (view.type, view.block);
+	});
+	debug_assert (response_payload.size () <= count);
 
 	nano::asc_pull_ack response{ network_constants };
 	response.id = id;
 	response.type = nano::asc_pull_type::blocks;
-
-	nano::asc_pull_ack::blocks_payload response_payload{};
-	response_payload.blocks = blocks;
-	response.payload = response_payload;
+	response.payload = std::move (response_payload);
 
 	response.update_header ();
 	return response;
@@ -313,25 +314,6 @@ nano::asc_pull_ack nano::bootstrap_server::prepare_empty_blocks_response (nano::
 	return response;
 }
 
-std::deque<std::shared_ptr<nano::block>> nano::bootstrap_server::prepare_blocks (secure::transaction const & transaction, nano::block_hash start_block, std::size_t count) const
-{
-	debug_assert (count <= max_blocks); // Should be filtered out earlier
-
-	std::deque<std::shared_ptr<nano::block>> result;
-	if (!start_block.is_zero ())
-	{
-		std::shared_ptr<nano::block> current = ledger.any.block_get (transaction, start_block);
-		while (current && result.size () < count)
-		{
-			result.push_back (current);
-
-			auto successor = current->sideband ().successor;
-			current = ledger.any.block_get (transaction, successor);
-		}
-	}
-	return result;
-}
-
 /*
  * Account info request
  */
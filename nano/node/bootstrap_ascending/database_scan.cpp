@@ -11,20 +11,15 @@
  * database_scan
  */
 
-nano::bootstrap_ascending::database_scan::database_scan (nano::ledger & ledger_a) :
+nano::bootstrap_ascending::database_scan::database_scan (nano::ledger & ledger_a, nano::account start_a, nano::account end_a) :
 	ledger{ ledger_a },
-	accounts_iterator{ ledger },
-	pending_iterator{ ledger }
+	accounts_iterator{ ledger, start_a, end_a },
+	pending_iterator{ ledger, start_a, end_a }
 {
 }
 
 nano::account nano::bootstrap_ascending::database_scan::next (std::function<bool (nano::account const &)> const & filter)
 {
-	if (queue.empty ())
-	{
-		fill ();
-	}
-
 	while (!queue.empty ())
 	{
 		auto result = queue.front ();
@@ -50,6 +45,11 @@ void nano::bootstrap_ascending::database_scan::fill ()
 	queue.insert (queue.end (), set2.begin (), set2.end ());
 }
 
+bool nano::bootstrap_ascending::database_scan::empty () const
+{
+	return queue.empty ();
+}
+
 bool nano::bootstrap_ascending::database_scan::warmed_up () const
 {
 	return accounts_iterator.warmed_up () && pending_iterator.warmed_up ();
@@ -58,8 +58,8 @@ bool nano::bootstrap_ascending::database_scan::warmed_up () const
 nano::container_info nano::bootstrap_ascending::database_scan::container_info () const
 {
 	nano::container_info info;
-	info.put ("accounts_iterator", accounts_iterator.completed);
-	info.put ("pending_iterator", pending_iterator.completed);
+	info.put ("accounts_iterator", accounts_iterator.completed.load ());
+	info.put ("pending_iterator", pending_iterator.completed.load ());
 	return info;
 }
 
@@ -67,8 +67,11 @@ nano::container_info nano::bootstrap_ascending::database_scan::container_info ()
  * account_database_iterator
  */
 
-nano::bootstrap_ascending::account_database_iterator::account_database_iterator (nano::ledger & ledger_a) :
-	ledger{ ledger_a }
+nano::bootstrap_ascending::account_database_iterator::account_database_iterator (nano::ledger & ledger_a, nano::account start_a, nano::account end_a) :
+	ledger{ ledger_a },
+	start{ start_a },
+	end{ end_a },
+	next{ start_a }
 {
 }
 
@@ -77,19 +80,22 @@ std::deque<nano::account> nano::bootstrap_ascending::account_database_iterator::
 	std::deque<nano::account> result;
 
 	auto it = ledger.store.account.begin (transaction, next);
-	auto const end = ledger.store.account.end (transaction);
+	auto const end_it = ledger.store.account.end (transaction);
+	auto in_range = [this, &it, &end_it] () {
+		return it != end_it && (end.is_zero () || it->first < end);
+	};
 
-	for (size_t count = 0; it != end && count < batch_size; ++it, ++count)
+	for (size_t count = 0; in_range () && count < batch_size; ++it, ++count)
 	{
 		auto const & account = it->first;
 		result.push_back (account);
 		next = account.number () + 1;
 	}
 
-	if (it == end)
+	if (!in_range ())
 	{
 		// Reset for the next ledger iteration
-		next = { 0 };
+		next = start;
 		++completed;
 	}
 
@@ -105,8 +111,11 @@ bool nano::bootstrap_ascending::account_database_iterator::warmed_up () const
  * pending_database_iterator
  */
 
-nano::bootstrap_ascending::pending_database_iterator::pending_database_iterator (nano::ledger & ledger_a) :
-	ledger{ ledger_a }
+nano::bootstrap_ascending::pending_database_iterator::pending_database_iterator (nano::ledger & ledger_a, nano::account start_a, nano::account end_a) :
+	ledger{ ledger_a },
+	start{ start_a },
+	end{ end_a },
+	next{ start_a, 0 }
 {
 }
 
@@ -115,7 +124,10 @@ std::deque<nano::account> nano::bootstrap_ascending::pending_database_iterator::
 	std::deque<nano::account> result;
 
 	auto it = ledger.store.pending.begin (transaction, next);
-	auto const end = ledger.store.pending.end (transaction);
+	auto const end_it = ledger.store.pending.end (transaction);
+	auto in_range = [this, &it, &end_it] () {
+		return it != end_it && (end.is_zero () || it->first.account < end);
+	};
 
 	// TODO: This pending iteration heuristic should be encapsulated in a pending_iterator class and reused across other components
 	// The heuristic is to advance the iterator sequentially until we reach a new account or perform a fresh lookup if the account has too many pending blocks
@@ -127,7 +139,7 @@ std::deque<nano::account> nano::bootstrap_ascending::pending_database_iterator::
 		const size_t sequential_attempts = 10;
 
 		// First try advancing sequentially
-		for (size_t count = 0; count < sequential_attempts && it != end; ++count, ++it)
+		for (size_t count = 0; count < sequential_attempts && it != end_it; ++count, ++it)
 		{
 			if (it->first.account != starting_account)
 			{
@@ -136,25 +148,25 @@ std::deque<nano::account> nano::bootstrap_ascending::pending_database_iterator::
 		}
 
 		// If we didn't advance to the next account, perform a fresh lookup
-		if (it != end && it->first.account == starting_account)
+		if (it != end_it && it->first.account == starting_account)
 		{
 			it = ledger.store.pending.begin (transaction, { starting_account.number () + 1, 0 });
 		}
 
-		debug_assert (it == end || it->first.account != starting_account);
+		debug_assert (it == end_it || it->first.account != starting_account);
 	};
 
-	for (size_t count = 0; it != end && count < batch_size; advance_iterator (), ++count)
+	for (size_t count = 0; in_range () && count < batch_size; advance_iterator (), ++count)
 	{
 		auto const & account = it->first.account;
 		result.push_back (account);
 		next = { account.number () + 1, 0 };
 	}
 
-	if (it == end)
+	if (!in_range ())
 	{
 		// Reset for the next ledger iteration
-		next = { 0, 0 };
+		next = { start, 0 };
 		++completed;
 	}
 
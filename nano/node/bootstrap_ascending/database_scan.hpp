@@ -5,40 +5,58 @@
 #include <nano/node/fwd.hpp>
 #include <nano/secure/pending_info.hpp>
 
+#include <atomic>
 #include <deque>
 
 namespace nano::bootstrap_ascending
 {
+/**
+ * Iterates accounts in the range [start, end), an end of zero denotes the end of the account space
+ */
 struct account_database_iterator
 {
-	explicit account_database_iterator (nano::ledger &);
+	explicit account_database_iterator (nano::ledger &, nano::account start = 0, nano::account end = 0);
 
 	std::deque<nano::account> next_batch (nano::store::transaction &, size_t batch_size);
 	bool warmed_up () const;
 
 	nano::ledger & ledger;
-	nano::account next{ 0 };
-	size_t completed{ 0 };
+	nano::account const start;
+	nano::account const end;
+	nano::account next;
+	std::atomic<size_t> completed{ 0 };
 };
 
+/**
+ * Iterates accounts with pending entries in the range [start, end), an end of zero denotes the end of the account space
+ */
 struct pending_database_iterator
 {
-	explicit pending_database_iterator (nano::ledger &);
+	explicit pending_database_iterator (nano::ledger &, nano::account start = 0, nano::account end = 0);
 
 	std::deque<nano::account> next_batch (nano::store::transaction &, size_t batch_size);
 	bool warmed_up () const;
 
 	nano::ledger & ledger;
-	nano::pending_key next{ 0, 0 };
-	size_t completed{ 0 };
+	nano::account const start;
+	nano::account const end;
+	nano::pending_key next;
+	std::atomic<size_t> completed{ 0 };
 };
 
+/**
+ * Each scan is used by a single database thread, only the `completed` counters are read from other threads
+ */
 class database_scan
 {
 public:
-	explicit database_scan (nano::ledger &);
+	explicit database_scan (nano::ledger &, nano::account start = 0, nano::account end = 0);
 
+	/** Takes the next queued account passing \p filter, zero once the queue is exhausted and needs to be refilled */
 	nano::account next (std::function<bool (nano::account const &)> const & filter);
+	/** Queues the next batch of accounts from the store. Doesn't touch any state shared with other threads, so it can run without holding the service mutex */
+	void fill ();
+	bool empty () const;
 
 	// Indicates if a full ledger iteration has taken place e.g. warmed up
 	bool warmed_up () const;
@@ -48,9 +66,6 @@ public:
 private: // Dependencies
 	nano::ledger & ledger;
 
-private:
-	void fill ();
-
 private:
 	account_database_iterator accounts_iterator;
 	pending_database_iterator pending_iterator;
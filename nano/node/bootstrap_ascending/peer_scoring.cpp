@@ -18,11 +18,11 @@ bool nano::bootstrap_ascending::peer_scoring::try_send_message (std::shared_ptr<
 	auto existing = index.find (channel.get ());
 	if (existing == index.end ())
 	{
-		index.emplace (channel, 1, 1, 0);
+		index.emplace (channel, 1, 1, 0, initial_window ());
 	}
 	else
 	{
-		if (existing->outstanding < config.channel_limit)
+		if (existing->outstanding < existing->window)
 		{
 			[[maybe_unused]] auto success = index.modify (existing, [] (auto & score) {
 				++score.outstanding;
@@ -38,23 +38,74 @@ bool nano::bootstrap_ascending::peer_scoring::try_send_message (std::shared_ptr<
 	return false;
 }
 
-void nano::bootstrap_ascending::peer_scoring::received_message (std::shared_ptr<nano::transport::channel> channel)
+void nano::bootstrap_ascending::peer_scoring::received_message (std::shared_ptr<nano::transport::channel> channel, std::chrono::milliseconds rtt)
 {
 	auto & index = scoring.get<tag_channel> ();
 	auto existing = index.find (channel.get ());
 	if (existing != index.end ())
 	{
-		if (existing->outstanding > 1)
-		{
-			[[maybe_unused]] auto success = index.modify (existing, [] (auto & score) {
+		[[maybe_unused]] auto success = index.modify (existing, [this, rtt] (auto & score) {
+			if (score.outstanding > 1)
+			{
 				--score.outstanding;
 				++score.response_count_total;
-			});
-			debug_assert (success);
-		}
+			}
+			// Exponentially weighted moving average, 1/8 weight for the new sample
+			score.rtt = score.rtt.count () == 0 ? rtt : (score.rtt * 7 + rtt) / 8;
+			score.rtt_min = score.rtt_min.count () == 0 ? rtt : std::min (score.rtt_min, rtt);
+			// Requests in flight beyond what the peer keeps up with only add queueing delay, so the window follows the round trip time
+			if (score.rtt <= score.rtt_min * 2 + rtt_tolerance)
+			{
+				if (config.channel_limit == 0 || score.window < config.channel_limit)
+				{
+					++score.window;
+				}
+			}
+			else if (score.window > 1)
+			{
+				--score.window;
+			}
+		});
+		debug_assert (success);
+	}
+}
+
+void nano::bootstrap_ascending::peer_scoring::timed_out (std::shared_ptr<nano::transport::channel> channel)
+{
+	auto & index = scoring.get<tag_channel> ();
+	auto existing = index.find (channel.get ());
+	if (existing != index.end ())
+	{
+		[[maybe_unused]] auto success = index.modify (existing, [] (auto & score) {
+			score.window = std::max<uint64_t> (score.window / 2, 1);
+			score.decay ();
+		});
+		debug_assert (success);
 	}
 }
 
+std::size_t nano::bootstrap_ascending::peer_scoring::available (std::shared_ptr<nano::transport::channel> const & channel) const
+{
+	auto & index = scoring.get<tag_channel> ();
+	auto existing = index.find (channel.get ());
+	if (existing != index.end ())
+	{
+		return existing->window > existing->outstanding ? existing->window - existing->outstanding : 0;
+	}
+	return 0;
+}
+
+std::chrono::milliseconds nano::bootstrap_ascending::peer_scoring::rtt (std::shared_ptr<nano::transport::channel> const & channel) const
+{
+	auto & index = scoring.get<tag_channel> ();
+	auto existing = index.find (channel.get ());
+	if (existing != index.end ())
+	{
+		return existing->rtt;
+	}
+	return std::chrono::milliseconds{ 0 };
+}
+
 std::shared_ptr<nano::transport::channel> nano::bootstrap_ascending::peer_scoring::channel ()
 {
 	auto & index = scoring.get<tag_outstanding> ();
@@ -113,23 +164,30 @@ void nano::bootstrap_ascending::peer_scoring::sync (std::deque<std::shared_ptr<n
 			{
 				if (!channel->max (nano::transport::traffic_type::bootstrap))
 				{
-					index.emplace (channel, 1, 1, 0);
+					index.emplace (channel, 1, 1, 0, initial_window ());
 				}
 			}
 		}
 	}
 }
 
+uint64_t nano::bootstrap_ascending::peer_scoring::initial_window () const
+{
+	uint64_t window = std::max<uint64_t> (config.channel_window, 1);
+	return config.channel_limit > 0 ? std::min<uint64_t> (window, config.channel_limit) : window;
+}
+
 /*
  * peer_score
  */
 
 nano::bootstrap_ascending::peer_scoring::peer_score::peer_score (
-std::shared_ptr<nano::transport::channel> const & channel_a, uint64_t outstanding_a, uint64_t request_count_total_a, uint64_t response_count_total_a) :
+std::shared_ptr<nano::transport::channel> const & channel_a, uint64_t outstanding_a, uint64_t request_count_total_a, uint64_t response_count_total_a, uint64_t window_a) :
 	channel{ channel_a },
 	channel_ptr{ channel_a.get () },
 	outstanding{ outstanding_a },
 	request_count_total{ request_count_total_a },
-	response_count_total{ response_count_total_a }
+	response_count_total{ response_count_total_a },
+	window{ window_a }
 {
 }
@@ -5,6 +5,7 @@
 #include <boost/multi_index/ordered_index.hpp>
 #include <boost/multi_index_container.hpp>
 
+#include <chrono>
 #include <deque>
 #include <memory>
 
@@ -28,7 +29,14 @@ namespace bootstrap_ascending
 
 		// Returns true if channel limit has been exceeded
 		bool try_send_message (std::shared_ptr<nano::transport::channel> channel);
-		void received_message (std::shared_ptr<nano::transport::channel> channel);
+		// Records the round trip time of the request and resizes the request window of the channel from it
+		void received_message (std::shared_ptr<nano::transport::channel> channel, std::chrono::milliseconds rtt);
+		// Halves the request window of the channel
+		void timed_out (std::shared_ptr<nano::transport::channel> channel);
+		// Number of requests that can still be sent to the channel before its window is full
+		[[nodiscard]] std::size_t available (std::shared_ptr<nano::transport::channel> const & channel) const;
+		// Smoothed round trip time of requests to the channel, zero if unknown
+		[[nodiscard]] std::chrono::milliseconds rtt (std::shared_ptr<nano::transport::channel> const & channel) const;
 		std::shared_ptr<nano::transport::channel> channel ();
 		[[nodiscard]] std::size_t size () const;
 		// Cleans up scores for closed channels
@@ -40,11 +48,17 @@ namespace bootstrap_ascending
 		bootstrap_ascending_config const & config;
 		nano::network_constants const & network_constants;
 
+	private:
+		uint64_t initial_window () const;
+
+		// Queueing delay tolerated on top of twice the fastest round trip before a window stops growing
+		static std::chrono::milliseconds constexpr rtt_tolerance{ 10 };
+
 	private:
 		class peer_score
 		{
 		public:
-			explicit peer_score (std::shared_ptr<nano::transport::channel> const &, uint64_t, uint64_t, uint64_t);
+			explicit peer_score (std::shared_ptr<nano::transport::channel> const &, uint64_t, uint64_t, uint64_t, uint64_t);
 			std::weak_ptr<nano::transport::channel> channel;
 			// std::weak_ptr does not provide ordering so the naked pointer is also tracked and used for ordering channels
 			// This pointer may be invalid if the channel has been destroyed
@@ -67,6 +81,11 @@ namespace bootstrap_ascending
 			uint64_t outstanding{ 0 };
 			uint64_t request_count_total{ 0 };
 			uint64_t response_count_total{ 0 };
+			// Maximum number of outstanding requests. Grows while round trips stay close to the fastest one seen, shrinks once requests
+			// start queueing at the peer and is halved on timeouts
+			uint64_t window{ 1 };
+			std::chrono::milliseconds rtt{ 0 };
+			std::chrono::milliseconds rtt_min{ 0 };
 		};
 
 		// clang-format off
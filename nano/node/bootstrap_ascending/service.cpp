@@ -28,7 +28,6 @@ nano::bootstrap_ascending::service::service (nano::node_config const & node_conf
 	stats{ stat_a },
 	logger{ logger_a },
 	accounts{ config.account_sets, stats },
-	database_scan{ ledger },
 	throttle{ compute_throttle_size () },
 	scoring{ config, node_config_a.network_params.network },
 	database_limiter{ config.database_rate_limit, 1.0 }
@@ -49,13 +48,23 @@ nano::bootstrap_ascending::service::service (nano::node_config const & node_conf
 	});
 
 	accounts.priority_set (node_config_a.network_params.ledger.genesis->account_field ().value ());
+
+	// Split the account space into equally sized ranges, the last one extends to the end
+	auto const scan_count = std::max<std::size_t> (config.database_threads, 1);
+	nano::uint256_t const step = std::numeric_limits<nano::uint256_t>::max () / scan_count;
+	for (std::size_t i = 0; i < scan_count; ++i)
+	{
+		nano::account const start{ step * i };
+		nano::account const end{ i + 1 < scan_count ? step * (i + 1) : nano::uint256_t{ 0 } };
+		database_scans.emplace_back (ledger, start, end);
+	}
 }
 
 nano::bootstrap_ascending::service::~service ()
 {
 	// All threads must be stopped before destruction
 	debug_assert (!priorities_thread.joinable ());
-	debug_assert (!database_thread.joinable ());
+	debug_assert (database_threads.empty ());
 	debug_assert (!dependencies_thread.joinable ());
 	debug_assert (!timeout_thread.joinable ());
 }
@@ -63,7 +72,7 @@ nano::bootstrap_ascending::service::~service ()
 void nano::bootstrap_ascending::service::start ()
 {
 	debug_assert (!priorities_thread.joinable ());
-	debug_assert (!database_thread.joinable ());
+	debug_assert (database_threads.empty ());
 	debug_assert (!dependencies_thread.joinable ());
 	debug_assert (!timeout_thread.joinable ());
 
@@ -80,10 +89,13 @@ void nano::bootstrap_ascending::service::start ()
 
 	if (config.enable_database_scan)
 	{
-		database_thread = std::thread ([this] () {
-			nano::thread_role::set (nano::thread_role::name::ascending_bootstrap);
-			run_database ();
-		});
+		for (auto & scan : database_scans)
+		{
+			database_threads.emplace_back ([this, &scan] () {
+				nano::thread_role::set (nano::thread_role::name::ascending_bootstrap);
+				run_database (scan);
+			});
+		}
 	}
 
 	if (config.enable_dependency_walker)
@@ -109,7 +121,11 @@ void nano::bootstrap_ascending::service::stop ()
 	condition.notify_all ();
 
 	nano::join_or_pass (priorities_thread);
-	nano::join_or_pass (database_thread);
+	for (auto & thread : database_threads)
+	{
+		nano::join_or_pass (thread);
+	}
+	database_threads.clear ();
 	nano::join_or_pass (dependencies_thread);
 	nano::join_or_pass (timeout_thread);
 }
@@ -119,6 +135,7 @@ void nano::bootstrap_ascending::service::send (std::shared_ptr<nano::transport::
 	debug_assert (tag.type != query_type::invalid);
 	debug_assert (tag.source != query_source::invalid);
 
+	tag.channel = channel;
 	{
 		nano::lock_guard<nano::mutex> lock{ mutex };
 		debug_assert (tags.get<tag_id> ().count (tag.id) == 0);
@@ -334,7 +351,7 @@ std::pair<nano::account, double> nano::bootstrap_ascending::service::wait_priori
 	return result;
 }
 
-nano::account nano::bootstrap_ascending::service::next_database (bool should_throttle)
+nano::account nano::bootstrap_ascending::service::next_database (nano::bootstrap_ascending::database_scan & scan, bool should_throttle)
 {
 	debug_assert (!mutex.try_lock ());
 	debug_assert (config.database_warmup_ratio > 0);
@@ -345,7 +362,7 @@ nano::account nano::bootstrap_ascending::service::next_database (bool should_thr
 		return { 0 };
 	}
 
-	auto account = database_scan.next ([this] (nano::account const & account) {
+	auto account = scan.next ([this] (nano::account const & account) {
 		return count_tags (account, query_source::database) == 0;
 	});
 
@@ -358,19 +375,44 @@ nano::account nano::bootstrap_ascending::service::next_database (bool should_thr
 	return account;
 }
 
-nano::account nano::bootstrap_ascending::service::wait_database (bool should_throttle)
+std::deque<nano::account> nano::bootstrap_ascending::service::wait_database (nano::bootstrap_ascending::database_scan & scan, bool should_throttle, std::shared_ptr<nano::transport::channel> const & channel)
 {
-	nano::account result{ 0 };
+	std::deque<nano::account> result;
 
-	wait ([this, &result, should_throttle] () {
-		debug_assert (!mutex.try_lock ());
-		result = next_database (should_throttle);
-		if (!result.is_zero ())
+	nano::unique_lock<nano::mutex> lock{ mutex };
+	std::chrono::milliseconds interval = 5ms;
+	while (!stopped)
+	{
+		if (scan.empty ())
 		{
-			return true;
+			// Iterate the store with the mutex released so database threads scan their ranges in parallel
+			lock.unlock ();
+			scan.fill ();
+			lock.lock ();
 		}
-		return false;
-	});
+		auto account = next_database (scan, should_throttle);
+		if (!account.is_zero ())
+		{
+			result.push_back (account);
+			break;
+		}
+		condition.wait_for (lock, interval);
+		interval = std::min (interval * 2, config.throttle_wait);
+	}
+
+	// Pipeline adjacent accounts to the same channel while its request window allows it
+	while (!result.empty () && !stopped && tags.size () + result.size () < config.max_requests && scoring.available (channel) > 0)
+	{
+		auto account = next_database (scan, should_throttle);
+		if (account.is_zero ())
+		{
+			break;
+		}
+		[[maybe_unused]] auto full = scoring.try_send_message (channel);
+		debug_assert (!full);
+		result.push_back (account);
+		stats.inc (nano::stat::type::bootstrap_ascending, nano::stat::detail::pipelined);
+	}
 
 	return result;
 }
@@ -489,7 +531,7 @@ void nano::bootstrap_ascending::service::run_priorities ()
 	}
 }
 
-void nano::bootstrap_ascending::service::run_one_database (bool should_throttle)
+void nano::bootstrap_ascending::service::run_one_database (nano::bootstrap_ascending::database_scan & scan, bool should_throttle)
 {
 	wait_tags ();
 	wait_blockprocessor ();
@@ -498,24 +540,23 @@ void nano::bootstrap_ascending::service::run_one_database (bool should_throttle)
 	{
 		return;
 	}
-	auto account = wait_database (should_throttle);
-	if (account.is_zero ())
+	auto accounts = wait_database (scan, should_throttle, channel);
+	for (auto const & account : accounts)
 	{
-		return;
+		request (account, 2, channel, query_source::database);
 	}
-	request (account, 2, channel, query_source::database);
 }
 
-void nano::bootstrap_ascending::service::run_database ()
+void nano::bootstrap_ascending::service::run_database (nano::bootstrap_ascending::database_scan & scan)
 {
 	nano::unique_lock<nano::mutex> lock{ mutex };
 	while (!stopped)
 	{
 		// Avoid high churn rate of database requests
-		bool should_throttle = !database_scan.warmed_up () && throttle.throttled ();
+		bool should_throttle = !scan.warmed_up () && throttle.throttled ();
 		lock.unlock ();
 		stats.inc (nano::stat::type::bootstrap_ascending, nano::stat::detail::loop_database);
-		run_one_database (should_throttle);
+		run_one_database (scan, should_throttle);
 		lock.lock ();
 	}
 }
@@ -568,6 +609,10 @@ void nano::bootstrap_ascending::service::cleanup_and_sync ()
 	{
 		auto tag = tags_by_order.front ();
 		tags_by_order.pop_front ();
+		if (auto channel = tag.channel.lock ())
+		{
+			scoring.timed_out (channel);
+		}
 		on_timeout.notify (tag);
 		stats.inc (nano::stat::type::bootstrap_ascending, nano::stat::detail::timeout);
 	}
@@ -641,7 +686,7 @@ void nano::bootstrap_ascending::service::process (nano::asc_pull_ack const & mes
 	stats.inc (nano::stat::type::bootstrap_ascending_reply, to_stat_detail (tag.type));
 	stats.sample (nano::stat::sample::bootstrap_tag_duration, nano::log::milliseconds_delta (tag.timestamp), { 0, config.request_timeout.count () });
 
-	scoring.received_message (channel);
+	scoring.received_message (channel, std::chrono::duration_cast<std::chrono::milliseconds> (std::chrono::steady_clock::now () - tag.timestamp));
 
 	lock.unlock ();
 
@@ -839,7 +884,12 @@ nano::container_info nano::bootstrap_ascending::service::container_info () const
 	info.put ("throttle", throttle.size ());
 	info.put ("throttle_successes", throttle.successes ());
 	info.add ("accounts", accounts.container_info ());
-	info.add ("database_scan", database_scan.container_info ());
+	nano::container_info scans;
+	for (std::size_t i = 0; i < database_scans.size (); ++i)
+	{
+		scans.add (std::to_string (i), database_scans[i].container_info ());
+	}
+	info.add ("database_scan", scans);
 	return info;
 }
 
@@ -85,6 +85,8 @@ namespace bootstrap_ascending
 
 			id_t id{ generate_id () };
 			std::chrono::steady_clock::time_point timestamp{ std::chrono::steady_clock::now () };
+			// Channel the request was sent to, used for adjusting its request window on timeout
+			std::weak_ptr<nano::transport::channel> channel;
 		};
 
 	public: // Events
@@ -98,8 +100,8 @@ namespace bootstrap_ascending
 
 		void run_priorities ();
 		void run_one_priority ();
-		void run_database ();
-		void run_one_database (bool should_throttle);
+		void run_database (nano::bootstrap_ascending::database_scan &);
+		void run_one_database (nano::bootstrap_ascending::database_scan &, bool should_throttle);
 		void run_dependencies ();
 		void run_one_blocking ();
 		void run_timeouts ();
@@ -118,8 +120,9 @@ namespace bootstrap_ascending
 		std::pair<nano::account, double> next_priority ();
 		std::pair<nano::account, double> wait_priority ();
 		/* Gets the next account from the database */
-		nano::account next_database (bool should_throttle);
-		nano::account wait_database (bool should_throttle);
+		nano::account next_database (nano::bootstrap_ascending::database_scan &, bool should_throttle);
+		/* Waits for the next account from the database, then takes adjacent accounts while the channel has free request slots */
+		std::deque<nano::account> wait_database (nano::bootstrap_ascending::database_scan &, bool should_throttle, std::shared_ptr<nano::transport::channel> const &);
 		/* Waits for next available blocking block */
 		nano::block_hash next_blocking ();
 		nano::block_hash wait_blocking ();
@@ -156,7 +159,8 @@ namespace bootstrap_ascending
 
 	private:
 		nano::bootstrap_ascending::account_sets accounts;
-		nano::bootstrap_ascending::database_scan database_scan;
+		// Each scan covers a separate range of the account space and is driven by its own thread
+		std::deque<nano::bootstrap_ascending::database_scan> database_scans;
 		nano::bootstrap_ascending::throttle throttle;
 		nano::bootstrap_ascending::peer_scoring scoring;
 
@@ -189,7 +193,7 @@ namespace bootstrap_ascending
 		mutable nano::mutex mutex;
 		mutable nano::condition_variable condition;
 		std::thread priorities_thread;
-		std::thread database_thread;
+		std::vector<std::thread> database_threads;
 		std::thread dependencies_thread;
 		std::thread timeout_thread;
 	};
@@ -6,13 +6,16 @@
 #include <nano/node/daemonconfig.hpp>
 #include <nano/node/inactive_node.hpp>
 #include <nano/node/node.hpp>
+#include <nano/secure/account_cache.hpp>
 #include <nano/secure/ledger.hpp>
+#include <nano/secure/ledger_snapshot.hpp>
+#include <nano/store/unconfirmed.hpp>
 
 #include <boost/format.hpp>
 
 namespace
 {
-void reset_confirmation_heights (nano::store::write_transaction const & transaction, nano::ledger_constants & constants, nano::store::component & store);
+void reset_confirmation_heights (nano::store::write_transaction & transaction, nano::ledger_constants & constants, nano::store::component & store);
 bool is_using_rocksdb (std::filesystem::path const & data_path, boost::program_options::variables_map const & vm, std::error_code & ec);
 }
 
@@ -49,6 +52,8 @@ void nano::add_node_options (boost::program_options::options_description & descr
 	("account_key", "Get the public key for <account>")
 	("vacuum", "Compact database. If data_path is missing, the database in data directory is compacted.")
 	("snapshot", "Compact database and create snapshot, functions similar to vacuum but does not replace the existing database")
+	("snapshot_export", "Export the ledger into a checksummed snapshot <file> that can be imported by a new node")
+	("snapshot_import", "Import a ledger snapshot <file> into an empty data folder, verifying checksums and block signatures")
 	("data_path", boost::program_options::value<std::string> (), "Use the supplied path as the data directory")
 	("network", boost::program_options::value<std::string> (), "Use the supplied network (live, test, beta or dev)")
 	("clear_send_ids", "Remove all send IDs from the database (dangerous: not intended for production use)")
@@ -250,7 +255,9 @@ bool copy_database (std::filesystem::path const & data_path, boost::program_opti
 		}
 		if (vm.count ("confirmation_height_clear"))
 		{
-			reset_confirmation_heights (store.tx_begin_write (), node.node->network_params.ledger, store);
+			auto transaction = store.tx_begin_write ();
+			reset_confirmation_heights (transaction, node.node->network_params.ledger, store);
+			node.node->ledger.account_cache.clear ();
 		}
 		if (vm.count ("final_vote_clear"))
 		{
@@ -478,6 +485,46 @@ std::error_code nano::handle_node_options (boost::program_options::variables_map
 			std::cerr << "Snapshot failed (unknown reason)" << std::endl;
 		}
 	}
+	else if (vm.count ("snapshot_export") || vm.count ("snapshot_import"))
+	{
+		nano::logger::initialize (nano::log_config::daemon_default (), data_path);
+
+		auto const importing = vm.count ("snapshot_import") > 0;
+		if (vm.count ("file") == 1)
+		{
+			std::filesystem::path file_path{ vm["file"].as<std::string> () };
+			auto node_flags = nano::inactive_node_flag_defaults ();
+			node_flags.read_only = !importing;
+			nano::update_flags (node_flags, vm);
+			nano::inactive_node node (data_path, node_flags);
+			if (!node.node->init_error ())
+			{
+				std::cout << (importing ? "Importing ledger snapshot from " : "Exporting ledger snapshot to ") << file_path << std::endl;
+				std::cout << "This may take a while..." << std::endl;
+
+				nano::ledger_snapshot snapshot{ node.node->ledger, node.node->logger, nano::hardware_concurrency () };
+				auto error = importing ? snapshot.read (file_path) : snapshot.write (file_path);
+				if (!error)
+				{
+					std::cout << (importing ? "Snapshot import completed" : "Snapshot export completed") << std::endl;
+				}
+				else
+				{
+					std::cerr << (importing ? "Snapshot import failed" : "Snapshot export failed") << std::endl;
+					ec = nano::error_cli::generic;
+				}
+			}
+			else
+			{
+				database_write_lock_error (ec);
+			}
+		}
+		else
+		{
+			std::cerr << "snapshot_export and snapshot_import commands require one <file> option\n";
+			ec = nano::error_cli::invalid_arguments;
+		}
+	}
 	else if (vm.count ("migrate_database_lmdb_to_rocksdb"))
 	{
 		nano::logger::initialize (nano::log_config::daemon_default (), data_path);
@@ -602,7 +649,9 @@ std::error_code nano::handle_node_options (boost::program_options::variables_map
 						else
 						{
 							node.node->store.confirmation_height.clear (transaction, account);
+							node.node->store.unconfirmed.put (transaction, account);
 						}
+						node.node->ledger.account_cache.erase (account);
 
 						std::cout << "Confirmation height of account " << account_str << " is set to " << conf_height_reset_num << std::endl;
 					}
@@ -616,6 +665,7 @@ std::error_code nano::handle_node_options (boost::program_options::variables_map
 				{
 					auto transaction (node.node->store.tx_begin_write ());
 					reset_confirmation_heights (transaction, node.node->network_params.ledger, node.node->store);
+					node.node->ledger.account_cache.clear ();
 					std::cout << "Confirmation heights of all accounts (except genesis which is set to 1) are set to 0" << std::endl;
 				}
 				else
@@ -1359,13 +1409,16 @@ std::unique_ptr<nano::inactive_node> nano::default_inactive_node (std::filesyste
 
 namespace
 {
-void reset_confirmation_heights (nano::store::write_transaction const & transaction, nano::ledger_constants & constants, nano::store::component & store)
+void reset_confirmation_heights (nano::store::write_transaction & transaction, nano::ledger_constants & constants, nano::store::component & store)
 {
 	// First do a clean sweep
 	store.confirmation_height.clear (transaction);
 
 	// Then make sure the confirmation height of the genesis account open block is 1
 	store.confirmation_height.put (transaction, constants.genesis->account (), { 1, constants.genesis->hash () });
+
+	// Every account with more than the genesis block is unconfirmed again
+	store.rebuild_unconfirmed (transaction);
 }
 
 bool is_using_rocksdb (std::filesystem::path const & data_path, boost::program_options::variables_map const & vm, std::error_code & ec)
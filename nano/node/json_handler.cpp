@@ -18,6 +18,7 @@
 #include <nano/secure/ledger_set_confirmed.hpp>
 #include <nano/secure/transaction.hpp>
 
+#include <boost/algorithm/hex.hpp>
 #include <boost/property_tree/json_parser.hpp>
 #include <boost/property_tree/ptree.hpp>
 
@@ -4064,22 +4065,61 @@ void nano::json_handler::telemetry ()
 	}
 	else
 	{
-		// By default, consolidated (average or mode) telemetry metrics are returned,
-		// setting "raw" to true returns metrics from all nodes requested.
-		auto raw = request.get_optional<bool> ("raw");
-		auto output_raw = raw.value_or (false);
+		// By default, local telemetry metrics are returned,
+		// setting "raw" to true returns metrics from all nodes requested,
+		// setting "aggregate" to true returns median (or mode for versions) metrics across all nodes.
+		// Both are served from the periodically refreshed telemetry snapshot, "binary" returns the snapshot as a hex encoded dump instead.
+		auto output_raw = request.get<bool> ("raw", false);
+		auto output_aggregate = request.get<bool> ("aggregate", false);
+		auto output_binary = request.get<bool> ("binary", false);
 
-		auto telemetry_responses = node.telemetry.get_all_telemetries ();
-		if (output_raw)
+		if (output_binary)
 		{
+			auto snapshot = node.telemetry.snapshot ();
+			std::vector<uint8_t> bytes;
+			{
+				nano::vectorstream stream{ bytes };
+				snapshot->serialize (stream);
+			}
+			std::string dump;
+			boost::algorithm::hex (bytes.begin (), bytes.end (), std::back_inserter (dump));
+			response_l.put ("dump", dump);
+		}
+		else if (output_aggregate)
+		{
+			auto snapshot = node.telemetry.snapshot ();
+			if (snapshot->aggregate)
+			{
+				nano::jsonconfig config_l;
+				auto const should_ignore_identification_metrics = true;
+				auto err = snapshot->aggregate->serialize_json (config_l, should_ignore_identification_metrics);
+				auto const & ptree = config_l.get_tree ();
+				if (!err)
+				{
+					response_l.insert (response_l.begin (), ptree.begin (), ptree.end ());
+					response_l.put ("peers", snapshot->peers.size ());
+				}
+				else
+				{
+					ec = nano::error_rpc::generic;
+				}
+			}
+			else
+			{
+				ec = nano::error_rpc::peer_not_found;
+			}
+		}
+		else if (output_raw)
+		{
+			auto snapshot = node.telemetry.snapshot ();
 			boost::property_tree::ptree metrics;
-			for (auto & telemetry_metrics : telemetry_responses)
+			for (auto const & [endpoint, data] : snapshot->peers)
 			{
 				nano::jsonconfig config_l;
 				auto const should_ignore_identification_metrics = false;
-				auto err = telemetry_metrics.second.serialize_json (config_l, should_ignore_identification_metrics);
-				config_l.put ("address", telemetry_metrics.first.address ());
-				config_l.put ("port", telemetry_metrics.first.port ());
+				auto err = data.serialize_json (config_l, should_ignore_identification_metrics);
+				config_l.put ("address", endpoint.address ());
+				config_l.put ("port", endpoint.port ());
 				if (!err)
 				{
 					metrics.push_back (std::make_pair ("", config_l.get_tree ()));
@@ -60,6 +60,17 @@ void nano::local_vote_history::erase (nano::root const & root_a)
 	history_by_root.erase (range.first, range.second);
 }
 
+void nano::local_vote_history::erase (std::vector<nano::root> const & roots_a)
+{
+	nano::lock_guard<nano::mutex> guard{ mutex };
+	auto & history_by_root (history.get<tag_root> ());
+	for (auto const & root : roots_a)
+	{
+		auto range (history_by_root.equal_range (root));
+		history_by_root.erase (range.first, range.second);
+	}
+}
+
 std::vector<std::shared_ptr<nano::vote>> nano::local_vote_history::votes (nano::root const & root_a) const
 {
 	nano::lock_guard<nano::mutex> guard{ mutex };
@@ -44,6 +44,7 @@ public:
 	}
 	void add (nano::root const & root_a, nano::block_hash const & hash_a, std::shared_ptr<nano::vote> const & vote_a);
 	void erase (nano::root const & root_a);
+	void erase (std::vector<nano::root> const & roots_a);
 
 	std::vector<std::shared_ptr<nano::vote>> votes (nano::root const & root_a, nano::block_hash const & hash_a, bool const is_final_a = false) const;
 	bool exists (nano::root const &) const;
@@ -1,4 +1,5 @@
 #include <nano/lib/blocks.hpp>
+#include <nano/lib/buffer_pool.hpp>
 #include <nano/lib/config.hpp>
 #include <nano/lib/enum_util.hpp>
 #include <nano/lib/memory.hpp>
@@ -326,7 +327,8 @@ nano::message::message (nano::message_header const & header_a) :
 
 std::shared_ptr<std::vector<uint8_t>> nano::message::to_bytes () const
 {
-	auto bytes = std::make_shared<std::vector<uint8_t>> ();
+	// Payload sizes aren't known up front for every message type, start from the smallest size class and let the stream grow it
+	auto bytes = nano::buffer_pool::acquire (0, nano::buffer_pool::min_size);
 	nano::vectorstream stream (*bytes);
 	serialize (stream);
 	return bytes;
@@ -547,6 +549,7 @@ bool nano::confirm_req::deserialize (nano::stream & stream_a)
 	try
 	{
 		uint8_t const count = hash_count (header);
+		roots_hashes.reserve (count);
 		for (auto i (0); i != count && !result; ++i)
 		{
 			nano::block_hash block_hash (0);
@@ -624,6 +627,14 @@ nano::confirm_ack::confirm_ack (bool & error_a, nano::stream & stream_a, nano::m
 	}
 }
 
+nano::confirm_ack::confirm_ack (nano::message_header const & header_a, std::shared_ptr<nano::vote> const & vote_a, nano::network_filter::digest_t const & digest_a) :
+	message (header_a),
+	vote{ vote_a },
+	digest{ digest_a }
+{
+	debug_assert (vote != nullptr);
+}
+
 nano::confirm_ack::confirm_ack (nano::network_constants const & constants, std::shared_ptr<nano::vote> const & vote_a, bool rebroadcasted_a) :
 	message (constants, nano::message_type::confirm_ack),
 	vote{ vote_a }
@@ -1865,13 +1876,14 @@ void nano::asc_pull_ack::operator() (nano::object_stream & obs) const
 
 void nano::asc_pull_ack::blocks_payload::serialize (nano::stream & stream) const
 {
-	debug_assert (blocks.size () <= max_blocks);
+	debug_assert (size () <= max_blocks);
 
 	for (auto & block : blocks)
 	{
 		debug_assert (block != nullptr);
 		nano::serialize_block (stream, *block);
 	}
+	nano::write (stream, serialized);
 	// For convenience, end with null block terminator
 	nano::serialize_block_type (stream, nano::block_type::not_a_block);
 }
@@ -1886,9 +1898,22 @@ void nano::asc_pull_ack::blocks_payload::deserialize (nano::stream & stream)
 	}
 }
 
+void nano::asc_pull_ack::blocks_payload::append_serialized (nano::block_type type, std::span<uint8_t const> block)
+{
+	serialized.push_back (static_cast<uint8_t> (type));
+	serialized.insert (serialized.end (), block.begin (), block.end ());
+	++serialized_count;
+}
+
+std::size_t nano::asc_pull_ack::blocks_payload::size () const
+{
+	return blocks.size () + serialized_count;
+}
+
 void nano::asc_pull_ack::blocks_payload::operator() (nano::object_stream & obs) const
 {
 	obs.write_range ("blocks", blocks);
+	obs.write ("serialized", serialized_count);
 }
 
 /*
@@ -18,6 +18,7 @@
 #include <bitset>
 #include <cstdint>
 #include <memory>
+#include <span>
 #include <string>
 #include <variant>
 #include <vector>
@@ -268,6 +269,8 @@ class confirm_ack final : public message
 {
 public:
 	confirm_ack (bool & error, nano::stream &, nano::message_header const &, nano::network_filter::digest_t const & digest = 0, nano::vote_uniquer * = nullptr);
+	/** Used for votes which were already parsed from the network */
+	confirm_ack (nano::message_header const &, std::shared_ptr<nano::vote> const &, nano::network_filter::digest_t const & digest);
 	confirm_ack (nano::network_constants const & constants, std::shared_ptr<nano::vote> const &, bool rebroadcasted = false);
 
 	void serialize (nano::stream &) const override;
@@ -686,8 +689,16 @@ public: // Payload definitions
 		void serialize (nano::stream &) const;
 		void deserialize (nano::stream &);
 
+		/** Appends a block that is already serialized, used to forward stored blocks without deserializing them */
+		void append_serialized (nano::block_type, std::span<uint8_t const> block);
+		/** Number of blocks in the payload, including serialized ones */
+		std::size_t size () const;
+
 	public: // Payload
 		std::deque<std::shared_ptr<nano::block>> blocks;
+		/** Blocks in wire format, written after `blocks`. Only used when sending, deserializing always fills `blocks` */
+		std::vector<uint8_t> serialized;
+		std::size_t serialized_count{ 0 };
 
 	public: // Logging
 		void operator() (nano::object_stream &) const;
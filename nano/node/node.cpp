@@ -1,4 +1,5 @@
 #include <nano/lib/blocks.hpp>
+#include <nano/lib/buffer_pool.hpp>
 #include <nano/lib/stream.hpp>
 #include <nano/lib/thread_runner.hpp>
 #include <nano/lib/tomlconfig.hpp>
@@ -81,6 +82,7 @@ nano::node::node (std::shared_ptr<boost::asio::io_context> io_ctx_a, std::filesy
 	bootstrap_workers{ config.bootstrap_serving_threads, nano::thread_role::name::bootstrap_worker },
 	wallet_workers{ 1, nano::thread_role::name::wallet_worker },
 	election_workers{ 1, nano::thread_role::name::election_worker },
+	vote_signing_workers{ config.enable_voting ? config.signature_checker_threads : 0u, nano::thread_role::name::vote_signing },
 	flags (flags_a),
 	work (work_a),
 	distributed_work (*this),
@@ -89,7 +91,7 @@ nano::node::node (std::shared_ptr<boost::asio::io_context> io_ctx_a, std::filesy
 	unchecked{ config.max_unchecked_blocks, stats, flags.disable_block_processor_unchecked_deletion },
 	wallets_store_impl (std::make_unique<nano::mdb_wallets_store> (application_path_a / "wallets.ldb", config_a.lmdb_config)),
 	wallets_store (*wallets_store_impl),
-	ledger_impl{ std::make_unique<nano::ledger> (store, stats, network_params.ledger, flags_a.generate_cache, config_a.representative_vote_weight_minimum.number ()) },
+	ledger_impl{ std::make_unique<nano::ledger> (store, stats, network_params.ledger, flags_a.generate_cache, config_a.representative_vote_weight_minimum.number (), config_a.account_cache_size) },
 	ledger{ *ledger_impl },
 	outbound_limiter_impl{ std::make_unique<nano::bandwidth_limiter> (config) },
 	outbound_limiter{ *outbound_limiter_impl },
@@ -134,9 +136,9 @@ nano::node::node (std::shared_ptr<boost::asio::io_context> io_ctx_a, std::filesy
 	vote_processor{ *vote_processor_impl },
 	vote_cache_processor_impl{ std::make_unique<nano::vote_cache_processor> (config.vote_processor, vote_router, vote_cache, stats, logger) },
 	vote_cache_processor{ *vote_cache_processor_impl },
-	generator_impl{ std::make_unique<nano::vote_generator> (config, *this, ledger, wallets, vote_processor, history, network, stats, logger, /* non-final */ false) },
+	generator_impl{ std::make_unique<nano::vote_generator> (config, *this, ledger, wallets, vote_processor, history, network, vote_signing_workers, stats, logger, /* non-final */ false) },
 	generator{ *generator_impl },
-	final_generator_impl{ std::make_unique<nano::vote_generator> (config, *this, ledger, wallets, vote_processor, history, network, stats, logger, /* final */ true) },
+	final_generator_impl{ std::make_unique<nano::vote_generator> (config, *this, ledger, wallets, vote_processor, history, network, vote_signing_workers, stats, logger, /* final */ true) },
 	final_generator{ *final_generator_impl },
 	scheduler_impl{ std::make_unique<nano::scheduler::component> (config, *this, ledger, block_processor, active, online_reps, vote_cache, confirming_set, stats, logger) },
 	scheduler{ *scheduler_impl },
@@ -675,6 +677,7 @@ void nano::node::stop ()
 	active.stop ();
 	generator.stop ();
 	final_generator.stop ();
+	vote_signing_workers.stop ();
 	confirming_set.stop ();
 	telemetry.stop ();
 	websocket.stop ();
@@ -764,6 +767,7 @@ void nano::node::long_inactivity_cleanup ()
 	{
 		store.online_weight.clear (transaction);
 		store.peer.clear (transaction);
+		online_reps.load_samples (transaction);
 		logger.info (nano::log::type::node, "Removed records of peers and online weight after a long period of inactivity");
 	}
 }
@@ -1297,6 +1301,7 @@ nano::container_info nano::node::container_info () const
 	info.add ("bootstrap_workers", bootstrap_workers.container_info ());
 	info.add ("wallet_workers", wallet_workers.container_info ());
 	info.add ("election_workers", election_workers.container_info ());
+	info.add ("vote_signing_workers", vote_signing_workers.container_info ());
 	info.add ("observers", observers.container_info ());
 	info.add ("wallets", wallets.container_info ());
 	info.add ("vote_processor", vote_processor.container_info ());
@@ -1320,6 +1325,7 @@ nano::container_info nano::node::container_info () const
 	info.add ("local_block_broadcaster", local_block_broadcaster.container_info ());
 	info.add ("rep_tiers", rep_tiers.container_info ());
 	info.add ("message_processor", message_processor.container_info ());
+	info.add ("buffer_pool", nano::buffer_pool::container_info ());
 	return info;
 }
 
@@ -160,6 +160,7 @@ public:
 	nano::thread_pool bootstrap_workers;
 	nano::thread_pool wallet_workers;
 	nano::thread_pool election_workers;
+	nano::thread_pool vote_signing_workers;
 	nano::node_flags flags;
 	nano::work_pool & work;
 	nano::distributed_work_factory distributed_work;
@@ -4,6 +4,8 @@
 #include <nano/store/component.hpp>
 #include <nano/store/online_weight.hpp>
 
+#include <algorithm>
+
 nano::online_reps::online_reps (nano::ledger & ledger_a, nano::node_config const & config_a) :
 	ledger{ ledger_a },
 	config{ config_a }
@@ -11,75 +13,162 @@ nano::online_reps::online_reps (nano::ledger & ledger_a, nano::node_config const
 	if (!ledger.store.init_error ())
 	{
 		auto transaction (ledger.store.tx_begin_read ());
-		trended_m = calculate_trend (transaction);
+		load_samples (transaction);
+	}
+	else
+	{
+		nano::lock_guard<nano::mutex> lock{ mutex };
+		update_delta ();
 	}
 }
 
 void nano::online_reps::observe (nano::account const & rep_a)
 {
-	if (ledger.weight (rep_a) > 0)
+	auto const weight = ledger.weight (rep_a);
+	if (weight > 0)
 	{
 		nano::lock_guard<nano::mutex> lock{ mutex };
 		auto now = std::chrono::steady_clock::now ();
-		auto new_insert = reps.get<tag_account> ().erase (rep_a) == 0;
-		reps.insert ({ now, rep_a });
-		auto cutoff = reps.get<tag_time> ().lower_bound (now - std::chrono::seconds (config.network_params.node.weight_period));
-		auto trimmed = reps.get<tag_time> ().begin () != cutoff;
-		reps.get<tag_time> ().erase (reps.get<tag_time> ().begin (), cutoff);
-		if (new_insert || trimmed)
+		auto & by_account = reps.get<tag_account> ();
+		if (auto existing = by_account.find (rep_a); existing != by_account.end ())
+		{
+			reps_weight -= existing->weight;
+			by_account.modify (existing, [now, &weight] (rep_info & info) {
+				info.time = now;
+				info.weight = weight;
+			});
+		}
+		else
 		{
-			online_m = calculate_online ();
+			reps.insert ({ now, rep_a, weight });
 		}
+		reps_weight += weight;
+		trim (now);
+		if (online_m != reps_weight)
+		{
+			online_m = reps_weight;
+			update_delta ();
+		}
+	}
+}
+
+void nano::online_reps::trim (std::chrono::steady_clock::time_point now)
+{
+	debug_assert (!mutex.try_lock ());
+
+	auto & by_time = reps.get<tag_time> ();
+	auto cutoff = by_time.lower_bound (now - std::chrono::seconds (config.network_params.node.weight_period));
+	for (auto it = by_time.begin (); it != cutoff; ++it)
+	{
+		reps_weight -= it->weight;
 	}
+	by_time.erase (by_time.begin (), cutoff);
 }
 
 void nano::online_reps::sample ()
 {
 	nano::unique_lock<nano::mutex> lock{ mutex };
+	// Observed weights go stale as the ledger changes, correct the running sum once per sample
+	refresh_weights ();
+	online_m = reps_weight;
+	update_delta ();
 	nano::uint128_t online_l = online_m;
+
+	// Discard oldest entries
+	auto const max_samples = config.network_params.node.max_weight_samples;
+	auto const excess = samples.size () >= max_samples ? samples.size () + 1 - max_samples : 0;
+	std::vector<uint64_t> expired;
+	for (std::size_t i = 0; i < excess; ++i)
+	{
+		expired.push_back (samples[i].first);
+	}
 	lock.unlock ();
-	nano::uint128_t trend_l;
+
+	auto const timestamp = static_cast<uint64_t> (std::chrono::system_clock::now ().time_since_epoch ().count ());
 	{
 		auto transaction = ledger.store.tx_begin_write ();
-		// Discard oldest entries
-		while (ledger.store.online_weight.count (transaction) >= config.network_params.node.max_weight_samples)
+		for (auto const & key : expired)
 		{
-			auto oldest (ledger.store.online_weight.begin (transaction));
-			debug_assert (oldest != ledger.store.online_weight.end (transaction));
-			ledger.store.online_weight.del (transaction, oldest->first);
+			ledger.store.online_weight.del (transaction, key);
 		}
-		ledger.store.online_weight.put (transaction, std::chrono::system_clock::now ().time_since_epoch ().count (), online_l);
-		trend_l = calculate_trend (transaction);
+		ledger.store.online_weight.put (transaction, timestamp, online_l);
 	}
+
 	lock.lock ();
-	trended_m = trend_l;
+	for (std::size_t i = 0; i < excess && !samples.empty (); ++i)
+	{
+		auto it = std::lower_bound (samples_sorted.begin (), samples_sorted.end (), samples.front ().second);
+		debug_assert (it != samples_sorted.end () && *it == samples.front ().second);
+		samples_sorted.erase (it);
+		samples.pop_front ();
+	}
+	samples.emplace_back (timestamp, online_l);
+	samples_sorted.insert (std::upper_bound (samples_sorted.begin (), samples_sorted.end (), online_l), online_l);
+	trended_m = calculate_trend ();
+	update_delta ();
+}
+
+void nano::online_reps::load_samples (store::transaction const & transaction_a)
+{
+	nano::lock_guard<nano::mutex> lock{ mutex };
+	samples.clear ();
+	for (auto i (ledger.store.online_weight.begin (transaction_a)), n (ledger.store.online_weight.end (transaction_a)); i != n; ++i)
+	{
+		samples.emplace_back (i->first, i->second.number ());
+	}
+	samples_sorted.clear ();
+	samples_sorted.reserve (samples.size ());
+	for (auto const & [timestamp, weight] : samples)
+	{
+		samples_sorted.push_back (weight);
+	}
+	std::sort (samples_sorted.begin (), samples_sorted.end ());
+	trended_m = calculate_trend ();
+	update_delta ();
 }
 
-nano::uint128_t nano::online_reps::calculate_online () const
+void nano::online_reps::refresh_weights ()
 {
+	debug_assert (!mutex.try_lock ());
+
 	nano::uint128_t current;
-	for (auto & i : reps)
+	for (auto it = reps.begin (), n = reps.end (); it != n; ++it)
 	{
-		current += ledger.weight (i.account);
+		auto weight = ledger.weight (it->account);
+		reps.modify (it, [&weight] (rep_info & info) {
+			info.weight = weight;
+		});
+		current += weight;
 	}
-	return current;
+	reps_weight = current;
 }
 
-nano::uint128_t nano::online_reps::calculate_trend (store::transaction & transaction_a) const
+nano::uint128_t nano::online_reps::calculate_trend () const
 {
-	std::vector<nano::uint128_t> items;
-	items.reserve (config.network_params.node.max_weight_samples + 1);
-	items.push_back (config.online_weight_minimum.number ());
-	for (auto i (ledger.store.online_weight.begin (transaction_a)), n (ledger.store.online_weight.end (transaction_a)); i != n; ++i)
+	debug_assert (!mutex.try_lock ());
+
+	// Pick median value for our target vote weight, out of all samples plus the configured minimum
+	auto const minimum_l = config.online_weight_minimum.number ();
+	auto const median_idx = (samples_sorted.size () + 1) / 2;
+	auto const minimum_idx = static_cast<std::size_t> (std::lower_bound (samples_sorted.begin (), samples_sorted.end (), minimum_l) - samples_sorted.begin ());
+	if (median_idx < minimum_idx)
 	{
-		items.push_back (i->second.number ());
+		return samples_sorted[median_idx];
 	}
-	nano::uint128_t result;
-	// Pick median value for our target vote weight
-	auto median_idx = items.size () / 2;
-	nth_element (items.begin (), items.begin () + median_idx, items.end ());
-	result = items[median_idx];
-	return result;
+	if (median_idx == minimum_idx)
+	{
+		return minimum_l;
+	}
+	return samples_sorted[median_idx - 1];
+}
+
+void nano::online_reps::update_delta ()
+{
+	debug_assert (!mutex.try_lock ());
+
+	// Using a larger container to ensure maximum precision
+	auto weight = static_cast<nano::uint256_t> (std::max ({ online_m, trended_m, config.online_weight_minimum.number () }));
+	delta_m = ((weight * online_weight_quorum) / 100).convert_to<nano::uint128_t> ();
 }
 
 nano::uint128_t nano::online_reps::trended () const
@@ -97,9 +186,7 @@ nano::uint128_t nano::online_reps::online () const
 nano::uint128_t nano::online_reps::delta () const
 {
 	nano::lock_guard<nano::mutex> lock{ mutex };
-	// Using a larger container to ensure maximum precision
-	auto weight = static_cast<nano::uint256_t> (std::max ({ online_m, trended_m, config.online_weight_minimum.number () }));
-	return ((weight * online_weight_quorum) / 100).convert_to<nano::uint128_t> ();
+	return delta_m;
 }
 
 std::vector<nano::account> nano::online_reps::list ()
@@ -114,7 +201,9 @@ void nano::online_reps::clear ()
 {
 	nano::lock_guard<nano::mutex> lock{ mutex };
 	reps.clear ();
+	reps_weight = 0;
 	online_m = 0;
+	update_delta ();
 }
 
 nano::container_info nano::online_reps::container_info () const
@@ -123,5 +212,6 @@ nano::container_info nano::online_reps::container_info () const
 
 	nano::container_info info;
 	info.put ("reps", reps);
+	info.put ("samples", samples);
 	return info;
 }
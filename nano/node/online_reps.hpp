@@ -9,6 +9,7 @@
 #include <boost/multi_index/ordered_index.hpp>
 #include <boost/multi_index_container.hpp>
 
+#include <deque>
 #include <memory>
 #include <vector>
 
@@ -34,8 +35,10 @@ public:
 	nano::uint128_t trended () const;
 	/** Returns the current online stake */
 	nano::uint128_t online () const;
-	/** Returns the quorum required for confirmation*/
+	/** Returns the quorum required for confirmation, kept up to date as reps are observed and samples taken */
 	nano::uint128_t delta () const;
+	/** Reloads online weight samples from the store, needed after the table was modified directly */
+	void load_samples (store::transaction const &);
 	/** List of online representatives, both the currently sampling ones and the ones observed in the previous sampling period */
 	std::vector<nano::account> list ();
 	void clear ();
@@ -50,6 +53,7 @@ private:
 	public:
 		std::chrono::steady_clock::time_point time;
 		nano::account account;
+		nano::uint128_t weight; // As of the last observation or sample
 	};
 	class tag_time
 	{
@@ -57,8 +61,10 @@ private:
 	class tag_account
 	{
 	};
-	nano::uint128_t calculate_trend (store::transaction &) const;
-	nano::uint128_t calculate_online () const;
+	void trim (std::chrono::steady_clock::time_point now);
+	void refresh_weights ();
+	void update_delta ();
+	nano::uint128_t calculate_trend () const;
 	mutable nano::mutex mutex;
 	nano::ledger & ledger;
 	nano::node_config const & config;
@@ -69,8 +75,15 @@ private:
 	boost::multi_index::hashed_unique<boost::multi_index::tag<tag_account>,
 	boost::multi_index::member<rep_info, nano::account, &rep_info::account>>>>
 	reps;
-	nano::uint128_t trended_m;
-	nano::uint128_t online_m;
+	/** Running sum of the weights in `reps` */
+	nano::uint128_t reps_weight{ 0 };
+	/** Persisted samples as (timestamp, weight) in insertion order, so the oldest can be dropped without scanning the table */
+	std::deque<std::pair<uint64_t, nano::uint128_t>> samples;
+	/** Sample weights in ascending order, the trended weight is picked from here by index */
+	std::vector<nano::uint128_t> samples_sorted;
+	nano::uint128_t trended_m{ 0 };
+	nano::uint128_t online_m{ 0 };
+	nano::uint128_t delta_m{ 0 };
 	nano::uint128_t minimum;
 
 	friend class election_quorum_minimum_update_weight_before_quorum_checks_Test;
@@ -14,6 +14,8 @@
 #include <nano/secure/ledger_set_any.hpp>
 #include <nano/store/component.hpp>
 
+#include <unordered_map>
+
 nano::request_aggregator::request_aggregator (request_aggregator_config const & config_a, nano::node & node_a, nano::stats & stats_a, nano::vote_generator & generator_a, nano::vote_generator & final_generator_a, nano::local_vote_history & history_a, nano::ledger & ledger_a, nano::wallets & wallets_a, nano::vote_router & vote_router_a) :
 	config{ config_a },
 	network_constants{ node_a.network_params.network },
@@ -23,7 +25,8 @@ nano::request_aggregator::request_aggregator (request_aggregator_config const &
 	wallets (wallets_a),
 	vote_router{ vote_router_a },
 	generator (generator_a),
-	final_generator (final_generator_a)
+	final_generator (final_generator_a),
+	reply_cache{ config.reply_cache_age, config.reply_cache_size }
 {
 	generator.set_reply_action ([this] (std::shared_ptr<nano::vote> const & vote_a, std::shared_ptr<nano::transport::channel> const & channel_a) {
 		this->reply_action (vote_a, channel_a);
@@ -173,6 +176,15 @@ void nano::request_aggregator::process (nano::secure::transaction const & transa
 {
 	auto const remaining = aggregate (transaction, request, channel);
 
+	if (!remaining.cached_votes.empty ())
+	{
+		for (auto const & vote : remaining.cached_votes)
+		{
+			send (vote, channel);
+		}
+		stats.add (nano::stat::type::requests, nano::stat::detail::requests_cached_votes, stat::dir::in, remaining.cached_votes.size ());
+	}
+
 	if (!remaining.remaining_normal.empty ())
 	{
 		stats.inc (nano::stat::type::request_aggregator_replies, nano::stat::detail::normal_vote);
@@ -191,7 +203,13 @@ void nano::request_aggregator::process (nano::secure::transaction const & transa
 	}
 }
 
-void nano::request_aggregator::reply_action (std::shared_ptr<nano::vote> const & vote_a, std::shared_ptr<nano::transport::channel> const & channel_a) const
+void nano::request_aggregator::reply_action (std::shared_ptr<nano::vote> const & vote_a, std::shared_ptr<nano::transport::channel> const & channel_a)
+{
+	reply_cache.insert (vote_a);
+	send (vote_a, channel_a);
+}
+
+void nano::request_aggregator::send (std::shared_ptr<nano::vote> const & vote_a, std::shared_ptr<nano::transport::channel> const & channel_a) const
 {
 	nano::confirm_ack confirm{ network_constants, vote_a };
 	channel_a->send (confirm);
@@ -212,6 +230,28 @@ auto nano::request_aggregator::aggregate (nano::secure::transaction const & tran
 {
 	std::vector<std::shared_ptr<nano::block>> to_generate;
 	std::vector<std::shared_ptr<nano::block>> to_generate_final;
+	std::vector<std::shared_ptr<nano::vote>> cached_votes;
+
+	// Reuse votes recently generated for other requests, a vote can cover several of the requested hashes
+	auto generate_final = [&] (std::shared_ptr<nano::block> const & block) {
+		auto cached = reply_cache.find (block->hash ());
+		if (cached.empty ())
+		{
+			stats.inc (nano::stat::type::request_aggregator, nano::stat::detail::reply_cache_miss);
+			to_generate_final.push_back (block);
+			return;
+		}
+		stats.inc (nano::stat::type::request_aggregator, nano::stat::detail::reply_cache_hit);
+		stats.inc (nano::stat::type::requests, nano::stat::detail::requests_cached_hashes, stat::dir::in);
+		for (auto const & vote : cached)
+		{
+			if (std::find (cached_votes.begin (), cached_votes.end (), vote) == cached_votes.end ())
+			{
+				cached_votes.push_back (vote);
+			}
+		}
+	};
+
 	for (auto const & [hash, root] : requests_a)
 	{
 		bool generate_final_vote (false);
@@ -227,7 +267,7 @@ auto nano::request_aggregator::aggregate (nano::secure::transaction const & tran
 			if (block != nullptr && final_vote_hashes.size () > 1)
 			{
 				// WTF? This shouldn't be done like this
-				to_generate_final.push_back (block);
+				generate_final (block);
 				block = ledger.any.block_get (transaction, final_vote_hashes[1]);
 				debug_assert (final_vote_hashes.size () == 2);
 			}
@@ -271,7 +311,7 @@ auto nano::request_aggregator::aggregate (nano::secure::transaction const & tran
 		{
 			if (generate_final_vote)
 			{
-				to_generate_final.push_back (block);
+				generate_final (block);
 				stats.inc (nano::stat::type::requests, nano::stat::detail::requests_final);
 			}
 			else
@@ -287,7 +327,8 @@ auto nano::request_aggregator::aggregate (nano::secure::transaction const & tran
 
 	return {
 		.remaining_normal = to_generate,
-		.remaining_final = to_generate_final
+		.remaining_final = to_generate_final,
+		.cached_votes = cached_votes
 	};
 }
 
@@ -297,6 +338,93 @@ nano::container_info nano::request_aggregator::container_info () const
 
 	nano::container_info info;
 	info.add ("queue", queue.container_info ());
+	info.add ("reply_cache", reply_cache.container_info ());
+	return info;
+}
+
+/*
+ * reply_vote_cache
+ */
+
+nano::reply_vote_cache::reply_vote_cache (std::chrono::milliseconds max_age_a, std::size_t max_size_a) :
+	max_age{ max_age_a },
+	max_size{ max_size_a }
+{
+}
+
+void nano::reply_vote_cache::insert (std::shared_ptr<nano::vote> const & vote)
+{
+	if (max_age.count () == 0 || !vote->is_final ())
+	{
+		return;
+	}
+	auto const now = std::chrono::steady_clock::now ();
+
+	nano::lock_guard<nano::mutex> guard{ mutex };
+	++sequence;
+	for (auto const & hash : vote->hashes)
+	{
+		entries.get<tag_sequenced> ().push_back ({ hash, vote, now, sequence });
+	}
+	cleanup (now);
+}
+
+std::vector<std::shared_ptr<nano::vote>> nano::reply_vote_cache::find (nano::block_hash const & hash) const
+{
+	std::vector<std::shared_ptr<nano::vote>> result;
+	if (max_age.count () == 0)
+	{
+		return result;
+	}
+	auto const cutoff = std::chrono::steady_clock::now () - max_age;
+
+	nano::lock_guard<nano::mutex> guard{ mutex };
+	// Concurrent requests can each generate a vote for the same hash, only reply with one per representative
+	std::unordered_map<nano::account, entry const *> newest;
+	auto [begin, end] = entries.get<tag_hash> ().equal_range (hash);
+	for (auto it = begin; it != end; ++it)
+	{
+		if (it->time >= cutoff)
+		{
+			auto [existing, inserted] = newest.emplace (it->vote->account, &*it);
+			auto const & current = *existing->second;
+			if (!inserted && std::make_pair (it->vote->timestamp (), it->sequence) > std::make_pair (current.vote->timestamp (), current.sequence))
+			{
+				existing->second = &*it;
+			}
+		}
+	}
+	for (auto const & [account, item] : newest)
+	{
+		result.push_back (item->vote);
+	}
+	return result;
+}
+
+void nano::reply_vote_cache::cleanup (std::chrono::steady_clock::time_point now)
+{
+	debug_assert (!mutex.try_lock ());
+
+	// Entries are inserted in time order, so expired ones are all at the front
+	auto & sequenced = entries.get<tag_sequenced> ();
+	while (!sequenced.empty () && (sequenced.size () > max_size || sequenced.front ().time < now - max_age))
+	{
+		sequenced.pop_front ();
+	}
+}
+
+std::size_t nano::reply_vote_cache::size () const
+{
+	nano::lock_guard<nano::mutex> guard{ mutex };
+	return entries.size ();
+}
+
+nano::container_info nano::reply_vote_cache::container_info () const
+{
+	nano::lock_guard<nano::mutex> guard{ mutex };
+
+	nano::container_info info;
+	info.put ("entries", entries.size ());
 	return info;
 }
 
@@ -309,6 +437,8 @@ nano::error nano::request_aggregator_config::serialize (nano::tomlconfig & toml)
 	toml.put ("max_queue", max_queue, "Maximum number of queued requests per peer. \ntype:uint64");
 	toml.put ("threads", threads, "Number of threads for request processing. \ntype:uint64");
 	toml.put ("batch_size", batch_size, "Number of requests to process in a single batch. \ntype:uint64");
+	toml.put ("reply_cache_age", reply_cache_age.count (), "How long votes generated in reply to requests are reused for other requests of the same blocks. Zero disables the cache. \ntype:milliseconds");
+	toml.put ("reply_cache_size", reply_cache_size, "Maximum number of hashes kept in the reply vote cache. \ntype:uint64");
 
 	return toml.get_error ();
 }
@@ -318,6 +448,8 @@ nano::error nano::request_aggregator_config::deserialize (nano::tomlconfig & tom
 	toml.get ("max_queue", max_queue);
 	toml.get ("threads", threads);
 	toml.get ("batch_size", batch_size);
+	toml.get_duration ("reply_cache_age", reply_cache_age);
+	toml.get ("reply_cache_size", reply_cache_size);
 
 	return toml.get_error ();
 }
@@ -11,8 +11,10 @@
 #include <boost/multi_index/hashed_index.hpp>
 #include <boost/multi_index/member.hpp>
 #include <boost/multi_index/ordered_index.hpp>
+#include <boost/multi_index/sequenced_index.hpp>
 #include <boost/multi_index_container.hpp>
 
+#include <chrono>
 #include <condition_variable>
 #include <thread>
 #include <unordered_map>
@@ -32,6 +34,59 @@ public:
 	size_t threads{ std::clamp (nano::hardware_concurrency () / 2, 1u, 4u) };
 	size_t max_queue{ 128 };
 	size_t batch_size{ 16 };
+	/** How long generated reply votes are reused for other requests of the same hashes, zero disables the cache */
+	std::chrono::milliseconds reply_cache_age{ 1000 };
+	size_t reply_cache_size{ 1024 * 32 };
+};
+
+/**
+ * Short lived cache of final votes generated in reply to confirmation requests, indexed by each of the hashes they cover.
+ * When many peers ask for the same elections at about the same time they all get the same votes instead of freshly signed ones.
+ * @note This class is thread-safe.
+ */
+class reply_vote_cache final
+{
+public:
+	reply_vote_cache (std::chrono::milliseconds max_age, std::size_t max_size);
+
+	/** Non final votes are ignored, their timestamps go stale and replies for them are generated fresh */
+	void insert (std::shared_ptr<nano::vote> const &);
+	/** Newest cached vote covering \p hash from each representative, empty when nothing recent was cached */
+	std::vector<std::shared_ptr<nano::vote>> find (nano::block_hash const & hash) const;
+
+	std::size_t size () const;
+	nano::container_info container_info () const;
+
+private:
+	void cleanup (std::chrono::steady_clock::time_point now);
+
+	class entry final
+	{
+	public:
+		nano::block_hash hash;
+		std::shared_ptr<nano::vote> vote;
+		std::chrono::steady_clock::time_point time;
+		uint64_t sequence; // Insertion order, breaks ties between votes with equal timestamps
+	};
+
+	std::chrono::milliseconds const max_age;
+	std::size_t const max_size;
+
+	// clang-format off
+	class tag_sequenced {};
+	class tag_hash {};
+
+	using ordered_entries = boost::multi_index_container<entry,
+	mi::indexed_by<
+		mi::sequenced<mi::tag<tag_sequenced>>,
+		mi::hashed_non_unique<mi::tag<tag_hash>,
+			mi::member<entry, nano::block_hash, &entry::hash>>
+	>>;
+	// clang-format on
+	ordered_entries entries;
+	uint64_t sequence{ 0 };
+
+	mutable nano::mutex mutex;
 };
 
 /**
@@ -40,7 +95,7 @@ public:
  * * Two votes are cached, one for hashes {1,2,3} and another for hashes {4,5,6}
  * * A request arrives for hashes {1,4,5}. Another request arrives soon afterwards for hashes {2,3,6}
  * * The aggregator will reply with the two cached votes
- * Votes are generated for uncached hashes.
+ * Votes are generated for uncached hashes, replies are kept for a short while in a reply_vote_cache to serve other peers asking for the same hashes.
  */
 class request_aggregator final
 {
@@ -74,12 +129,14 @@ private:
 	{
 		std::vector<std::shared_ptr<nano::block>> remaining_normal;
 		std::vector<std::shared_ptr<nano::block>> remaining_final;
+		std::vector<std::shared_ptr<nano::vote>> cached_votes;
 	};
 
-	/** Aggregate \p requests_a and send cached votes to \p channel_a . Return the remaining hashes that need vote generation for each block for regular & final vote generators **/
+	/** Aggregate \p requests_a . Return the cached votes to reply with and the remaining hashes that need vote generation for each block for regular & final vote generators **/
 	aggregate_result aggregate (nano::secure::transaction const &, request_type const &, std::shared_ptr<nano::transport::channel> const &) const;
 
-	void reply_action (std::shared_ptr<nano::vote> const & vote_a, std::shared_ptr<nano::transport::channel> const & channel_a) const;
+	void reply_action (std::shared_ptr<nano::vote> const & vote_a, std::shared_ptr<nano::transport::channel> const & channel_a);
+	void send (std::shared_ptr<nano::vote> const & vote_a, std::shared_ptr<nano::transport::channel> const & channel_a) const;
 
 private: // Dependencies
 	request_aggregator_config const & config;
@@ -95,6 +152,7 @@ private: // Dependencies
 private:
 	using value_type = std::pair<request_type, std::shared_ptr<nano::transport::channel>>;
 	nano::fair_queue<value_type, nano::no_value> queue;
+	nano::reply_vote_cache reply_cache;
 
 	bool stopped{ false };
 	nano::condition_variable condition;
@@ -20,9 +20,10 @@ nano::scheduler::bucket::~bucket ()
 {
 }
 
-bool nano::scheduler::bucket::available () const
+bool nano::scheduler::bucket::available ()
 {
 	nano::lock_guard<nano::mutex> lock{ mutex };
+	drain ();
 
 	if (queue.empty ())
 	{
@@ -74,6 +75,7 @@ bool nano::scheduler::bucket::election_overfill () const
 bool nano::scheduler::bucket::activate ()
 {
 	nano::lock_guard<nano::mutex> lock{ mutex };
+	drain ();
 
 	if (queue.empty ())
 	{
@@ -82,6 +84,7 @@ bool nano::scheduler::bucket::activate ()
 
 	block_entry top = *queue.begin ();
 	queue.erase (queue.begin ());
+	update_cutoff ();
 
 	auto block = top.block;
 	auto priority = top.time;
@@ -110,6 +113,7 @@ bool nano::scheduler::bucket::activate ()
 void nano::scheduler::bucket::update ()
 {
 	nano::lock_guard<nano::mutex> lock{ mutex };
+	drain ();
 
 	if (election_overfill ())
 	{
@@ -121,6 +125,30 @@ void nano::scheduler::bucket::update ()
 bool nano::scheduler::bucket::push (uint64_t time, std::shared_ptr<nano::block> block)
 {
 	nano::lock_guard<nano::mutex> lock{ mutex };
+	drain ();
+	return insert (time, block);
+}
+
+bool nano::scheduler::bucket::enqueue (uint64_t time, std::shared_ptr<nano::block> block)
+{
+	if (time > cutoff.load (std::memory_order_relaxed))
+	{
+		stats.inc (nano::stat::type::election_bucket, nano::stat::detail::insert_failed);
+		return false;
+	}
+	incoming.push ({ time, std::move (block) });
+	// Bound the number of unsorted blocks in case the scheduler isn't draining this bucket
+	if (incoming_count.fetch_add (1, std::memory_order_relaxed) + 1 > config.max_blocks)
+	{
+		nano::lock_guard<nano::mutex> lock{ mutex };
+		drain ();
+	}
+	return true;
+}
+
+bool nano::scheduler::bucket::insert (uint64_t time, std::shared_ptr<nano::block> block)
+{
+	debug_assert (!mutex.try_lock ());
 
 	auto [it, inserted] = queue.insert ({ time, block });
 	release_assert (!queue.empty ());
@@ -128,20 +156,46 @@ bool nano::scheduler::bucket::push (uint64_t time, std::shared_ptr<nano::block>
 	if (queue.size () > config.max_blocks)
 	{
 		queue.erase (--queue.end ());
+		update_cutoff ();
 		return inserted && !was_last;
 	}
+	update_cutoff ();
 	return inserted;
 }
 
-size_t nano::scheduler::bucket::size () const
+void nano::scheduler::bucket::drain ()
+{
+	debug_assert (!mutex.try_lock ());
+
+	auto entries = incoming.pop_all ();
+	incoming_count.fetch_sub (entries.size (), std::memory_order_relaxed);
+	for (auto & entry : entries)
+	{
+		if (!insert (entry.time, std::move (entry.block)))
+		{
+			stats.inc (nano::stat::type::election_bucket, nano::stat::detail::insert_failed);
+		}
+	}
+}
+
+void nano::scheduler::bucket::update_cutoff ()
+{
+	debug_assert (!mutex.try_lock ());
+
+	cutoff.store (queue.size () >= config.max_blocks ? (--queue.end ())->time : std::numeric_limits<uint64_t>::max (), std::memory_order_relaxed);
+}
+
+size_t nano::scheduler::bucket::size ()
 {
 	nano::lock_guard<nano::mutex> lock{ mutex };
+	drain ();
 	return queue.size ();
 }
 
-bool nano::scheduler::bucket::empty () const
+bool nano::scheduler::bucket::empty ()
 {
 	nano::lock_guard<nano::mutex> lock{ mutex };
+	drain ();
 	return queue.empty ();
 }
 
@@ -163,9 +217,10 @@ void nano::scheduler::bucket::cancel_lowest_election ()
 	}
 }
 
-std::deque<std::shared_ptr<nano::block>> nano::scheduler::bucket::blocks () const
+std::deque<std::shared_ptr<nano::block>> nano::scheduler::bucket::blocks ()
 {
 	nano::lock_guard<nano::mutex> lock{ mutex };
+	drain ();
 
 	std::deque<std::shared_ptr<nano::block>> result;
 	for (auto const & item : queue)
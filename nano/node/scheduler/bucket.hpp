@@ -1,5 +1,6 @@
 #pragma once
 
+#include <nano/lib/mpsc_queue.hpp>
 #include <nano/node/fwd.hpp>
 #include <nano/secure/common.hpp>
 
@@ -9,9 +10,11 @@
 #include <boost/multi_index/sequenced_index.hpp>
 #include <boost/multi_index_container.hpp>
 
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 #include <deque>
+#include <limits>
 #include <memory>
 #include <set>
 
@@ -58,20 +61,33 @@ public:
 
 	nano::uint128_t const minimum_balance;
 
-	bool available () const;
+	bool available ();
 	bool activate ();
 	void update ();
 
 	bool push (uint64_t time, std::shared_ptr<nano::block> block);
-
-	size_t size () const;
+	/**
+	 * Queues the block without taking the bucket lock, so block processing threads don't contend with the scheduler
+	 * Blocks are sorted in by the next call that locks the bucket, or right away once more than `max_blocks` are waiting
+	 * @return false if the bucket is full and the block has lower priority than all queued blocks
+	 */
+	bool enqueue (uint64_t time, std::shared_ptr<nano::block> block);
+
+	size_t size ();
 	size_t election_count () const;
-	bool empty () const;
-	std::deque<std::shared_ptr<nano::block>> blocks () const;
+	bool empty ();
+	std::deque<std::shared_ptr<nano::block>> blocks ();
 
 	void dump () const;
 
+public:
+	/** Set while the bucket is tracked by the priority scheduler as having blocks to activate */
+	std::atomic<bool> scheduled{ false };
+
 private:
+	bool insert (uint64_t time, std::shared_ptr<nano::block> block);
+	void drain ();
+	void update_cutoff ();
 	bool election_vacancy (priority_t candidate) const;
 	bool election_overfill () const;
 	void cancel_lowest_election ();
@@ -92,6 +108,9 @@ private: // Blocks
 	};
 
 	std::set<block_entry> queue;
+	nano::mpsc_queue<block_entry> incoming; // Moved into `queue` by every call that locks the bucket
+	std::atomic<std::size_t> incoming_count{ 0 };
+	std::atomic<uint64_t> cutoff{ std::numeric_limits<uint64_t>::max () }; // Time of the lowest priority block while `queue` is full
 
 private: // Elections
 	struct election_entry
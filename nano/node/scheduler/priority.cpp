@@ -120,8 +120,7 @@ bool nano::scheduler::priority::activate (secure::transaction const & transactio
 	debug_assert (!account.is_zero ());
 	if (auto info = ledger.any.account_get (transaction, account))
 	{
-		nano::confirmation_height_info conf_info;
-		ledger.store.confirmation_height.get (transaction, account, conf_info);
+		auto const conf_info = ledger.confirmation_height (transaction, account).value_or (nano::confirmation_height_info{});
 		if (conf_info.height < info->block_count)
 		{
 			return activate (transaction, account, *info, conf_info);
@@ -145,12 +144,8 @@ bool nano::scheduler::priority::activate (secure::transaction const & transactio
 		auto const previous_balance = ledger.any.block_balance (transaction, conf_info.frontier).value_or (0);
 		auto const balance_priority = std::max (balance, previous_balance);
 
-		bool added = false;
-		{
-			auto & bucket = find_bucket (balance_priority);
-			added = bucket.push (account_info.modified, block);
-		}
-		if (added)
+		auto const index = find_bucket (balance_priority);
+		if (buckets[index]->enqueue (account_info.modified, block))
 		{
 			stats.inc (nano::stat::type::election_scheduler, nano::stat::detail::activated);
 			logger.trace (nano::log::type::election_scheduler, nano::log::detail::block_activated,
@@ -159,7 +154,7 @@ bool nano::scheduler::priority::activate (secure::transaction const & transactio
 			nano::log::arg{ "time", account_info.modified },
 			nano::log::arg{ "priority", balance_priority });
 
-			notify ();
+			schedule (index);
 		}
 		else
 		{
@@ -186,9 +181,33 @@ bool nano::scheduler::priority::activate_successors (secure::transaction const &
 
 void nano::scheduler::priority::notify ()
 {
+	{
+		nano::lock_guard<nano::mutex> lock{ mutex };
+		++notifications;
+		for (auto const & entry : waiting)
+		{
+			ready.push (entry);
+		}
+		waiting.clear ();
+	}
 	condition.notify_all ();
 }
 
+void nano::scheduler::priority::schedule (std::size_t index)
+{
+	auto & bucket = *buckets[index];
+	// Only the transition to ready takes the scheduler lock, a bucket that is already tracked is left alone
+	if (!bucket.scheduled.exchange (true))
+	{
+		ready_entry entry{ bucket.election_count (), index };
+		{
+			nano::lock_guard<nano::mutex> lock{ mutex };
+			ready.push (entry);
+		}
+		condition.notify_all ();
+	}
+}
+
 std::size_t nano::scheduler::priority::size () const
 {
 	return std::accumulate (buckets.begin (), buckets.end (), std::size_t{ 0 }, [] (auto const & sum, auto const & bucket) {
@@ -203,37 +222,55 @@ bool nano::scheduler::priority::empty () const
 	});
 }
 
-bool nano::scheduler::priority::predicate () const
-{
-	return std::any_of (buckets.begin (), buckets.end (), [] (auto const & bucket) {
-		return bucket->available ();
-	});
-}
-
 void nano::scheduler::priority::run ()
 {
 	nano::unique_lock<nano::mutex> lock{ mutex };
 	while (!stopped)
 	{
 		condition.wait (lock, [this] () {
-			return stopped || predicate ();
+			return stopped || !ready.empty ();
 		});
 		debug_assert ((std::this_thread::yield (), true)); // Introduce some random delay in debug builds
 		if (!stopped)
 		{
 			stats.inc (nano::stat::type::election_scheduler, nano::stat::detail::loop);
 
+			auto const index = ready.top ().second;
+			ready.pop ();
+			auto const notified = notifications;
+
 			lock.unlock ();
 
-			for (auto & bucket : buckets)
+			auto & bucket = *buckets[index];
+			// A block is consumed whenever the bucket is available, even if the election could not be started
+			bool const available = bucket.available ();
+			if (available)
 			{
-				if (bucket->available ())
-				{
-					bucket->activate ();
-				}
+				bucket.activate ();
+			}
+			bool requeue = !bucket.empty ();
+			if (!requeue)
+			{
+				// Blocks enqueued after the check above saw the bucket as scheduled and didn't track it, so check again once cleared
+				bucket.scheduled = false;
+				requeue = !bucket.empty () && !bucket.scheduled.exchange (true);
 			}
+			ready_entry const entry{ bucket.election_count (), index };
 
 			lock.lock ();
+
+			if (requeue)
+			{
+				if (available || notified != notifications)
+				{
+					ready.push (entry);
+				}
+				else
+				{
+					// No vacancy in this bucket, wait until elections finish
+					waiting.push_back (entry);
+				}
+			}
 		}
 	}
 }
@@ -262,14 +299,13 @@ void nano::scheduler::priority::run_cleanup ()
 	}
 }
 
-auto nano::scheduler::priority::find_bucket (nano::uint128_t priority) -> bucket &
+std::size_t nano::scheduler::priority::find_bucket (nano::uint128_t priority) const
 {
 	auto it = std::upper_bound (buckets.begin (), buckets.end (), priority, [] (nano::uint128_t const & priority, std::unique_ptr<bucket> const & bucket) {
 		return priority < bucket->minimum_balance;
 	});
 	release_assert (it != buckets.begin ()); // There should always be a bucket with a minimum_balance of 0
-	it = std::prev (it);
-	return **it;
+	return std::distance (buckets.begin (), it) - 1;
 }
 
 nano::container_info nano::scheduler::priority::container_info () const
@@ -7,8 +7,10 @@
 #include <condition_variable>
 #include <deque>
 #include <memory>
+#include <queue>
 #include <string>
 #include <thread>
+#include <vector>
 
 namespace nano::scheduler
 {
@@ -59,12 +61,22 @@ private: // Dependencies
 private:
 	void run ();
 	void run_cleanup ();
-	bool predicate () const;
-	bucket & find_bucket (nano::uint128_t priority);
+	std::size_t find_bucket (nano::uint128_t priority) const;
+	/** Starts tracking the bucket as ready if it isn't already */
+	void schedule (std::size_t index);
 
 private:
 	std::vector<std::unique_ptr<bucket>> buckets;
 
+	/** Bucket index keyed by its election count when it became ready, buckets with the most free election slots are served first */
+	using ready_entry = std::pair<std::size_t, std::size_t>;
+	// Buckets with queued blocks, the scheduler thread only looks at these instead of scanning all buckets
+	std::priority_queue<ready_entry, std::vector<ready_entry>, std::greater<>> ready;
+	// Buckets with queued blocks but without election vacancy, moved back to `ready` on notify ()
+	std::vector<ready_entry> waiting;
+	// Incremented by notify (), lets the scheduler thread detect vacancy changes while it had the lock released
+	uint64_t notifications{ 0 };
+
 	bool stopped{ false };
 	nano::condition_variable condition;
 	mutable nano::mutex mutex;
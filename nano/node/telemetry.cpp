@@ -24,7 +24,8 @@ nano::telemetry::telemetry (nano::node_flags const & flags_a, nano::node & node_
 	network{ network_a },
 	observers{ observers_a },
 	network_params{ network_params_a },
-	stats{ stats_a }
+	stats{ stats_a },
+	snapshot_m{ std::make_shared<nano::telemetry_snapshot> () }
 {
 }
 
@@ -100,6 +101,8 @@ void nano::telemetry::process (const nano::telemetry_ack & telemetry, const std:
 	{
 		stats.inc (nano::stat::type::telemetry, nano::stat::detail::update);
 
+		aggregator.erase (it->data);
+		aggregator.insert (telemetry.data);
 		telemetries.get<tag_channel> ().modify (it, [&telemetry, &channel] (auto & entry) {
 			entry.data = telemetry.data;
 			entry.last_updated = std::chrono::steady_clock::now ();
@@ -109,16 +112,26 @@ void nano::telemetry::process (const nano::telemetry_ack & telemetry, const std:
 	{
 		stats.inc (nano::stat::type::telemetry, nano::stat::detail::insert);
 		telemetries.get<tag_channel> ().insert ({ channel, telemetry.data, std::chrono::steady_clock::now () });
+		aggregator.insert (telemetry.data);
 
 		if (telemetries.size () > max_size)
 		{
 			stats.inc (nano::stat::type::telemetry, nano::stat::detail::overfill);
+			aggregator.erase (telemetries.get<tag_sequenced> ().front ().data);
 			telemetries.get<tag_sequenced> ().pop_front (); // Erase oldest entry
 		}
 	}
 
+	bool const notify = !dirty;
+	dirty = true;
+
 	lock.unlock ();
 
+	if (notify)
+	{
+		condition.notify_all ();
+	}
+
 	observers.telemetry.notify (telemetry.data, channel);
 
 	stats.inc (nano::stat::type::telemetry, nano::stat::detail::process);
@@ -195,8 +208,57 @@ void nano::telemetry::run ()
 			last_broadcast = std::chrono::steady_clock::now ();
 		}
 
-		condition.wait_for (lock, std::min (network_params.network.telemetry_request_interval, network_params.network.telemetry_broadcast_interval) / 2);
+		if (dirty && last_snapshot + snapshot_interval <= std::chrono::steady_clock::now ())
+		{
+			refresh_snapshot (lock);
+		}
+
+		auto const interval = std::min (network_params.network.telemetry_request_interval, network_params.network.telemetry_broadcast_interval) / 2;
+		if (dirty)
+		{
+			// Wake up in time for the next snapshot
+			condition.wait_until (lock, std::min (std::chrono::steady_clock::now () + interval, last_snapshot + snapshot_interval));
+		}
+		else
+		{
+			condition.wait_for (lock, interval, [this] () { return stopped || dirty || triggered; });
+		}
+	}
+}
+
+void nano::telemetry::refresh_snapshot (nano::unique_lock<nano::mutex> & lock)
+{
+	debug_assert (lock.owns_lock ());
+
+	stats.inc (nano::stat::type::telemetry, nano::stat::detail::snapshot);
+
+	auto snapshot_l = std::make_shared<nano::telemetry_snapshot> ();
+	snapshot_l->peers.reserve (telemetries.size ());
+	for (auto const & entry : telemetries)
+	{
+		// Same filter as `get_all_telemetries`, stale entries can linger until the next cleanup
+		if (check_timeout (entry))
+		{
+			snapshot_l->peers.push_back ({ entry.endpoint (), entry.data });
+		}
+	}
+	snapshot_l->aggregate = aggregator.aggregate ();
+	snapshot_l->generated = std::chrono::system_clock::now ();
+
+	dirty = false;
+	last_snapshot = std::chrono::steady_clock::now ();
+
+	lock.unlock ();
+
+	std::shared_ptr<nano::telemetry_snapshot const> previous = std::move (snapshot_l);
+	{
+		nano::lock_guard<nano::mutex> guard{ snapshot_mutex };
+		snapshot_m.swap (previous);
 	}
+	// Previous snapshot is released outside of any lock
+	previous.reset ();
+
+	lock.lock ();
 }
 
 void nano::telemetry::run_requests ()
@@ -245,11 +307,15 @@ void nano::telemetry::cleanup ()
 		if (!check_timeout (entry))
 		{
 			stats.inc (nano::stat::type::telemetry, nano::stat::detail::erase_stale);
+			aggregator.erase (entry.data);
+			dirty = true;
 			return true; // Erase
 		}
 		if (!entry.channel->alive ())
 		{
 			stats.inc (nano::stat::type::telemetry, nano::stat::detail::erase_dead);
+			aggregator.erase (entry.data);
+			dirty = true;
 			return true; // Erase
 		}
 		return false; // Do not erase
@@ -290,11 +356,190 @@ std::unordered_map<nano::endpoint, nano::telemetry_data> nano::telemetry::get_al
 	return result;
 }
 
+std::shared_ptr<nano::telemetry_snapshot const> nano::telemetry::snapshot () const
+{
+	nano::lock_guard<nano::mutex> guard{ snapshot_mutex };
+	return snapshot_m;
+}
+
 nano::container_info nano::telemetry::container_info () const
 {
 	nano::lock_guard<nano::mutex> guard{ mutex };
 
 	nano::container_info info;
 	info.put ("telemetries", telemetries.size ());
+	info.put ("aggregator", aggregator.size ());
 	return info;
+}
+
+/*
+ * telemetry_aggregator
+ */
+
+void nano::telemetry_aggregator::insert (nano::telemetry_data const & data)
+{
+	auto const metrics_l = metrics (data);
+	for (std::size_t i = 0; i < metric_count; ++i)
+	{
+		auto & sorted = values[i];
+		sorted.insert (std::upper_bound (sorted.begin (), sorted.end (), metrics_l[i]), metrics_l[i]);
+	}
+	++versions[version (data)];
+	++genesis[data.genesis_block];
+}
+
+void nano::telemetry_aggregator::erase (nano::telemetry_data const & data)
+{
+	auto const metrics_l = metrics (data);
+	for (std::size_t i = 0; i < metric_count; ++i)
+	{
+		auto & sorted = values[i];
+		auto it = std::lower_bound (sorted.begin (), sorted.end (), metrics_l[i]);
+		debug_assert (it != sorted.end () && *it == metrics_l[i]);
+		if (it != sorted.end () && *it == metrics_l[i])
+		{
+			sorted.erase (it);
+		}
+	}
+	auto decrement = [] (auto & counts, auto const & key) {
+		if (auto it = counts.find (key); it != counts.end () && --it->second == 0)
+		{
+			counts.erase (it);
+		}
+	};
+	decrement (versions, version (data));
+	decrement (genesis, data.genesis_block);
+}
+
+std::size_t nano::telemetry_aggregator::size () const
+{
+	return values[0].size ();
+}
+
+std::optional<nano::telemetry_data> nano::telemetry_aggregator::aggregate () const
+{
+	if (size () == 0)
+	{
+		return std::nullopt;
+	}
+
+	auto median = [this] (metric metric_a) {
+		auto const & sorted = values[metric_a];
+		return sorted[sorted.size () / 2];
+	};
+	auto mode = [] (auto const & counts) {
+		return std::max_element (counts.begin (), counts.end (), [] (auto const & a, auto const & b) { return a.second < b.second; })->first;
+	};
+
+	nano::telemetry_data result;
+	result.block_count = median (metric::block_count);
+	result.cemented_count = median (metric::cemented_count);
+	result.unchecked_count = median (metric::unchecked_count);
+	result.account_count = median (metric::account_count);
+	result.bandwidth_cap = median (metric::bandwidth_cap);
+	result.uptime = median (metric::uptime);
+	result.peer_count = static_cast<uint32_t> (median (metric::peer_count));
+	result.active_difficulty = median (metric::active_difficulty);
+	result.timestamp = std::chrono::system_clock::time_point{ std::chrono::milliseconds{ median (metric::timestamp) } };
+	std::tie (result.protocol_version, result.major_version, result.minor_version, result.patch_version, result.pre_release_version, result.maker) = mode (versions);
+	result.genesis_block = mode (genesis);
+	return result;
+}
+
+auto nano::telemetry_aggregator::metrics (nano::telemetry_data const & data) -> std::array<uint64_t, metric_count>
+{
+	return {
+		data.block_count,
+		data.cemented_count,
+		data.unchecked_count,
+		data.account_count,
+		data.bandwidth_cap,
+		data.uptime,
+		data.peer_count,
+		data.active_difficulty,
+		static_cast<uint64_t> (std::chrono::duration_cast<std::chrono::milliseconds> (data.timestamp.time_since_epoch ()).count ()),
+	};
+}
+
+auto nano::telemetry_aggregator::version (nano::telemetry_data const & data) -> version_t
+{
+	return { data.protocol_version, data.major_version, data.minor_version, data.patch_version, data.pre_release_version, data.maker };
+}
+
+/*
+ * telemetry_snapshot
+ */
+
+void nano::telemetry_snapshot::serialize (nano::stream & stream) const
+{
+	auto write_data = [&stream] (nano::telemetry_data const & data) {
+		nano::write (stream, boost::endian::native_to_big (static_cast<uint16_t> (nano::telemetry_data::size + data.unknown_data.size ())));
+		data.serialize (stream);
+	};
+
+	nano::write (stream, format_version);
+	nano::write (stream, boost::endian::native_to_big (static_cast<uint64_t> (std::chrono::duration_cast<std::chrono::milliseconds> (generated.time_since_epoch ()).count ())));
+	nano::write (stream, static_cast<uint8_t> (aggregate.has_value ()));
+	if (aggregate)
+	{
+		write_data (*aggregate);
+	}
+	nano::write (stream, boost::endian::native_to_big (static_cast<uint32_t> (peers.size ())));
+	for (auto const & [endpoint, data] : peers)
+	{
+		nano::write (stream, nano::transport::map_endpoint_to_v6 (endpoint).address ().to_v6 ().to_bytes ());
+		nano::write (stream, boost::endian::native_to_big (endpoint.port ()));
+		write_data (data);
+	}
+}
+
+bool nano::telemetry_snapshot::deserialize (nano::stream & stream)
+{
+	auto read_data = [&stream] () {
+		uint16_t size;
+		nano::read (stream, size);
+		boost::endian::big_to_native_inplace (size);
+		if (size < nano::telemetry_data::size)
+		{
+			throw std::runtime_error ("Invalid telemetry size");
+		}
+		nano::telemetry_data data;
+		data.deserialize (stream, size);
+		return data;
+	};
+
+	try
+	{
+		uint8_t version;
+		nano::read (stream, version);
+		if (version != format_version)
+		{
+			return true;
+		}
+		uint64_t generated_l;
+		nano::read (stream, generated_l);
+		generated = std::chrono::system_clock::time_point{ std::chrono::milliseconds{ boost::endian::big_to_native (generated_l) } };
+		uint8_t has_aggregate;
+		nano::read (stream, has_aggregate);
+		aggregate = has_aggregate ? std::make_optional (read_data ()) : std::nullopt;
+		uint32_t count;
+		nano::read (stream, count);
+		boost::endian::big_to_native_inplace (count);
+		peers.clear ();
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			boost::asio::ip::address_v6::bytes_type address;
+			nano::read (stream, address);
+			uint16_t port;
+			nano::read (stream, port);
+			boost::endian::big_to_native_inplace (port);
+			auto data = read_data ();
+			peers.push_back ({ nano::endpoint{ boost::asio::ip::address_v6{ address }, port }, std::move (data) });
+		}
+	}
+	catch (std::runtime_error const &)
+	{
+		return true;
+	}
+	return false;
 }
\ No newline at end of file
@@ -12,10 +12,14 @@
 #include <boost/multi_index/ordered_index.hpp>
 #include <boost/multi_index_container.hpp>
 
+#include <array>
 #include <functional>
+#include <map>
 #include <memory>
 #include <optional>
 #include <thread>
+#include <tuple>
+#include <vector>
 
 namespace mi = boost::multi_index;
 
@@ -34,6 +38,77 @@ public:
 	}
 };
 
+/**
+ * Keeps the values of every numeric metric sorted and counts versions across all stored telemetry,
+ * so the aggregate can be read without visiting every entry. Entries are added and removed as telemetry is received and expires.
+ */
+class telemetry_aggregator final
+{
+public:
+	void insert (nano::telemetry_data const &);
+	void erase (nano::telemetry_data const &);
+	std::size_t size () const;
+
+	/**
+	 * Median of every numeric metric and the most common version and genesis, identity fields are left empty
+	 * @returns nullopt if there is no telemetry
+	 */
+	std::optional<nano::telemetry_data> aggregate () const;
+
+private:
+	enum metric
+	{
+		block_count,
+		cemented_count,
+		unchecked_count,
+		account_count,
+		bandwidth_cap,
+		uptime,
+		peer_count,
+		active_difficulty,
+		timestamp,
+		metric_count
+	};
+
+	// protocol, major, minor, patch, pre release, maker
+	using version_t = std::tuple<uint8_t, uint8_t, uint8_t, uint8_t, uint8_t, uint8_t>;
+
+	static std::array<uint64_t, metric_count> metrics (nano::telemetry_data const &);
+	static version_t version (nano::telemetry_data const &);
+
+private:
+	std::array<std::vector<uint64_t>, metric_count> values;
+	std::map<version_t, std::size_t> versions;
+	std::map<nano::block_hash, std::size_t> genesis;
+};
+
+/**
+ * Immutable view of all telemetry received from peers together with its aggregate
+ * Shared between readers without copying, a new snapshot replaces the old one when telemetry changes
+ */
+class telemetry_snapshot final
+{
+public:
+	struct peer
+	{
+		nano::endpoint endpoint;
+		nano::telemetry_data data;
+	};
+
+	std::vector<peer> peers;
+	std::optional<nano::telemetry_data> aggregate;
+	std::chrono::system_clock::time_point generated{};
+
+	/**
+	 * Compact binary dump for external monitoring: format version, generation time, aggregate and every peer in telemetry wire format
+	 */
+	void serialize (nano::stream &) const;
+	/** @returns true on error */
+	bool deserialize (nano::stream &);
+
+	static uint8_t constexpr format_version = 1;
+};
+
 /**
  * This class periodically broadcasts and requests telemetry from peers.
  * Those intervals are configurable via `telemetry_request_interval` & `telemetry_broadcast_interval` network constants
@@ -73,6 +148,12 @@ public:
 	 */
 	std::unordered_map<nano::endpoint, nano::telemetry_data> get_all_telemetries () const;
 
+	/**
+	 * Returns the latest snapshot of all available telemetry, refreshed periodically while telemetry changes
+	 * Cheap to call, never blocks on telemetry processing
+	 */
+	std::shared_ptr<nano::telemetry_snapshot const> snapshot () const;
+
 	nano::container_info container_info () const;
 
 private: // Dependencies
@@ -104,6 +185,7 @@ private:
 	void run_requests ();
 	void run_broadcasts ();
 	void cleanup ();
+	void refresh_snapshot (nano::unique_lock<nano::mutex> &);
 
 	void request (std::shared_ptr<nano::transport::channel> const &);
 	void broadcast (std::shared_ptr<nano::transport::channel> const &, nano::telemetry_data const &);
@@ -128,6 +210,12 @@ private:
 	// clang-format on
 
 	ordered_telemetries telemetries;
+	nano::telemetry_aggregator aggregator;
+
+	bool dirty{ false }; // Telemetry changed since the last snapshot
+	std::chrono::steady_clock::time_point last_snapshot{};
+	std::shared_ptr<nano::telemetry_snapshot const> snapshot_m;
+	mutable nano::mutex snapshot_mutex; // Only guards swapping the snapshot pointer
 
 	bool triggered{ false };
 	std::chrono::steady_clock::time_point last_request{};
@@ -140,5 +228,6 @@ private:
 
 private:
 	static std::size_t constexpr max_size = 1024;
+	static std::chrono::milliseconds constexpr snapshot_interval{ 1000 };
 };
 }
@@ -1,10 +1,10 @@
+#include <nano/lib/buffer_pool.hpp>
 #include <nano/lib/enum_util.hpp>
 #include <nano/node/node.hpp>
 #include <nano/node/transport/message_deserializer.hpp>
 
 nano::transport::message_deserializer::message_deserializer (nano::network_constants const & network_constants_a, nano::network_filter & network_filter_a, nano::block_uniquer & block_uniquer_a, nano::vote_uniquer & vote_uniquer_a,
 read_query read_op) :
-	read_buffer{ std::make_shared<std::vector<uint8_t>> () },
 	network_constants_m{ network_constants_a },
 	network_filter_m{ network_filter_a },
 	block_uniquer_m{ block_uniquer_a },
@@ -12,7 +12,6 @@ read_query read_op) :
 	read_op{ std::move (read_op) }
 {
 	debug_assert (this->read_op);
-	read_buffer->resize (MAX_MESSAGE_SIZE);
 }
 
 void nano::transport::message_deserializer::read (const nano::transport::message_deserializer::callback_type && callback)
@@ -22,6 +21,8 @@ void nano::transport::message_deserializer::read (const nano::transport::message
 
 	status = parse_status::none;
 
+	// Only a small buffer is held while waiting for the next message, the payload buffer is acquired once its size is known
+	read_buffer = nano::buffer_pool::acquire (HEADER_SIZE);
 	read_op (read_buffer, HEADER_SIZE, [this_l = shared_from_this (), callback = std::move (callback)] (boost::system::error_code const & ec, std::size_t size_a) {
 		if (ec)
 		{
@@ -74,7 +75,7 @@ void nano::transport::message_deserializer::received_header (const nano::transpo
 		callback (boost::asio::error::fault, nullptr);
 		return;
 	}
-	debug_assert (payload_size <= read_buffer->capacity ());
+	read_buffer = nano::buffer_pool::acquire (payload_size);
 
 	if (payload_size == 0)
 	{
@@ -103,6 +104,8 @@ void nano::transport::message_deserializer::received_header (const nano::transpo
 void nano::transport::message_deserializer::received_message (nano::message_header header, std::size_t payload_size, const nano::transport::message_deserializer::callback_type && callback)
 {
 	auto message = deserialize (header, payload_size);
+	// Return the buffer before invoking the callback, which may already start reading the next message
+	read_buffer.reset ();
 	if (message)
 	{
 		debug_assert (status == parse_status::none);
@@ -150,7 +153,7 @@ std::unique_ptr<nano::message> nano::transport::message_deserializer::deserializ
 			nano::uint128_t digest;
 			if (!network_filter_m.apply (read_buffer->data (), payload_size, &digest))
 			{
-				return deserialize_confirm_ack (stream, header, digest);
+				return deserialize_confirm_ack ({ read_buffer->data (), payload_size }, header, digest);
 			}
 			else
 			{
@@ -256,19 +259,23 @@ std::unique_ptr<nano::confirm_req> nano::transport::message_deserializer::deseri
 	return {};
 }
 
-std::unique_ptr<nano::confirm_ack> nano::transport::message_deserializer::deserialize_confirm_ack (nano::stream & stream, nano::message_header const & header, nano::network_filter::digest_t const & digest_a)
+std::unique_ptr<nano::confirm_ack> nano::transport::message_deserializer::deserialize_confirm_ack (std::span<uint8_t const> payload, nano::message_header const & header, nano::network_filter::digest_t const & digest_a)
 {
-	auto error = false;
-	auto incoming = std::make_unique<nano::confirm_ack> (error, stream, header, digest_a, &vote_uniquer_m);
-	if (!error && nano::at_end (stream))
+	// Parsed straight from the receive buffer, the payload size was already derived from the header hash count
+	auto view = nano::vote_view::parse (payload);
+	if (!view)
 	{
-		return incoming;
+		status = parse_status::invalid_confirm_ack_message;
+		return {};
 	}
-	else
+	// The same vote is commonly received from many peers, reuse the live instance without deserializing it again
+	auto const full_hash = view->full_hash ();
+	auto vote = vote_uniquer_m.find (full_hash);
+	if (!vote)
 	{
-		status = parse_status::invalid_confirm_ack_message;
+		vote = vote_uniquer_m.unique (full_hash, view->to_vote ());
 	}
-	return {};
+	return std::make_unique<nano::confirm_ack> (header, vote, digest_a);
 }
 
 std::unique_ptr<nano::node_id_handshake> nano::transport::message_deserializer::deserialize_node_id_handshake (nano::stream & stream, nano::message_header const & header)
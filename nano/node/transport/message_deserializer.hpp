@@ -5,6 +5,7 @@
 #include <nano/node/messages.hpp>
 
 #include <memory>
+#include <span>
 #include <vector>
 
 namespace nano
@@ -69,7 +70,7 @@ namespace transport
 		std::unique_ptr<nano::keepalive> deserialize_keepalive (nano::stream &, nano::message_header const &);
 		std::unique_ptr<nano::publish> deserialize_publish (nano::stream &, nano::message_header const &, nano::network_filter::digest_t const & digest);
 		std::unique_ptr<nano::confirm_req> deserialize_confirm_req (nano::stream &, nano::message_header const &);
-		std::unique_ptr<nano::confirm_ack> deserialize_confirm_ack (nano::stream &, nano::message_header const &, nano::network_filter::digest_t const & digest);
+		std::unique_ptr<nano::confirm_ack> deserialize_confirm_ack (std::span<uint8_t const> payload, nano::message_header const &, nano::network_filter::digest_t const & digest);
 		std::unique_ptr<nano::node_id_handshake> deserialize_node_id_handshake (nano::stream &, nano::message_header const &);
 		std::unique_ptr<nano::telemetry_req> deserialize_telemetry_req (nano::stream &, nano::message_header const &);
 		std::unique_ptr<nano::telemetry_ack> deserialize_telemetry_ack (nano::stream &, nano::message_header const &);
@@ -7,6 +7,7 @@
 
 #include <boost/format.hpp>
 
+#include <algorithm>
 #include <cstdint>
 #include <cstdlib>
 #include <iterator>
@@ -176,6 +177,17 @@ void nano::transport::tcp_socket::async_write (nano::shared_const_buffer const &
 	});
 }
 
+namespace
+{
+class write_batch
+{
+public:
+	nano::transport::socket_queue::batch_t entries;
+	std::vector<boost::asio::const_buffer> buffers;
+	std::size_t syscalls{ 0 };
+};
+}
+
 // Must be called from strand
 void nano::transport::tcp_socket::write_queued_messages ()
 {
@@ -186,17 +198,32 @@ void nano::transport::tcp_socket::write_queued_messages ()
 		return;
 	}
 
-	auto next = send_queue.pop ();
-	if (!next)
+	auto batch = std::make_shared<write_batch> ();
+	batch->entries = send_queue.pop_batch (max_write_batch_size, max_write_batch_buffers);
+	if (batch->entries.empty ())
 	{
 		return;
 	}
+	batch->buffers.reserve (batch->entries.size ());
+	for (auto const & entry : batch->entries)
+	{
+		batch->buffers.insert (batch->buffers.end (), entry.buffer.begin (), entry.buffer.end ());
+	}
 
 	set_default_timeout ();
 
 	write_in_progress = true;
-	nano::async_write (raw_socket, next->buffer,
-	boost::asio::bind_executor (strand, [this_l = shared_from_this (), next /* `next` object keeps buffer in scope */] (boost::system::error_code ec, std::size_t size) {
+	boost::asio::async_write (raw_socket, batch->buffers,
+	[batch] (boost::system::error_code const & ec, std::size_t transferred) -> std::size_t {
+		// Asked before every write_some, each of which is a single (vectored) write syscall
+		auto result = boost::asio::transfer_all () (ec, transferred);
+		if (result > 0)
+		{
+			++batch->syscalls;
+		}
+		return result;
+	},
+	boost::asio::bind_executor (strand, [this_l = shared_from_this (), batch /* keeps buffers in scope */] (boost::system::error_code ec, std::size_t size) {
 		debug_assert (this_l->strand.running_in_this_thread ());
 
 		auto node_l = this_l->node_w.lock ();
@@ -216,10 +243,21 @@ void nano::transport::tcp_socket::write_queued_messages ()
 			node_l->stats.add (nano::stat::type::traffic_tcp, nano::stat::detail::all, nano::stat::dir::out, size, /* aggregate all */ true);
 			this_l->set_last_completion ();
 		}
-
-		if (next->callback)
+		node_l->stats.inc (nano::stat::type::tcp, nano::stat::detail::tcp_write_batch, nano::stat::dir::out);
+		node_l->stats.add (nano::stat::type::tcp, nano::stat::detail::tcp_write_message, nano::stat::dir::out, batch->entries.size ());
+		node_l->stats.add (nano::stat::type::tcp, nano::stat::detail::tcp_write_syscall, nano::stat::dir::out, batch->syscalls);
+		node_l->stats.sample (nano::stat::sample::tcp_write_batch_messages, batch->entries.size (), { 0, max_write_batch_buffers });
+
+		// Buffers are written in order, report to each message how much of it made it out
+		auto remaining = size;
+		for (auto const & entry : batch->entries)
 		{
-			next->callback (ec, size);
+			auto const written = std::min (remaining, entry.buffer.size ());
+			remaining -= written;
+			if (entry.callback)
+			{
+				entry.callback (ec, written);
+			}
 		}
 
 		if (!ec)
@@ -430,7 +468,7 @@ bool nano::transport::socket_queue::insert (const buffer_t & buffer, callback_t
 	nano::lock_guard<nano::mutex> guard{ mutex };
 	if (queues[traffic_type].size () < 2 * max_size)
 	{
-		queues[traffic_type].push (entry{ buffer, callback });
+		queues[traffic_type].push_back (entry{ buffer, callback });
 		return true; // Queued
 	}
 	return false; // Not queued
@@ -439,35 +477,79 @@ bool nano::transport::socket_queue::insert (const buffer_t & buffer, callback_t
 std::optional<nano::transport::socket_queue::entry> nano::transport::socket_queue::pop ()
 {
 	nano::lock_guard<nano::mutex> guard{ mutex };
+	if (auto queue = next_queue ())
+	{
+		auto item = std::move (queue->front ());
+		queue->pop_front ();
+		++current_taken;
+		return item;
+	}
+	return std::nullopt;
+}
 
-	auto try_pop = [this] (nano::transport::traffic_type type) -> std::optional<entry> {
-		auto & que = queues[type];
-		if (!que.empty ())
+auto nano::transport::socket_queue::pop_batch (std::size_t max_bytes, std::size_t max_entries) -> batch_t
+{
+	nano::lock_guard<nano::mutex> guard{ mutex };
+	batch_t result;
+	std::size_t bytes = 0;
+	while (result.size () < max_entries)
+	{
+		auto queue = next_queue ();
+		if (!queue)
 		{
-			auto item = que.front ();
-			que.pop ();
-			return item;
+			break;
 		}
-		return std::nullopt;
-	};
+		auto const size = queue->front ().buffer.size ();
+		if (!result.empty () && bytes + size > max_bytes)
+		{
+			break; // Left for the next write
+		}
+		bytes += size;
+		result.push_back (std::move (queue->front ()));
+		queue->pop_front ();
+		++current_taken;
+	}
+	return result;
+}
+
+std::deque<nano::transport::socket_queue::entry> * nano::transport::socket_queue::next_queue ()
+{
+	debug_assert (!mutex.try_lock ());
 
-	// TODO: This is a very basic prioritization, implement something more advanced and configurable
-	if (auto item = try_pop (nano::transport::traffic_type::generic))
+	auto const & types = nano::enum_util::values<nano::transport::traffic_type> ();
+	// Enough steps to visit every other traffic type and come back to the current one with renewed credit
+	for (std::size_t step = 0; step <= types.size (); ++step)
 	{
-		return item;
+		auto & queue = queues[current];
+		if (!queue.empty () && current_taken < weight (current))
+		{
+			return &queue;
+		}
+		auto it = std::find (types.begin (), types.end (), current);
+		current = (it == types.end () || std::next (it) == types.end ()) ? types.front () : *std::next (it);
+		current_taken = 0;
 	}
-	if (auto item = try_pop (nano::transport::traffic_type::bootstrap))
+	return nullptr;
+}
+
+std::size_t nano::transport::socket_queue::weight (nano::transport::traffic_type traffic_type)
+{
+	switch (traffic_type)
 	{
-		return item;
+		case nano::transport::traffic_type::generic:
+			return 8;
+		case nano::transport::traffic_type::bootstrap:
+			return 1; // Few but large messages
 	}
-
-	return std::nullopt;
+	debug_assert (false);
+	return 1;
 }
 
 void nano::transport::socket_queue::clear ()
 {
 	nano::lock_guard<nano::mutex> guard{ mutex };
 	queues.clear ();
+	current_taken = 0;
 }
 
 std::size_t nano::transport::socket_queue::size (nano::transport::traffic_type traffic_type) const
@@ -10,6 +10,7 @@
 #include <nano/node/transport/traffic_type.hpp>
 
 #include <chrono>
+#include <deque>
 #include <map>
 #include <memory>
 #include <optional>
@@ -41,20 +42,36 @@ public:
 		callback_t callback;
 	};
 
+	using batch_t = std::vector<entry>;
+
 public:
 	explicit socket_queue (std::size_t max_size);
 
 	bool insert (buffer_t const &, callback_t, nano::transport::traffic_type);
 	std::optional<entry> pop ();
+	/**
+	 * Takes entries for a single gather write, visiting traffic types in weighted round robin order
+	 * Always takes at least one entry if any are queued, otherwise stops before exceeding \p max_bytes or \p max_entries
+	 */
+	batch_t pop_batch (std::size_t max_bytes, std::size_t max_entries);
 	void clear ();
 	std::size_t size (nano::transport::traffic_type) const;
 	bool empty () const;
 
+	/** Number of consecutive entries taken from a traffic type before moving on to the next one */
+	static std::size_t weight (nano::transport::traffic_type);
+
 	std::size_t const max_size;
 
+private:
+	/** Advances the round robin to the next traffic type with queued entries and credit left */
+	std::deque<entry> * next_queue ();
+
 private:
 	mutable nano::mutex mutex;
-	std::unordered_map<nano::transport::traffic_type, std::queue<entry>> queues;
+	std::unordered_map<nano::transport::traffic_type, std::deque<entry>> queues;
+	nano::transport::traffic_type current{ nano::transport::traffic_type::generic };
+	std::size_t current_taken{ 0 };
 };
 
 /** Socket class for tcp clients and newly accepted connections */
@@ -66,6 +83,9 @@ class tcp_socket final : public std::enable_shared_from_this<tcp_socket>
 
 public:
 	static std::size_t constexpr default_max_queue_size = 128;
+	/** Queued messages are coalesced into a single gather write of up to this many bytes and buffers, matching what asio hands to a single write syscall */
+	static std::size_t constexpr max_write_batch_size = 64 * 1024;
+	static std::size_t constexpr max_write_batch_buffers = 64;
 
 public:
 	explicit tcp_socket (nano::node &, nano::transport::socket_endpoint = socket_endpoint::client, std::size_t max_queue_size = default_max_queue_size);
@@ -9,7 +9,8 @@
 nano::unchecked_map::unchecked_map (unsigned const max_unchecked_blocks, nano::stats & stats, bool const & disable_delete) :
 	max_unchecked_blocks{ max_unchecked_blocks },
 	stats{ stats },
-	disable_delete{ disable_delete }
+	disable_delete{ disable_delete },
+	max_shard_entries{ std::max<size_t> ((max_unchecked_blocks + shard_count - 1) / shard_count, 1) }
 {
 }
 
@@ -44,13 +45,19 @@ void nano::unchecked_map::stop ()
 
 void nano::unchecked_map::put (nano::hash_or_account const & dependency, nano::unchecked_info const & info)
 {
-	nano::lock_guard<std::recursive_mutex> lock{ entries_mutex };
 	nano::unchecked_key key{ dependency, info.block->hash () };
-	entries.get<tag_root> ().insert ({ key, info });
-
-	if (entries.size () > max_unchecked_blocks)
+	auto & shard = shard_for (key.key ());
 	{
-		entries.get<tag_sequenced> ().pop_front ();
+		nano::lock_guard<nano::mutex> lock{ shard.mutex };
+		auto [begin, end] = shard.entries.get<tag_dependency> ().equal_range (key.key ());
+		if (std::none_of (begin, end, [&key] (entry const & existing) { return existing.key == key; }))
+		{
+			shard.entries.get<tag_sequenced> ().push_back ({ key, info });
+			if (shard.entries.size () > max_shard_entries)
+			{
+				shard.entries.get<tag_sequenced> ().pop_front ();
+			}
+		}
 	}
 
 	stats.inc (nano::stat::type::unchecked, nano::stat::detail::put);
@@ -58,17 +65,25 @@ void nano::unchecked_map::put (nano::hash_or_account const & dependency, nano::u
 
 void nano::unchecked_map::for_each (std::function<void (nano::unchecked_key const &, nano::unchecked_info const &)> action, std::function<bool ()> predicate)
 {
-	nano::lock_guard<std::recursive_mutex> lock{ entries_mutex };
-	for (auto i = entries.begin (), n = entries.end (); predicate () && i != n; ++i)
+	for (auto & shard : shards)
 	{
-		action (i->key, i->info);
+		nano::lock_guard<nano::mutex> lock{ shard.mutex };
+		for (auto i = shard.entries.begin (), n = shard.entries.end (); i != n; ++i)
+		{
+			if (!predicate ())
+			{
+				return;
+			}
+			action (i->key, i->info);
+		}
 	}
 }
 
 void nano::unchecked_map::for_each (nano::hash_or_account const & dependency, std::function<void (nano::unchecked_key const &, nano::unchecked_info const &)> action, std::function<bool ()> predicate)
 {
-	nano::lock_guard<std::recursive_mutex> lock{ entries_mutex };
-	for (auto i = entries.template get<tag_root> ().lower_bound (nano::unchecked_key{ dependency, 0 }), n = entries.template get<tag_root> ().end (); predicate () && i != n && i->key.key () == dependency.as_block_hash (); ++i)
+	auto & shard = shard_for (dependency.as_block_hash ());
+	nano::lock_guard<nano::mutex> lock{ shard.mutex };
+	for (auto [i, n] = shard.entries.get<tag_dependency> ().equal_range (dependency.as_block_hash ()); predicate () && i != n; ++i)
 	{
 		action (i->key, i->info);
 	}
@@ -85,27 +100,43 @@ std::vector<nano::unchecked_info> nano::unchecked_map::get (nano::block_hash con
 
 bool nano::unchecked_map::exists (nano::unchecked_key const & key) const
 {
-	nano::lock_guard<std::recursive_mutex> lock{ entries_mutex };
-	return entries.get<tag_root> ().count (key) != 0;
+	auto const & shard = shard_for (key.key ());
+	nano::lock_guard<nano::mutex> lock{ shard.mutex };
+	auto [begin, end] = shard.entries.get<tag_dependency> ().equal_range (key.key ());
+	return std::any_of (begin, end, [&key] (entry const & existing) { return existing.key == key; });
 }
 
 void nano::unchecked_map::del (nano::unchecked_key const & key)
 {
-	nano::lock_guard<std::recursive_mutex> lock{ entries_mutex };
-	auto erased = entries.get<tag_root> ().erase (key);
-	debug_assert (erased);
+	auto & shard = shard_for (key.key ());
+	nano::lock_guard<nano::mutex> lock{ shard.mutex };
+	auto [begin, end] = shard.entries.get<tag_dependency> ().equal_range (key.key ());
+	auto existing = std::find_if (begin, end, [&key] (entry const & existing) { return existing.key == key; });
+	debug_assert (existing != end);
+	if (existing != end)
+	{
+		shard.entries.get<tag_dependency> ().erase (existing);
+	}
 }
 
 void nano::unchecked_map::clear ()
 {
-	nano::lock_guard<std::recursive_mutex> lock{ entries_mutex };
-	entries.clear ();
+	for (auto & shard : shards)
+	{
+		nano::lock_guard<nano::mutex> lock{ shard.mutex };
+		shard.entries.clear ();
+	}
 }
 
 size_t nano::unchecked_map::entries_size () const
 {
-	nano::lock_guard<std::recursive_mutex> lock{ entries_mutex };
-	return entries.size ();
+	size_t result = 0;
+	for (auto const & shard : shards)
+	{
+		nano::lock_guard<nano::mutex> lock{ shard.mutex };
+		result += shard.entries.size ();
+	}
+	return result;
 }
 
 size_t nano::unchecked_map::queries_size () const
@@ -128,6 +159,19 @@ void nano::unchecked_map::trigger (nano::hash_or_account const & dependency)
 	condition.notify_all (); // Notify run ()
 }
 
+void nano::unchecked_map::trigger (std::deque<nano::hash_or_account> const & dependencies)
+{
+	if (dependencies.empty ())
+	{
+		return;
+	}
+	nano::unique_lock<nano::mutex> lock{ mutex };
+	buffer.insert (buffer.end (), dependencies.begin (), dependencies.end ());
+	lock.unlock ();
+	stats.add (nano::stat::type::unchecked, nano::stat::detail::trigger, dependencies.size ());
+	condition.notify_all (); // Notify run ()
+}
+
 void nano::unchecked_map::process_queries (decltype (buffer) const & back_buffer)
 {
 	for (auto const & item : back_buffer)
@@ -162,19 +206,37 @@ void nano::unchecked_map::run ()
 
 void nano::unchecked_map::query_impl (nano::block_hash const & hash)
 {
-	std::deque<nano::unchecked_key> delete_queue;
-	for_each (hash, [this, &delete_queue] (nano::unchecked_key const & key, nano::unchecked_info const & info) {
-		delete_queue.push_back (key);
-		stats.inc (nano::stat::type::unchecked, nano::stat::detail::satisfied);
-		satisfied.notify (info);
-	});
-	if (!disable_delete)
+	// Satisfied entries are collected under the shard lock and handed to observers after releasing it
+	std::deque<nano::unchecked_info> satisfied_entries;
 	{
-		for (auto const & key : delete_queue)
+		auto & shard = shard_for (hash);
+		nano::lock_guard<nano::mutex> lock{ shard.mutex };
+		auto & index = shard.entries.get<tag_dependency> ();
+		auto [begin, end] = index.equal_range (hash);
+		for (auto i = begin; i != end; ++i)
+		{
+			satisfied_entries.push_back (i->info);
+		}
+		if (!disable_delete)
 		{
-			del (key);
+			index.erase (begin, end);
 		}
 	}
+	for (auto const & info : satisfied_entries)
+	{
+		stats.inc (nano::stat::type::unchecked, nano::stat::detail::satisfied);
+		satisfied.notify (info);
+	}
+}
+
+auto nano::unchecked_map::shard_for (nano::block_hash const & dependency) -> shard &
+{
+	return shards[std::hash<nano::block_hash>{}(dependency) % shard_count];
+}
+
+auto nano::unchecked_map::shard_for (nano::block_hash const & dependency) const -> shard const &
+{
+	return shards[std::hash<nano::block_hash>{}(dependency) % shard_count];
 }
 
 nano::container_info nano::unchecked_map::container_info () const
@@ -5,12 +5,12 @@
 #include <nano/lib/observer_set.hpp>
 #include <nano/secure/common.hpp>
 
-#include <boost/multi_index/member.hpp>
-#include <boost/multi_index/ordered_index.hpp>
-#include <boost/multi_index/random_access_index.hpp>
+#include <boost/multi_index/hashed_index.hpp>
+#include <boost/multi_index/mem_fun.hpp>
 #include <boost/multi_index/sequenced_index.hpp>
 #include <boost/multi_index_container.hpp>
 
+#include <array>
 #include <thread>
 
 namespace mi = boost::multi_index;
@@ -19,6 +19,11 @@ namespace nano
 {
 class stats;
 
+/**
+ * Blocks waiting for a dependency (previous block, source block or account) to be processed.
+ * Entries are split into shards by dependency hash, each with its own lock and FIFO eviction, so inserts from the block processor
+ * and lookups from the trigger thread rarely contend.
+ */
 class unchecked_map
 {
 public:
@@ -29,6 +34,10 @@ public:
 	void stop ();
 
 	void put (nano::hash_or_account const & dependency, nano::unchecked_info const & info);
+	/**
+	 * Iterates entries shard by shard while holding the lock of the shard being iterated
+	 * Actions must not call back into the unchecked map
+	 */
 	void for_each (
 	std::function<void (nano::unchecked_key const &, nano::unchecked_info const &)> action, std::function<bool ()> predicate = [] () { return true; });
 	void for_each (
@@ -42,6 +51,10 @@ public:
 	 * Trigger requested dependencies
 	 */
 	void trigger (nano::hash_or_account const & dependency);
+	/**
+	 * Trigger all dependencies satisfied by a batch of processed blocks with a single wake up of the processing thread
+	 */
+	void trigger (std::deque<nano::hash_or_account> const & dependencies);
 
 	size_t count () const; // Same as `entries_size ()`
 	size_t entries_size () const;
@@ -52,6 +65,9 @@ public:
 public: // Events
 	nano::observer_set<nano::unchecked_info const &> satisfied;
 
+public:
+	static size_t constexpr shard_count{ 16 };
+
 private:
 	void run ();
 	void query_impl (nano::block_hash const & hash);
@@ -79,20 +95,38 @@ private:
 	{
 		nano::unchecked_key key;
 		nano::unchecked_info info;
+
+		nano::block_hash dependency () const
+		{
+			return key.key ();
+		}
 	};
 
 	// clang-format off
 	class tag_sequenced {};
-	class tag_root {};
+	class tag_dependency {};
 
 	using ordered_unchecked = boost::multi_index_container<entry,
 		mi::indexed_by<
 			mi::sequenced<mi::tag<tag_sequenced>>,
-			mi::ordered_unique<mi::tag<tag_root>,
-				mi::member<entry, nano::unchecked_key, &entry::key>>>>;
+			mi::hashed_non_unique<mi::tag<tag_dependency>,
+				mi::const_mem_fun<entry, nano::block_hash, &entry::dependency>>>>;
 	// clang-format on
-	ordered_unchecked entries;
 
-	mutable std::recursive_mutex entries_mutex; // Protects entries
+	class shard
+	{
+	public:
+		ordered_unchecked entries;
+		mutable nano::mutex mutex; // Protects entries
+	};
+
+	shard & shard_for (nano::block_hash const & dependency);
+	shard const & shard_for (nano::block_hash const & dependency) const;
+
+	std::array<shard, shard_count> shards;
+	// Maximum number of entries in a single shard, evicting the oldest ones first
+	size_t const max_shard_entries;
+
+	friend class unchecked_eviction_Test;
 };
 }
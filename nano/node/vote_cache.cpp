@@ -4,10 +4,78 @@
 #include <nano/node/vote_cache.hpp>
 #include <nano/node/vote_router.hpp>
 
+#include <algorithm>
+#include <limits>
 #include <ranges>
 
 /*
- * entvote_cache_entryry
+ * vote_cache_representatives
+ */
+
+auto nano::vote_cache_representatives::acquire (nano::account const & account) -> id_t
+{
+	if (auto existing = ids.find (account); existing != ids.end ())
+	{
+		++slots[existing->second].references;
+		return existing->second;
+	}
+
+	id_t id;
+	if (!free_ids.empty ())
+	{
+		id = free_ids.back ();
+		free_ids.pop_back ();
+		slots[id] = { account, 1 };
+	}
+	else
+	{
+		release_assert (slots.size () < std::numeric_limits<id_t>::max ());
+		id = static_cast<id_t> (slots.size ());
+		slots.push_back ({ account, 1 });
+	}
+	ids.emplace (account, id);
+	return id;
+}
+
+void nano::vote_cache_representatives::acquire (id_t id)
+{
+	debug_assert (id < slots.size () && slots[id].references > 0);
+	++slots[id].references;
+}
+
+void nano::vote_cache_representatives::release (id_t id)
+{
+	debug_assert (id < slots.size () && slots[id].references > 0);
+	auto & slot = slots[id];
+	if (--slot.references == 0)
+	{
+		ids.erase (slot.account);
+		free_ids.push_back (id);
+	}
+}
+
+void nano::vote_cache_representatives::clear ()
+{
+	ids.clear ();
+	slots.clear ();
+	free_ids.clear ();
+}
+
+std::size_t nano::vote_cache_representatives::size () const
+{
+	return ids.size ();
+}
+
+nano::container_info nano::vote_cache_representatives::container_info () const
+{
+	nano::container_info info;
+	info.put ("ids", ids);
+	info.put ("slots", slots);
+	return info;
+}
+
+/*
+ * vote_cache_entry
  */
 
 nano::vote_cache_entry::vote_cache_entry (const nano::block_hash & hash) :
@@ -15,9 +83,9 @@ nano::vote_cache_entry::vote_cache_entry (const nano::block_hash & hash) :
 {
 }
 
-bool nano::vote_cache_entry::vote (std::shared_ptr<nano::vote> const & vote, const nano::uint128_t & rep_weight, std::size_t max_voters)
+bool nano::vote_cache_entry::vote (std::shared_ptr<nano::vote> const & vote, vote_cache_representatives::id_t representative, const nano::uint128_t & rep_weight, std::size_t max_voters, vote_cache_representatives & representatives)
 {
-	bool updated = vote_impl (vote, rep_weight, max_voters);
+	bool updated = vote_impl (vote, representative, rep_weight, max_voters, representatives);
 	if (updated)
 	{
 		auto [tally, final_tally] = calculate_tally ();
@@ -28,27 +96,36 @@ bool nano::vote_cache_entry::vote (std::shared_ptr<nano::vote> const & vote, con
 	return updated;
 }
 
-bool nano::vote_cache_entry::vote_impl (std::shared_ptr<nano::vote> const & vote, const nano::uint128_t & rep_weight, std::size_t max_voters)
+bool nano::vote_cache_entry::vote_impl (std::shared_ptr<nano::vote> const & vote, vote_cache_representatives::id_t representative, const nano::uint128_t & rep_weight, std::size_t max_voters, vote_cache_representatives & representatives)
 {
-	auto const representative = vote->account;
+	auto existing = std::find_if (voters.begin (), voters.end (), [representative] (auto const & voter) {
+		return voter.representative == representative;
+	});
 
-	if (auto existing = voters.find (representative); existing != voters.end ())
+	if (existing != voters.end ())
 	{
 		// We already have a vote from this rep
 		// Update timestamp if newer but tally remains unchanged as we already counted this rep weight
 		// It is not essential to keep tally up to date if rep voting weight changes, elections do tally calculations independently, so in the worst case scenario only our queue ordering will be a bit off
 		if (vote->timestamp () > existing->vote->timestamp ())
 		{
-			bool was_final = existing->vote->is_final ();
-			voters.modify (existing, [&vote, &rep_weight] (auto & existing) {
-				existing.vote = vote;
-				existing.weight = rep_weight;
-			});
+			bool was_final = existing->final;
+			existing->vote = vote;
+			existing->weight = rep_weight;
+			existing->final = vote->is_final ();
 			return !was_final && vote->is_final (); // Tally changed only if the vote became final
 		}
 	}
 	else
 	{
+		// First voter with the lowest weight, matches insertion order for voters with equal weight
+		auto lowest_weight = [this] () {
+			release_assert (!voters.empty ());
+			return std::min_element (voters.begin (), voters.end (), [] (auto const & lhs, auto const & rhs) {
+				return lhs.weight < rhs.weight;
+			});
+		};
+
 		auto should_add = [&, this] () {
 			if (voters.size () < max_voters)
 			{
@@ -56,22 +133,22 @@ bool nano::vote_cache_entry::vote_impl (std::shared_ptr<nano::vote> const & vote
 			}
 			else
 			{
-				release_assert (!voters.empty ());
-				auto const & min_weight = voters.get<tag_weight> ().begin ()->weight;
-				return rep_weight > min_weight;
+				return rep_weight > lowest_weight ()->weight;
 			}
 		};
 
 		// Vote from a new representative, add it to the list and update tally
 		if (should_add ())
 		{
-			voters.insert ({ representative, rep_weight, vote });
+			representatives.acquire (representative);
+			voters.push_back ({ vote, rep_weight, representative, vote->is_final () });
 
 			// If we have reached the maximum number of voters, remove the lowest weight voter
 			if (voters.size () >= max_voters)
 			{
-				release_assert (!voters.empty ());
-				voters.get<tag_weight> ().erase (voters.get<tag_weight> ().begin ());
+				auto lowest = lowest_weight ();
+				representatives.release (lowest->representative);
+				voters.erase (lowest);
 			}
 
 			return true;
@@ -80,18 +157,31 @@ bool nano::vote_cache_entry::vote_impl (std::shared_ptr<nano::vote> const & vote
 	return false; // Tally unchanged
 }
 
+void nano::vote_cache_entry::release (vote_cache_representatives & representatives) const
+{
+	for (auto const & voter : voters)
+	{
+		representatives.release (voter.representative);
+	}
+}
+
 std::size_t nano::vote_cache_entry::size () const
 {
 	return voters.size ();
 }
 
+std::size_t nano::vote_cache_entry::voters_allocated () const
+{
+	return voters.capacity () > inline_voters ? voters.capacity () : 0;
+}
+
 auto nano::vote_cache_entry::calculate_tally () const -> std::pair<nano::uint128_t, nano::uint128_t>
 {
 	nano::uint128_t tally{ 0 }, final_tally{ 0 };
 	for (auto const & voter : voters)
 	{
 		tally += voter.weight;
-		final_tally += voter.vote->is_final () ? voter.weight : 0;
+		final_tally += voter.final ? voter.weight : 0;
 	}
 	return { tally, final_tally };
 }
@@ -122,6 +212,9 @@ void nano::vote_cache::insert (std::shared_ptr<nano::vote> const & vote, std::un
 
 	nano::lock_guard<nano::mutex> lock{ mutex };
 
+	// Hold a reference while inserting so the id stays valid even when no entry ends up keeping this voter
+	auto const representative_id = representatives.acquire (representative);
+
 	// Cache votes with a corresponding active election (indicated by `vote_code::vote`) in case that election gets dropped
 	auto filter = [] (auto code) {
 		return code == nano::vote_code::vote || code == nano::vote_code::indeterminate;
@@ -132,7 +225,7 @@ void nano::vote_cache::insert (std::shared_ptr<nano::vote> const & vote, std::un
 	{
 		for (auto const & hash : vote->hashes)
 		{
-			insert_impl (vote, hash, rep_weight);
+			insert_impl (vote, hash, representative_id, rep_weight);
 		}
 	}
 	else
@@ -141,13 +234,15 @@ void nano::vote_cache::insert (std::shared_ptr<nano::vote> const & vote, std::un
 		{
 			if (filter (code))
 			{
-				insert_impl (vote, hash, rep_weight);
+				insert_impl (vote, hash, representative_id, rep_weight);
 			}
 		}
 	}
+
+	representatives.release (representative_id);
 }
 
-void nano::vote_cache::insert_impl (std::shared_ptr<nano::vote> const & vote, nano::block_hash const & hash, nano::uint128_t const & rep_weight)
+void nano::vote_cache::insert_impl (std::shared_ptr<nano::vote> const & vote, nano::block_hash const & hash, vote_cache_representatives::id_t representative, nano::uint128_t const & rep_weight)
 {
 	debug_assert (!mutex.try_lock ());
 	debug_assert (std::any_of (vote->hashes.begin (), vote->hashes.end (), [&hash] (auto const & vote_hash) { return vote_hash == hash; }));
@@ -156,8 +251,8 @@ void nano::vote_cache::insert_impl (std::shared_ptr<nano::vote> const & vote, na
 	{
 		stats.inc (nano::stat::type::vote_cache, nano::stat::detail::update);
 
-		cache.modify (existing, [this, &vote, &rep_weight] (entry & ent) {
-			ent.vote (vote, rep_weight, config.max_voters);
+		cache.modify (existing, [this, &vote, representative, &rep_weight] (entry & ent) {
+			ent.vote (vote, representative, rep_weight, config.max_voters, representatives);
 		});
 	}
 	else
@@ -165,13 +260,15 @@ void nano::vote_cache::insert_impl (std::shared_ptr<nano::vote> const & vote, na
 		stats.inc (nano::stat::type::vote_cache, nano::stat::detail::insert);
 
 		entry cache_entry{ hash };
-		cache_entry.vote (vote, rep_weight, config.max_voters);
-		cache.insert (cache_entry);
+		cache_entry.vote (vote, representative, rep_weight, config.max_voters, representatives);
+		cache.insert (std::move (cache_entry));
 
 		// Remove the oldest entry if we have reached the capacity limit
 		if (cache.size () > config.max_size)
 		{
-			cache.get<tag_sequenced> ().pop_front ();
+			auto & cache_by_sequence = cache.get<tag_sequenced> ();
+			cache_by_sequence.front ().release (representatives);
+			cache_by_sequence.pop_front ();
 		}
 	}
 }
@@ -208,6 +305,7 @@ bool nano::vote_cache::erase (const nano::block_hash & hash)
 	auto & cache_by_hash = cache.get<tag_hash> ();
 	if (auto existing = cache_by_hash.find (hash); existing != cache_by_hash.end ())
 	{
+		existing->release (representatives);
 		cache_by_hash.erase (existing);
 		result = true;
 	}
@@ -218,6 +316,7 @@ void nano::vote_cache::clear ()
 {
 	nano::lock_guard<nano::mutex> lock{ mutex };
 	cache.clear ();
+	representatives.clear ();
 }
 
 std::deque<nano::vote_cache::top_entry> nano::vote_cache::top (const nano::uint128_t & min_tally)
@@ -267,8 +366,13 @@ void nano::vote_cache::cleanup ()
 
 	auto const cutoff = std::chrono::steady_clock::now () - config.age_cutoff;
 
-	erase_if (cache, [cutoff] (auto const & entry) {
-		return entry.last_vote () < cutoff;
+	erase_if (cache, [this, cutoff] (auto const & entry) {
+		if (entry.last_vote () < cutoff)
+		{
+			entry.release (representatives);
+			return true;
+		}
+		return false;
 	});
 }
 
@@ -276,8 +380,17 @@ nano::container_info nano::vote_cache::container_info () const
 {
 	nano::lock_guard<nano::mutex> guard{ mutex };
 
+	// Voters beyond the inline capacity of an entry live in a separate allocation
+	std::size_t voters_allocated = 0;
+	for (auto const & entry : cache)
+	{
+		voters_allocated += entry.voters_allocated ();
+	}
+
 	nano::container_info info;
 	info.put ("cache", cache);
+	info.put<entry::voter_entry> ("voters", voters_allocated);
+	info.add ("representatives", representatives.container_info ());
 	return info;
 }
 
@@ -6,6 +6,7 @@
 #include <nano/lib/utility.hpp>
 #include <nano/secure/common.hpp>
 
+#include <boost/container/small_vector.hpp>
 #include <boost/multi_index/hashed_index.hpp>
 #include <boost/multi_index/mem_fun.hpp>
 #include <boost/multi_index/member.hpp>
@@ -16,6 +17,7 @@
 #include <functional>
 #include <memory>
 #include <optional>
+#include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
@@ -45,30 +47,72 @@ public:
 	std::chrono::seconds age_cutoff{ 15 * 60 };
 };
 
+/**
+ * Interns representative accounts as small integer ids so cache entries do not need to store a full account per voter
+ * Ids are reference counted and recycled once no entry refers to them anymore
+ */
+class vote_cache_representatives final
+{
+public:
+	using id_t = uint32_t;
+
+	/** Returns id for the account, allocating a new one if needed, and takes a reference to it */
+	id_t acquire (nano::account const &);
+	/** Takes an additional reference to an already acquired id */
+	void acquire (id_t);
+	void release (id_t);
+	void clear ();
+
+	std::size_t size () const;
+	nano::container_info container_info () const;
+
+private:
+	struct slot
+	{
+		nano::account account;
+		uint32_t references;
+	};
+
+	std::unordered_map<nano::account, id_t> ids;
+	std::vector<slot> slots;
+	std::vector<id_t> free_ids;
+};
+
 /**
  * Stores votes associated with a single block hash
  */
 class vote_cache_entry final
 {
-private:
+public:
 	struct voter_entry
 	{
-		nano::account representative;
-		nano::uint128_t weight;
 		std::shared_ptr<nano::vote> vote;
+		nano::uint128_t weight;
+		vote_cache_representatives::id_t representative;
+		bool final;
 	};
 
+	/** Most hashes are only voted on by a handful of representatives before an election starts, keep those voters inline */
+	static std::size_t constexpr inline_voters = 2;
+
 public:
 	explicit vote_cache_entry (nano::block_hash const & hash);
 
 	/**
 	 * Adds a vote into a list, checks for duplicates and updates timestamp if new one is greater
+	 * References to representative ids are taken for added voters and released for evicted ones
 	 * @return true if current tally changed, false otherwise
 	 */
-	bool vote (std::shared_ptr<nano::vote> const & vote, nano::uint128_t const & rep_weight, std::size_t max_voters);
+	bool vote (std::shared_ptr<nano::vote> const & vote, vote_cache_representatives::id_t representative, nano::uint128_t const & rep_weight, std::size_t max_voters, vote_cache_representatives &);
+	/**
+	 * Releases representative ids held by this entry, must be called before the entry is discarded
+	 */
+	void release (vote_cache_representatives &) const;
 
 	std::size_t size () const;
 	std::vector<std::shared_ptr<nano::vote>> votes () const;
+	/** Number of voters stored outside of the entry itself */
+	std::size_t voters_allocated () const;
 
 public: // Keep accessors inlined
 	nano::block_hash hash () const
@@ -89,29 +133,15 @@ public: // Keep accessors inlined
 	}
 
 private:
-	bool vote_impl (std::shared_ptr<nano::vote> const & vote, nano::uint128_t const & rep_weight, std::size_t max_voters);
+	bool vote_impl (std::shared_ptr<nano::vote> const & vote, vote_cache_representatives::id_t representative, nano::uint128_t const & rep_weight, std::size_t max_voters, vote_cache_representatives &);
 	std::pair<nano::uint128_t, nano::uint128_t> calculate_tally () const; // <tally, final_tally>
 
-	// clang-format off
-	class tag_representative {};
-	class tag_weight {};
-	// clang-format on
-
-	// clang-format off
-	using ordered_voters = boost::multi_index_container<voter_entry,
-	mi::indexed_by<
-		mi::hashed_unique<mi::tag<tag_representative>,
-			mi::member<voter_entry, nano::account, &voter_entry::representative>>,
-		mi::ordered_non_unique<mi::tag<tag_weight>,
-			mi::member<voter_entry, nano::uint128_t, &voter_entry::weight>>
-	>>;
-	// clang-format on
-	ordered_voters voters;
-
-	nano::block_hash const hash_m;
-	std::chrono::steady_clock::time_point last_vote_m{};
+	// Ordered by alignment to avoid padding, voters are kept in insertion order
 	nano::uint128_t tally_m{ 0 };
 	nano::uint128_t final_tally_m{ 0 };
+	nano::block_hash const hash_m;
+	std::chrono::steady_clock::time_point last_vote_m{};
+	boost::container::small_vector<voter_entry, inline_voters> voters;
 };
 
 class vote_cache final
@@ -171,7 +201,7 @@ private: // Dependencies
 	nano::stats & stats;
 
 private:
-	void insert_impl (std::shared_ptr<nano::vote> const &, nano::block_hash const & hash, nano::uint128_t const & rep_weight);
+	void insert_impl (std::shared_ptr<nano::vote> const &, nano::block_hash const & hash, vote_cache_representatives::id_t representative, nano::uint128_t const & rep_weight);
 	void cleanup ();
 
 	// clang-format off
@@ -191,6 +221,7 @@ private:
 	>>;
 	// clang-format on
 	ordered_cache cache;
+	vote_cache_representatives representatives;
 
 	mutable nano::mutex mutex;
 	nano::interval cleanup_interval;
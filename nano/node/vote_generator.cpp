@@ -1,5 +1,6 @@
 #include <nano/lib/blocks.hpp>
 #include <nano/lib/stats.hpp>
+#include <nano/lib/thread_pool.hpp>
 #include <nano/lib/utility.hpp>
 #include <nano/node/local_vote_history.hpp>
 #include <nano/node/network.hpp>
@@ -15,7 +16,7 @@
 
 #include <chrono>
 
-nano::vote_generator::vote_generator (nano::node_config const & config_a, nano::node & node_a, nano::ledger & ledger_a, nano::wallets & wallets_a, nano::vote_processor & vote_processor_a, nano::local_vote_history & history_a, nano::network & network_a, nano::stats & stats_a, nano::logger & logger_a, bool is_final_a) :
+nano::vote_generator::vote_generator (nano::node_config const & config_a, nano::node & node_a, nano::ledger & ledger_a, nano::wallets & wallets_a, nano::vote_processor & vote_processor_a, nano::local_vote_history & history_a, nano::network & network_a, nano::thread_pool & signing_workers_a, nano::stats & stats_a, nano::logger & logger_a, bool is_final_a) :
 	config (config_a),
 	node (node_a),
 	ledger (ledger_a),
@@ -25,6 +26,7 @@ nano::vote_generator::vote_generator (nano::node_config const & config_a, nano::
 	spacing_impl{ std::make_unique<nano::vote_spacing> (config_a.network_params.voting.delay) },
 	spacing{ *spacing_impl },
 	network (network_a),
+	signing_workers (signing_workers_a),
 	stats (stats_a),
 	logger (logger_a),
 	is_final (is_final_a),
@@ -44,25 +46,15 @@ nano::vote_generator::~vote_generator ()
 
 bool nano::vote_generator::should_vote (transaction_variant_t const & transaction_variant, nano::root const & root_a, nano::block_hash const & hash_a) const
 {
-	bool should_vote = false;
-	std::shared_ptr<nano::block> block;
 	if (is_final)
 	{
 		debug_assert (std::holds_alternative<nano::secure::write_transaction> (transaction_variant));
-		auto const & transaction = std::get<nano::secure::write_transaction> (transaction_variant);
-
-		block = ledger.any.block_get (transaction, hash_a);
-		should_vote = block != nullptr && ledger.dependents_confirmed (transaction, *block) && ledger.store.final_vote.put (transaction, block->qualified_root (), hash_a);
-		debug_assert (block == nullptr || root_a == block->root ());
+		return should_vote_final (std::get<nano::secure::write_transaction> (transaction_variant), root_a, hash_a);
 	}
-	else
-	{
-		debug_assert (std::holds_alternative<nano::secure::read_transaction> (transaction_variant));
-		auto const & transaction = std::get<nano::secure::read_transaction> (transaction_variant);
 
-		block = ledger.any.block_get (transaction, hash_a);
-		should_vote = block != nullptr && ledger.dependents_confirmed (transaction, *block);
-	}
+	debug_assert (std::holds_alternative<nano::secure::read_transaction> (transaction_variant));
+	auto block = votable_block (std::get<nano::secure::read_transaction> (transaction_variant), root_a, hash_a);
+	bool const should_vote = block != nullptr;
 
 	logger.trace (nano::log::type::vote_generator, nano::log::detail::should_vote,
 	nano::log::arg{ "should_vote", should_vote },
@@ -72,6 +64,32 @@ bool nano::vote_generator::should_vote (transaction_variant_t const & transactio
 	return should_vote;
 }
 
+bool nano::vote_generator::should_vote_final (nano::secure::write_transaction const & transaction, nano::root const & root_a, nano::block_hash const & hash_a) const
+{
+	debug_assert (is_final);
+
+	auto block = votable_block (transaction, root_a, hash_a);
+	bool const should_vote = block != nullptr && ledger.store.final_vote.put (transaction, block->qualified_root (), hash_a);
+
+	logger.trace (nano::log::type::vote_generator, nano::log::detail::should_vote,
+	nano::log::arg{ "should_vote", should_vote },
+	nano::log::arg{ "block", block },
+	nano::log::arg{ "is_final", is_final });
+
+	return should_vote;
+}
+
+std::shared_ptr<nano::block> nano::vote_generator::votable_block (nano::secure::transaction const & transaction, nano::root const & root_a, nano::block_hash const & hash_a) const
+{
+	auto block = ledger.any.block_get (transaction, hash_a);
+	debug_assert (block == nullptr || root_a == block->root ());
+	if (block != nullptr && ledger.dependents_confirmed (transaction, *block))
+	{
+		return block;
+	}
+	return nullptr;
+}
+
 void nano::vote_generator::start ()
 {
 	debug_assert (!thread.joinable ());
@@ -121,11 +139,19 @@ void nano::vote_generator::process_batch (std::deque<queue_entry_t> & batch)
 		}
 	};
 
-	if (is_final)
+	if (is_final && config.vote_generator_final_read_verification)
 	{
-		transaction_variant_t transaction_variant{ ledger.tx_begin_write (nano::store::writer::voting_final) };
-		verify_batch (transaction_variant, batch);
-		// Commit write transaction
+		verified = process_final_batch (batch);
+	}
+	else if (is_final)
+	{
+		auto const write_start = std::chrono::steady_clock::now ();
+		{
+			transaction_variant_t transaction_variant{ ledger.tx_begin_write (nano::store::writer::voting_final) };
+			verify_batch (transaction_variant, batch);
+			// Commit write transaction
+		}
+		stats.sample (nano::stat::sample::vote_generator_final_write_duration, nano::log::milliseconds_delta (write_start), { 0, 1000 });
 	}
 	else
 	{
@@ -146,6 +172,66 @@ void nano::vote_generator::process_batch (std::deque<queue_entry_t> & batch)
 	}
 }
 
+auto nano::vote_generator::process_final_batch (std::deque<queue_entry_t> const & batch) -> std::deque<candidate_t>
+{
+	auto const verified = verify_final (batch);
+	if (verified.empty ())
+	{
+		return {};
+	}
+	return store_final (verified);
+}
+
+auto nano::vote_generator::verify_final (std::deque<queue_entry_t> const & batch) -> std::deque<std::pair<nano::qualified_root, nano::block_hash>>
+{
+	// Candidates are verified under a read transaction so the block processor and cementing aren't stalled on the write queue
+	std::deque<std::pair<nano::qualified_root, nano::block_hash>> verified;
+	auto const verify_start = std::chrono::steady_clock::now ();
+	{
+		auto transaction = ledger.tx_begin_read ();
+		for (auto const & [root, hash] : batch)
+		{
+			transaction.refresh_if_needed ();
+
+			if (auto block = votable_block (transaction, root, hash))
+			{
+				verified.emplace_back (block->qualified_root (), hash);
+			}
+		}
+	}
+	stats.sample (nano::stat::sample::vote_generator_final_verify_duration, nano::log::milliseconds_delta (verify_start), { 0, 1000 });
+	return verified;
+}
+
+auto nano::vote_generator::store_final (std::deque<std::pair<nano::qualified_root, nano::block_hash>> const & verified) -> std::deque<candidate_t>
+{
+	std::deque<candidate_t> result;
+	auto const write_start = std::chrono::steady_clock::now ();
+	{
+		auto transaction = ledger.tx_begin_write (nano::store::writer::voting_final);
+		for (auto const & [qualified_root, hash] : verified)
+		{
+			// Block might have been rolled back or a final vote for a competing block stored in the meantime
+			auto const should_vote = ledger.any.block_exists (transaction, hash) && ledger.store.final_vote.put (transaction, qualified_root, hash);
+			if (should_vote)
+			{
+				result.emplace_back (qualified_root.root (), hash);
+			}
+			else
+			{
+				stats.inc (nano::stat::type::vote_generator, nano::stat::detail::generator_final_conflict);
+			}
+
+			logger.trace (nano::log::type::vote_generator, nano::log::detail::should_vote,
+			nano::log::arg{ "should_vote", should_vote },
+			nano::log::arg{ "hash", hash },
+			nano::log::arg{ "is_final", is_final });
+		}
+	}
+	stats.sample (nano::stat::sample::vote_generator_final_write_duration, nano::log::milliseconds_delta (write_start), { 0, 1000 });
+	return result;
+}
+
 std::size_t nano::vote_generator::generate (std::vector<std::shared_ptr<nano::block>> const & blocks_a, std::shared_ptr<nano::transport::channel> const & channel_a)
 {
 	request_t::first_type req_candidates;
@@ -257,12 +343,11 @@ void nano::vote_generator::reply (nano::unique_lock<nano::mutex> & lock_a, reque
 void nano::vote_generator::vote (std::vector<nano::block_hash> const & hashes_a, std::vector<nano::root> const & roots_a, std::function<void (std::shared_ptr<nano::vote> const &)> const & action_a)
 {
 	debug_assert (hashes_a.size () == roots_a.size ());
-	std::vector<std::shared_ptr<nano::vote>> votes_l;
-	wallets.foreach_representative ([this, &hashes_a, &votes_l] (nano::public_key const & pub_a, nano::raw_key const & prv_a) {
-		auto timestamp = this->is_final ? nano::vote::timestamp_max : nano::milliseconds_since_epoch ();
-		uint8_t duration = this->is_final ? nano::vote::duration_max : /*8192ms*/ 0x9;
-		votes_l.emplace_back (std::make_shared<nano::vote> (pub_a, prv_a, timestamp, duration, hashes_a));
+	std::vector<std::pair<nano::public_key, nano::raw_key>> keys;
+	wallets.foreach_representative ([&keys] (nano::public_key const & pub_a, nano::raw_key const & prv_a) {
+		keys.emplace_back (pub_a, prv_a);
 	});
+	auto votes_l = sign (std::move (keys), hashes_a);
 	for (auto const & vote_l : votes_l)
 	{
 		for (std::size_t i (0), n (hashes_a.size ()); i != n; ++i)
@@ -274,6 +359,80 @@ void nano::vote_generator::vote (std::vector<nano::block_hash> const & hashes_a,
 	}
 }
 
+namespace
+{
+/**
+ * Votes for a single set of hashes, one per representative key
+ * Signed by the generator thread together with any signing workers that pick the batch up before it is done
+ */
+class signing_batch
+{
+public:
+	std::vector<std::pair<nano::public_key, nano::raw_key>> keys;
+	std::vector<nano::block_hash> hashes;
+	uint64_t timestamp;
+	uint8_t duration;
+	std::vector<std::shared_ptr<nano::vote>> votes;
+	std::atomic<std::size_t> worker_signed{ 0 };
+
+	void run (bool worker)
+	{
+		for (auto index = next++; index < keys.size (); index = next++)
+		{
+			if (worker)
+			{
+				++worker_signed;
+			}
+			auto const & [pub, prv] = keys[index];
+			auto vote = std::make_shared<nano::vote> (pub, prv, timestamp, duration, hashes);
+
+			nano::lock_guard<nano::mutex> guard{ mutex };
+			votes[index] = std::move (vote);
+			if (++signed_count == keys.size ())
+			{
+				condition.notify_all ();
+			}
+		}
+	}
+
+	void wait ()
+	{
+		nano::unique_lock<nano::mutex> lock{ mutex };
+		condition.wait (lock, [this] () { return signed_count == keys.size (); });
+	}
+
+private:
+	std::atomic<std::size_t> next{ 0 };
+	std::size_t signed_count{ 0 };
+	nano::mutex mutex;
+	nano::condition_variable condition;
+};
+}
+
+std::vector<std::shared_ptr<nano::vote>> nano::vote_generator::sign (std::vector<std::pair<nano::public_key, nano::raw_key>> keys, std::vector<nano::block_hash> const & hashes_a)
+{
+	auto batch = std::make_shared<signing_batch> ();
+	batch->keys = std::move (keys);
+	batch->hashes = hashes_a;
+	batch->timestamp = is_final ? nano::vote::timestamp_max : nano::milliseconds_since_epoch ();
+	batch->duration = is_final ? nano::vote::duration_max : /*8192ms*/ 0x9;
+	batch->votes.resize (batch->keys.size ());
+
+	// Signing is the bulk of the work, with several local representatives it's shared with the workers
+	// Keys are claimed one at a time, so the batch completes even if no worker gets to it (e.g. when stopping)
+	auto const helpers = std::min<std::size_t> (batch->keys.size () > 0 ? batch->keys.size () - 1 : 0, signing_workers.get_num_threads ());
+	for (std::size_t i = 0; i < helpers; ++i)
+	{
+		signing_workers.push_task ([batch] () {
+			batch->run (/* worker */ true);
+		});
+	}
+	batch->run (/* worker */ false);
+	batch->wait ();
+	stats.add (nano::stat::type::vote_generator, nano::stat::detail::generator_signed_by_worker, batch->worker_signed);
+	return std::move (batch->votes);
+}
+
 void nano::vote_generator::broadcast_action (std::shared_ptr<nano::vote> const & vote_a) const
 {
 	network.flood_vote_pr (vote_a);
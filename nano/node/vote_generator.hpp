@@ -33,7 +33,7 @@ private:
 	std::chrono::steady_clock::time_point next_broadcast = { std::chrono::steady_clock::now () };
 
 public:
-	vote_generator (nano::node_config const &, nano::node &, nano::ledger &, nano::wallets &, nano::vote_processor &, nano::local_vote_history &, nano::network &, nano::stats &, nano::logger &, bool is_final);
+	vote_generator (nano::node_config const &, nano::node &, nano::ledger &, nano::wallets &, nano::vote_processor &, nano::local_vote_history &, nano::network &, nano::thread_pool & signing_workers, nano::stats &, nano::logger &, bool is_final);
 	~vote_generator ();
 
 	/** Queue items for vote generation, or broadcast votes already in cache */
@@ -54,9 +54,20 @@ private:
 	void broadcast (nano::unique_lock<nano::mutex> &);
 	void reply (nano::unique_lock<nano::mutex> &, request_t &&);
 	void vote (std::vector<nano::block_hash> const &, std::vector<nano::root> const &, std::function<void (std::shared_ptr<nano::vote> const &)> const &);
+	/** Signs one vote per representative key, spreading the work over the signing workers when there are several */
+	std::vector<std::shared_ptr<nano::vote>> sign (std::vector<std::pair<nano::public_key, nano::raw_key>> keys, std::vector<nano::block_hash> const &);
 	void broadcast_action (std::shared_ptr<nano::vote> const &) const;
 	void process_batch (std::deque<queue_entry_t> & batch);
+	/** Verifies final vote candidates under a read transaction, then stores the final votes in a short write transaction */
+	std::deque<candidate_t> process_final_batch (std::deque<queue_entry_t> const & batch);
+	std::deque<std::pair<nano::qualified_root, nano::block_hash>> verify_final (std::deque<queue_entry_t> const & batch);
+	/** Only rechecks that verified blocks still exist and have no competing final vote, the expensive checks were done by `verify_final` */
+	std::deque<candidate_t> store_final (std::deque<std::pair<nano::qualified_root, nano::block_hash>> const & verified);
 	bool should_vote (transaction_variant_t const &, nano::root const &, nano::block_hash const &) const;
+	/** Stores the final vote for \p hash if it can be voted for and no competing block has one yet */
+	bool should_vote_final (nano::secure::write_transaction const &, nano::root const &, nano::block_hash const &) const;
+	/** Returns the block if it exists and all its dependencies are confirmed */
+	std::shared_ptr<nano::block> votable_block (nano::secure::transaction const &, nano::root const &, nano::block_hash const &) const;
 	bool broadcast_predicate () const;
 
 private:
@@ -72,6 +83,7 @@ private: // Dependencies
 	std::unique_ptr<nano::vote_spacing> spacing_impl;
 	nano::vote_spacing & spacing;
 	nano::network & network;
+	nano::thread_pool & signing_workers;
 	nano::stats & stats;
 	nano::logger & logger;
 
@@ -88,5 +100,8 @@ private:
 	std::atomic<bool> stopped{ false };
 	std::thread thread;
 	std::shared_ptr<nano::transport::channel> inproc_channel;
+
+	friend class vote_generator_final_race_Test;
+	friend class vote_generator_sign_parallel_Test;
 };
 }
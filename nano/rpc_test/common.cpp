@@ -1,4 +1,7 @@
 #include <nano/rpc_test/common.hpp>
+#include <nano/secure/account_cache.hpp>
+#include <nano/secure/ledger.hpp>
+#include <nano/store/unconfirmed.hpp>
 #include <nano/test_common/system.hpp>
 #include <nano/test_common/testutil.hpp>
 
@@ -20,12 +23,15 @@ std::shared_ptr<nano::node> nano::test::add_ipc_enabled_node (nano::test::system
 	return add_ipc_enabled_node (system, node_config);
 }
 
-void nano::test::reset_confirmation_height (nano::store::component & store, nano::account const & account)
+void nano::test::reset_confirmation_height (nano::ledger & ledger, nano::account const & account)
 {
+	auto & store = ledger.store;
 	auto transaction = store.tx_begin_write ();
 	nano::confirmation_height_info confirmation_height_info;
 	if (!store.confirmation_height.get (transaction, account, confirmation_height_info))
 	{
 		store.confirmation_height.clear (transaction, account);
+		store.unconfirmed.put (transaction, account);
 	}
+	ledger.account_cache.erase (account);
 }
\ No newline at end of file
@@ -4,6 +4,7 @@
 
 namespace nano
 {
+class ledger;
 class node;
 class node_config;
 class node_flags;
@@ -21,6 +22,6 @@ namespace test
 	std::shared_ptr<nano::node> add_ipc_enabled_node (nano::test::system & system, nano::node_config & node_config, nano::node_flags const & node_flags);
 	std::shared_ptr<nano::node> add_ipc_enabled_node (nano::test::system & system, nano::node_config & node_config);
 	std::shared_ptr<nano::node> add_ipc_enabled_node (nano::test::system & system);
-	void reset_confirmation_height (nano::store::component & store, nano::account const & account);
+	void reset_confirmation_height (nano::ledger & ledger, nano::account const & account);
 }
 }
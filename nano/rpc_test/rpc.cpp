@@ -3316,7 +3316,7 @@ TEST (rpc, pending_exists)
 	ASSERT_TRUE (pending_exists ("1"));
 
 	ASSERT_TRUE (pending_exists ("1"));
-	reset_confirmation_height (node->store, block1->account ());
+	reset_confirmation_height (node->ledger, block1->account ());
 	ASSERT_TRUE (pending_exists ("0"));
 	request.put ("include_only_confirmed", "false");
 	ASSERT_TRUE (pending_exists ("1"));
@@ -3421,7 +3421,7 @@ TEST (rpc, wallet_receivable)
 	ASSERT_EQ (sources[block1->hash ()], nano::dev::genesis_key.pub);
 
 	ASSERT_TRUE (check_block_response_count (system, rpc_ctx, request, 1));
-	reset_confirmation_height (system.nodes.front ()->store, block1->account ());
+	reset_confirmation_height (system.nodes.front ()->ledger, block1->account ());
 	ASSERT_TRUE (check_block_response_count (system, rpc_ctx, request, 0));
 	request.put ("include_only_confirmed", "false");
 	ASSERT_TRUE (check_block_response_count (system, rpc_ctx, request, 1));
@@ -6788,6 +6788,8 @@ TEST (rpc, telemetry_all)
 	auto channel = node1->network.find_node_id (node->get_node_id ());
 	ASSERT_TRUE (channel);
 	ASSERT_TIMELY (10s, node1->telemetry.get_telemetry (channel->get_remote_endpoint ()));
+	// Raw metrics are served from the snapshot, which is refreshed in the background
+	ASSERT_TIMELY_EQ (10s, node1->telemetry.snapshot ()->peers.size (), 1);
 
 	boost::property_tree::ptree request;
 	request.put ("action", "telemetry");
@@ -6800,6 +6802,15 @@ TEST (rpc, telemetry_all)
 		ASSERT_TRUE (nano::test::compare_telemetry_data (telemetry_data, node->local_telemetry ()));
 	}
 
+	{
+		boost::property_tree::ptree aggregate_request;
+		aggregate_request.put ("action", "telemetry");
+		aggregate_request.put ("aggregate", "true");
+		auto response (wait_response (system, rpc_ctx, aggregate_request, 10s));
+		ASSERT_EQ (1, response.get<std::size_t> ("peers"));
+		ASSERT_EQ (nano::dev::genesis->hash ().to_string (), response.get<std::string> ("genesis_block"));
+	}
+
 	request.put ("raw", "true");
 	auto response (wait_response (system, rpc_ctx, request, 10s));
 
@@ -0,0 +1,274 @@
+#include <nano/lib/stats.hpp>
+#include <nano/lib/utility.hpp>
+#include <nano/secure/account_cache.hpp>
+#include <nano/secure/transaction.hpp>
+
+nano::account_cache::account_cache (std::size_t max_size_a, nano::stats & stats_a) :
+	max_size{ max_size_a },
+	stats{ stats_a }
+{
+}
+
+bool nano::account_cache::enabled () const
+{
+	return max_size > 0;
+}
+
+auto nano::account_cache::shard_for (nano::account const & account) -> shard &
+{
+	return shards[std::hash<nano::account>{}(account) % shard_count];
+}
+
+auto nano::account_cache::shard_for (nano::block_hash const & hash) -> shard &
+{
+	return shards[std::hash<nano::block_hash>{}(hash) % shard_count];
+}
+
+std::optional<nano::account_info> nano::account_cache::account_get (secure::transaction const & transaction, nano::account const & account)
+{
+	if (!enabled ())
+	{
+		return std::nullopt;
+	}
+	std::optional<nano::account_info> result;
+	{
+		auto & shard = shard_for (account);
+		nano::lock_guard<nano::mutex> guard{ shard.mutex };
+		auto & index = shard.entries.get<tag_account> ();
+		if (auto existing = index.find (account); existing != index.end () && existing->info && existing->generation <= transaction.generation ())
+		{
+			result = existing->info;
+			shard.entries.relocate (shard.entries.end (), shard.entries.project<tag_sequenced> (existing));
+		}
+	}
+	stats.inc (nano::stat::type::account_cache, result ? nano::stat::detail::hit_account : nano::stat::detail::miss_account);
+	return result;
+}
+
+std::optional<nano::confirmation_height_info> nano::account_cache::height_get (secure::transaction const & transaction, nano::account const & account)
+{
+	if (!enabled ())
+	{
+		return std::nullopt;
+	}
+	std::optional<nano::confirmation_height_info> result;
+	{
+		auto & shard = shard_for (account);
+		nano::lock_guard<nano::mutex> guard{ shard.mutex };
+		auto & index = shard.entries.get<tag_account> ();
+		if (auto existing = index.find (account); existing != index.end () && existing->height && existing->generation <= transaction.generation ())
+		{
+			result = existing->height;
+			shard.entries.relocate (shard.entries.end (), shard.entries.project<tag_sequenced> (existing));
+		}
+	}
+	stats.inc (nano::stat::type::account_cache, result ? nano::stat::detail::hit_height : nano::stat::detail::miss_height);
+	return result;
+}
+
+template <class Modify>
+void nano::account_cache::upsert (nano::account const & account, Modify const & modify)
+{
+	if (!enabled ())
+	{
+		return;
+	}
+	// Not visible to readers until the writer commits
+	auto const generation = committed.load () + 1;
+	auto & shard = shard_for (account);
+	nano::lock_guard<nano::mutex> guard{ shard.mutex };
+	auto & index = shard.entries.get<tag_account> ();
+	auto existing = index.find (account);
+	if (existing == index.end ())
+	{
+		existing = index.insert (entry{ account, std::nullopt, std::nullopt, generation }).first;
+	}
+	index.modify (existing, [&] (entry & value) {
+		modify (value);
+		value.generation = generation;
+	});
+	shard.entries.relocate (shard.entries.end (), shard.entries.project<tag_sequenced> (existing));
+
+	// Evict least recently used
+	while (shard.entries.size () > std::max<std::size_t> (max_size / shard_count, 1))
+	{
+		shard.entries.pop_front ();
+		stats.inc (nano::stat::type::account_cache, nano::stat::detail::erase_oldest);
+	}
+}
+
+void nano::account_cache::account_fill (secure::transaction const & transaction, nano::account const & account, nano::account_info const & info)
+{
+	if (auto write_transaction = dynamic_cast<secure::write_transaction const *> (&transaction))
+	{
+		account_put (*write_transaction, account, info);
+	}
+}
+
+void nano::account_cache::height_fill (secure::transaction const & transaction, nano::account const & account, nano::confirmation_height_info const & height)
+{
+	if (auto write_transaction = dynamic_cast<secure::write_transaction const *> (&transaction))
+	{
+		height_put (*write_transaction, account, height);
+	}
+}
+
+void nano::account_cache::account_put (secure::write_transaction const &, nano::account const & account, nano::account_info const & info)
+{
+	upsert (account, [&info] (entry & value) {
+		value.info = info;
+	});
+}
+
+void nano::account_cache::height_put (secure::write_transaction const &, nano::account const & account, nano::confirmation_height_info const & height)
+{
+	upsert (account, [&height] (entry & value) {
+		value.height = height;
+	});
+}
+
+bool nano::account_cache::confirmed_get (secure::transaction const & transaction, nano::block_hash const & hash, bool include_pruned)
+{
+	if (!enabled ())
+	{
+		return false;
+	}
+	bool result = false;
+	{
+		auto & shard = shard_for (hash);
+		nano::lock_guard<nano::mutex> guard{ shard.mutex };
+		auto & index = shard.confirmed.get<tag_hash> ();
+		if (auto existing = index.find (hash); existing != index.end () && (include_pruned || !existing->pruned) && existing->generation <= transaction.generation ())
+		{
+			result = true;
+			shard.confirmed.relocate (shard.confirmed.end (), shard.confirmed.project<tag_sequenced> (existing));
+		}
+	}
+	stats.inc (nano::stat::type::account_cache, result ? nano::stat::detail::hit_confirmed : nano::stat::detail::miss_confirmed);
+	return result;
+}
+
+void nano::account_cache::confirmed_fill (secure::transaction const & transaction, nano::account const & account, nano::block_hash const & hash)
+{
+	if (auto write_transaction = dynamic_cast<secure::write_transaction const *> (&transaction))
+	{
+		confirmed_put (*write_transaction, account, hash);
+	}
+}
+
+void nano::account_cache::confirmed_put (secure::write_transaction const &, nano::account const & account, nano::block_hash const & hash)
+{
+	if (!enabled ())
+	{
+		return;
+	}
+	auto const generation = committed.load () + 1;
+	auto & shard = shard_for (hash);
+	nano::lock_guard<nano::mutex> guard{ shard.mutex };
+	auto & index = shard.confirmed.get<tag_hash> ();
+	auto existing = index.find (hash);
+	if (existing == index.end ())
+	{
+		// Confirmation is final, an entry that is already present doesn't need a newer generation
+		index.insert (confirmed_entry{ hash, account, generation, false });
+
+		while (shard.confirmed.size () > std::max<std::size_t> (max_size / shard_count, 1))
+		{
+			shard.confirmed.pop_front ();
+			stats.inc (nano::stat::type::account_cache, nano::stat::detail::erase_oldest);
+		}
+	}
+	else
+	{
+		shard.confirmed.relocate (shard.confirmed.end (), shard.confirmed.project<tag_sequenced> (existing));
+	}
+}
+
+void nano::account_cache::confirmed_prune (secure::write_transaction const &, nano::block_hash const & hash)
+{
+	if (!enabled ())
+	{
+		return;
+	}
+	auto const generation = committed.load () + 1;
+	auto & shard = shard_for (hash);
+	nano::lock_guard<nano::mutex> guard{ shard.mutex };
+	auto & index = shard.confirmed.get<tag_hash> ();
+	if (auto existing = index.find (hash); existing != index.end ())
+	{
+		// Readers with an older snapshot still see the block, they fall back to the store until the pruning is committed
+		index.modify (existing, [generation] (confirmed_entry & value) {
+			value.pruned = true;
+			value.generation = generation;
+		});
+	}
+}
+
+void nano::account_cache::erase (nano::account const & account)
+{
+	if (!enabled ())
+	{
+		return;
+	}
+	{
+		auto & shard = shard_for (account);
+		nano::lock_guard<nano::mutex> guard{ shard.mutex };
+		shard.entries.get<tag_account> ().erase (account);
+	}
+	// Confirmed blocks are spread over all shards
+	for (auto & shard : shards)
+	{
+		nano::lock_guard<nano::mutex> guard{ shard.mutex };
+		shard.confirmed.get<tag_account> ().erase (account);
+	}
+}
+
+void nano::account_cache::clear ()
+{
+	for (auto & shard : shards)
+	{
+		nano::lock_guard<nano::mutex> guard{ shard.mutex };
+		shard.entries.clear ();
+		shard.confirmed.clear ();
+	}
+}
+
+void nano::account_cache::commit ()
+{
+	committed.fetch_add (1);
+}
+
+uint64_t nano::account_cache::generation () const
+{
+	return committed.load ();
+}
+
+std::atomic<uint64_t> const & nano::account_cache::generation_source () const
+{
+	return committed;
+}
+
+std::size_t nano::account_cache::size () const
+{
+	std::size_t result = 0;
+	for (auto const & shard : shards)
+	{
+		nano::lock_guard<nano::mutex> guard{ shard.mutex };
+		result += shard.entries.size ();
+	}
+	return result;
+}
+
+nano::container_info nano::account_cache::container_info () const
+{
+	std::size_t confirmed_count = 0;
+	for (auto const & shard : shards)
+	{
+		nano::lock_guard<nano::mutex> guard{ shard.mutex };
+		confirmed_count += shard.confirmed.size ();
+	}
+	nano::container_info info;
+	info.put ("entries", size (), sizeof (entry));
+	info.put ("confirmed", confirmed_count, sizeof (confirmed_entry));
+	return info;
+}
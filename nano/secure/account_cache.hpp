@@ -0,0 +1,143 @@
+#pragma once
+
+#include <nano/lib/container_info.hpp>
+#include <nano/lib/locks.hpp>
+#include <nano/lib/numbers.hpp>
+#include <nano/secure/account_info.hpp>
+#include <nano/secure/common.hpp>
+#include <nano/secure/fwd.hpp>
+
+#include <boost/multi_index/hashed_index.hpp>
+#include <boost/multi_index/member.hpp>
+#include <boost/multi_index/sequenced_index.hpp>
+#include <boost/multi_index_container.hpp>
+
+#include <array>
+#include <atomic>
+#include <optional>
+
+namespace mi = boost::multi_index;
+
+namespace nano
+{
+class stats;
+}
+
+namespace nano
+{
+/**
+ * Write-through cache of account_info and confirmation height for recently touched accounts, shared by the ledger and the schedulers
+ * Entries are filled and updated only by the writer holding the ledger write transaction, readers never populate the cache.
+ * Every entry is tagged with the commit generation that makes it visible, a read transaction only uses entries committed before its snapshot
+ * was taken so it never sees state its snapshot doesn't contain.
+ * Hashes of recently confirmed blocks are tracked the same way, so "is this block confirmed" is usually answered without reading the block.
+ * Only positive answers come from the cache, a miss means the store has to be consulted.
+ * A size of 0 disables the cache.
+ * @note This class is thread-safe.
+ */
+class account_cache final
+{
+public:
+	account_cache (std::size_t max_size, nano::stats &);
+
+	bool enabled () const;
+
+	std::optional<nano::account_info> account_get (secure::transaction const &, nano::account const &);
+	std::optional<nano::confirmation_height_info> height_get (secure::transaction const &, nano::account const &);
+
+	/** Records values read from the store, ignored unless called by the writer */
+	void account_fill (secure::transaction const &, nano::account const &, nano::account_info const &);
+	void height_fill (secure::transaction const &, nano::account const &, nano::confirmation_height_info const &);
+
+	void account_put (secure::write_transaction const &, nano::account const &, nano::account_info const &);
+	void height_put (secure::write_transaction const &, nano::account const &, nano::confirmation_height_info const &);
+
+	/** Returns true if the block is known to be confirmed, pruned blocks only count if `include_pruned` is set */
+	bool confirmed_get (secure::transaction const &, nano::block_hash const &, bool include_pruned = false);
+	/** Records a confirmed block read from the store, ignored unless called by the writer */
+	void confirmed_fill (secure::transaction const &, nano::account const &, nano::block_hash const &);
+	void confirmed_put (secure::write_transaction const &, nano::account const &, nano::block_hash const &);
+	/** The block stays confirmed but no longer exists in the ledger */
+	void confirmed_prune (secure::write_transaction const &, nano::block_hash const &);
+
+	/** Removes the account and its confirmed blocks, used when it is rolled back or modified outside of the ledger */
+	void erase (nano::account const &);
+	void clear ();
+
+	/** Called once the writer committed, makes its entries visible to transactions started afterwards */
+	void commit ();
+	/** Generation a read transaction started now is guaranteed to include */
+	uint64_t generation () const;
+	std::atomic<uint64_t> const & generation_source () const;
+
+	std::size_t size () const;
+
+	nano::container_info container_info () const;
+
+private:
+	class entry
+	{
+	public:
+		nano::account account;
+		std::optional<nano::account_info> info;
+		std::optional<nano::confirmation_height_info> height;
+		uint64_t generation;
+	};
+
+	// clang-format off
+	class tag_sequenced {};
+	class tag_account {};
+
+	using ordered_entries = boost::multi_index_container<entry,
+	mi::indexed_by<
+		mi::sequenced<mi::tag<tag_sequenced>>,
+		mi::hashed_unique<mi::tag<tag_account>,
+			mi::member<entry, nano::account, &entry::account>>
+	>>;
+	// clang-format on
+
+	class confirmed_entry
+	{
+	public:
+		nano::block_hash hash;
+		nano::account account;
+		uint64_t generation;
+		bool pruned;
+	};
+
+	// clang-format off
+	class tag_hash {};
+
+	using ordered_confirmed = boost::multi_index_container<confirmed_entry,
+	mi::indexed_by<
+		mi::sequenced<mi::tag<tag_sequenced>>,
+		mi::hashed_unique<mi::tag<tag_hash>,
+			mi::member<confirmed_entry, nano::block_hash, &confirmed_entry::hash>>,
+		mi::hashed_non_unique<mi::tag<tag_account>,
+			mi::member<confirmed_entry, nano::account, &confirmed_entry::account>>
+	>>;
+	// clang-format on
+
+	class shard
+	{
+	public:
+		ordered_entries entries;
+		ordered_confirmed confirmed; // Sharded by block hash, unlike `entries`
+		mutable nano::mutex mutex;
+	};
+
+	static std::size_t constexpr shard_count = 16;
+
+	shard & shard_for (nano::account const &);
+	shard & shard_for (nano::block_hash const &);
+	template <class Modify>
+	void upsert (nano::account const &, Modify const &);
+
+private:
+	std::size_t const max_size;
+	nano::stats & stats;
+
+	std::array<shard, shard_count> shards;
+	std::atomic<uint64_t> committed{ 0 };
+};
+}
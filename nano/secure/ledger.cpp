@@ -5,6 +5,7 @@
 #include <nano/lib/utility.hpp>
 #include <nano/lib/work.hpp>
 #include <nano/node/make_store.hpp>
+#include <nano/secure/account_cache.hpp>
 #include <nano/secure/common.hpp>
 #include <nano/secure/ledger.hpp>
 #include <nano/secure/ledger_set_any.hpp>
@@ -12,6 +13,7 @@
 #include <nano/secure/rep_weights.hpp>
 #include <nano/store/account.hpp>
 #include <nano/store/block.hpp>
+#include <nano/store/bulk_loader.hpp>
 #include <nano/store/component.hpp>
 #include <nano/store/confirmation_height.hpp>
 #include <nano/store/final_vote.hpp>
@@ -20,164 +22,102 @@
 #include <nano/store/pending.hpp>
 #include <nano/store/pruned.hpp>
 #include <nano/store/rep_weight.hpp>
+#include <nano/store/unconfirmed.hpp>
 #include <nano/store/version.hpp>
 
+#include <algorithm>
+#include <functional>
 #include <stack>
+#include <tuple>
+#include <unordered_map>
+#include <unordered_set>
 
 #include <cryptopp/words.h>
 
 namespace
 {
 /**
- * Roll back the visited block
+ * Read-only pass collecting every block that has to be rolled back together with a target block
+ * Account chains are walked from their heads, a send that was already received pulls in the receiving chain down to the receive.
+ * Blocks are ordered as they'd be rolled back one by one, each block is the head of its account when its turn comes.
  */
-class rollback_visitor : public nano::block_visitor
+class rollback_planner
 {
 public:
-	rollback_visitor (nano::secure::write_transaction const & transaction_a, nano::ledger & ledger_a, std::vector<std::shared_ptr<nano::block>> & list_a) :
-		transaction (transaction_a),
-		ledger (ledger_a),
-		list (list_a)
-	{
-	}
-	virtual ~rollback_visitor () = default;
-	void send_block (nano::send_block const & block_a) override
+	class account_entry
 	{
-		auto hash (block_a.hash ());
-		nano::pending_key key (block_a.hashables.destination, hash);
-		auto pending = ledger.store.pending.get (transaction, key);
-		while (!error && !pending.has_value ())
-		{
-			error = ledger.rollback (transaction, ledger.any.account_head (transaction, block_a.hashables.destination), list);
-			pending = ledger.store.pending.get (transaction, key);
-		}
-		if (!error)
-		{
-			auto info = ledger.any.account_get (transaction, pending.value ().source);
-			debug_assert (info);
-			ledger.store.pending.del (transaction, key);
-			ledger.cache.rep_weights.representation_add (transaction, info->representative, pending.value ().amount.number ());
-			nano::account_info new_info (block_a.hashables.previous, info->representative, info->open_block, ledger.any.block_balance (transaction, block_a.hashables.previous).value (), nano::seconds_since_epoch (), info->block_count - 1, nano::epoch::epoch_0);
-			ledger.update_account (transaction, pending.value ().source, *info, new_info);
-			ledger.store.block.del (transaction, hash);
-			ledger.store.block.successor_clear (transaction, block_a.hashables.previous);
-			ledger.stats.inc (nano::stat::type::rollback, nano::stat::detail::send);
-		}
-	}
-	void receive_block (nano::receive_block const & block_a) override
-	{
-		auto hash (block_a.hash ());
-		auto amount = ledger.any.block_amount (transaction, hash).value ().number ();
-		auto destination_account = block_a.account ();
-		// Pending account entry can be incorrect if source block was pruned. But it's not affecting correct ledger processing
-		auto source_account = ledger.any.block_account (transaction, block_a.hashables.source);
-		auto info = ledger.any.account_get (transaction, destination_account);
-		debug_assert (info);
-		ledger.cache.rep_weights.representation_add (transaction, info->representative, 0 - amount);
-		nano::account_info new_info (block_a.hashables.previous, info->representative, info->open_block, ledger.any.block_balance (transaction, block_a.hashables.previous).value (), nano::seconds_since_epoch (), info->block_count - 1, nano::epoch::epoch_0);
-		ledger.update_account (transaction, destination_account, *info, new_info);
-		ledger.store.block.del (transaction, hash);
-		ledger.store.pending.put (transaction, nano::pending_key (destination_account, block_a.hashables.source), { source_account.value_or (0), amount, nano::epoch::epoch_0 });
-		ledger.store.block.successor_clear (transaction, block_a.hashables.previous);
-		ledger.stats.inc (nano::stat::type::rollback, nano::stat::detail::receive);
-	}
-	void open_block (nano::open_block const & block_a) override
-	{
-		auto hash (block_a.hash ());
-		auto amount = ledger.any.block_amount (transaction, hash).value ().number ();
-		auto destination_account = block_a.account ();
-		auto source_account = ledger.any.block_account (transaction, block_a.hashables.source);
-		ledger.cache.rep_weights.representation_add (transaction, block_a.representative_field ().value (), 0 - amount);
-		nano::account_info new_info;
-		ledger.update_account (transaction, destination_account, new_info, new_info);
-		ledger.store.block.del (transaction, hash);
-		ledger.store.pending.put (transaction, nano::pending_key (destination_account, block_a.hashables.source), { source_account.value_or (0), amount, nano::epoch::epoch_0 });
-		ledger.stats.inc (nano::stat::type::rollback, nano::stat::detail::open);
-	}
-	void change_block (nano::change_block const & block_a) override
+	public:
+		nano::account_info info; // Before the rollback
+		nano::block_hash head; // Highest block that is kept, zero if the whole chain is rolled back
+		uint64_t height; // Height of `head`
+		uint64_t confirmed; // Confirmation height, blocks up to this height can't be rolled back
+	};
+
+	rollback_planner (nano::ledger & ledger_a, nano::secure::transaction const & transaction_a) :
+		ledger (ledger_a),
+		transaction (transaction_a)
 	{
-		auto hash (block_a.hash ());
-		auto rep_block (ledger.representative (transaction, block_a.hashables.previous));
-		auto account = block_a.account ();
-		auto info = ledger.any.account_get (transaction, account);
-		debug_assert (info);
-		auto balance = ledger.any.block_balance (transaction, block_a.hashables.previous).value ();
-		auto block = ledger.store.block.get (transaction, rep_block);
-		release_assert (block != nullptr);
-		auto representative = block->representative_field ().value ();
-		ledger.cache.rep_weights.representation_add_dual (transaction, block_a.hashables.representative, 0 - balance.number (), representative, balance.number ());
-		ledger.store.block.del (transaction, hash);
-		nano::account_info new_info (block_a.hashables.previous, representative, info->open_block, info->balance, nano::seconds_since_epoch (), info->block_count - 1, nano::epoch::epoch_0);
-		ledger.update_account (transaction, account, *info, new_info);
-		ledger.store.block.successor_clear (transaction, block_a.hashables.previous);
-		ledger.stats.inc (nano::stat::type::rollback, nano::stat::detail::change);
 	}
-	void state_block (nano::state_block const & block_a) override
-	{
-		auto hash (block_a.hash ());
-		nano::block_hash rep_block_hash (0);
-		if (!block_a.hashables.previous.is_zero ())
-		{
-			rep_block_hash = ledger.representative (transaction, block_a.hashables.previous);
-		}
-		nano::uint128_t balance = ledger.any.block_balance (transaction, block_a.hashables.previous).value_or (0).number ();
-		auto is_send (block_a.hashables.balance < balance);
-		nano::account representative{};
-		if (!rep_block_hash.is_zero ())
-		{
-			// Move existing representation & add in amount delta
-			auto block (ledger.store.block.get (transaction, rep_block_hash));
-			debug_assert (block != nullptr);
-			representative = block->representative_field ().value ();
-			ledger.cache.rep_weights.representation_add_dual (transaction, representative, balance, block_a.hashables.representative, 0 - block_a.hashables.balance.number ());
-		}
-		else
-		{
-			// Add in amount delta only
-			ledger.cache.rep_weights.representation_add (transaction, block_a.hashables.representative, 0 - block_a.hashables.balance.number ());
-		}
 
-		auto info = ledger.any.account_get (transaction, block_a.hashables.account);
-		debug_assert (info);
-
-		if (is_send)
+	/** Rolls back blocks from the head of `account` until and including the first block for which `last` returns true */
+	void roll_back (nano::account const & account, std::function<bool (nano::block const &)> const & last)
+	{
+		// References to unordered_map elements stay valid across the recursive insertions below
+		auto & entry = account_get (account);
+		auto done = false;
+		while (!error && !done)
 		{
-			nano::pending_key key (block_a.hashables.link.as_account (), hash);
-			while (!error && !ledger.any.pending_get (transaction, key))
+			if (entry.head.is_zero () || entry.height <= entry.confirmed)
 			{
-				error = ledger.rollback (transaction, ledger.any.account_head (transaction, block_a.hashables.link.as_account ()), list);
+				error = true;
+				break;
+			}
+			auto block = ledger.any.block_get (transaction, entry.head);
+			release_assert (block != nullptr);
+			auto const hash = block->hash ();
+			done = last (*block);
+			blocks.push_back (block);
+			rolled_back.insert (hash);
+			entry.head = block->previous ();
+			--entry.height;
+			if (block->is_send ())
+			{
+				auto const destination = block->destination ();
+				// Receivable again if the receive is already part of this rollback
+				if (!restored.contains (hash) && !ledger.store.pending.exists (transaction, nano::pending_key{ destination, hash }))
+				{
+					roll_back (destination, [&hash] (nano::block const & block) {
+						return block.is_receive () && block.source () == hash;
+					});
+				}
+			}
+			else if (block->is_receive ())
+			{
+				restored.insert (block->source ());
 			}
-			ledger.store.pending.del (transaction, key);
-			ledger.stats.inc (nano::stat::type::rollback, nano::stat::detail::send);
-		}
-		else if (!block_a.hashables.link.is_zero () && !ledger.is_epoch_link (block_a.hashables.link))
-		{
-			// Pending account entry can be incorrect if source block was pruned. But it's not affecting correct ledger processing
-			auto source_account = ledger.any.block_account (transaction, block_a.hashables.link.as_block_hash ());
-			nano::pending_info pending_info (source_account.value_or (0), block_a.hashables.balance.number () - balance, block_a.sideband ().source_epoch);
-			ledger.store.pending.put (transaction, nano::pending_key (block_a.hashables.account, block_a.hashables.link.as_block_hash ()), pending_info);
-			ledger.stats.inc (nano::stat::type::rollback, nano::stat::detail::receive);
 		}
+	}
 
-		debug_assert (!error);
-		auto previous_version (ledger.version (transaction, block_a.hashables.previous));
-		nano::account_info new_info (block_a.hashables.previous, representative, info->open_block, balance, nano::seconds_since_epoch (), info->block_count - 1, previous_version);
-		ledger.update_account (transaction, block_a.hashables.account, *info, new_info);
-
-		auto previous (ledger.store.block.get (transaction, block_a.hashables.previous));
-		if (previous != nullptr)
-		{
-			ledger.store.block.successor_clear (transaction, block_a.hashables.previous);
-		}
-		else
+	account_entry & account_get (nano::account const & account)
+	{
+		auto existing = accounts.find (account);
+		if (existing == accounts.end ())
 		{
-			ledger.stats.inc (nano::stat::type::rollback, nano::stat::detail::open);
+			auto info = ledger.any.account_get (transaction, account);
+			release_assert (info);
+			auto const confirmed = ledger.confirmation_height (transaction, account).value_or (nano::confirmation_height_info{}).height;
+			existing = accounts.emplace (account, account_entry{ *info, info->head, info->block_count, confirmed }).first;
 		}
-		ledger.store.block.del (transaction, hash);
+		return existing->second;
 	}
-	nano::secure::write_transaction const & transaction;
+
 	nano::ledger & ledger;
-	std::vector<std::shared_ptr<nano::block>> & list;
+	nano::secure::transaction const & transaction;
+
+	std::vector<std::shared_ptr<nano::block>> blocks;
+	std::unordered_map<nano::account, account_entry> accounts;
+	std::unordered_set<nano::block_hash> rolled_back;
+	std::unordered_set<nano::block_hash> restored; // Sources of rolled back receives
 	bool error{ false };
 };
 
@@ -272,7 +212,9 @@ void ledger_processor::state_block_impl (nano::state_block & block_a)
 				nano::amount amount (block_a.hashables.balance);
 				auto is_send (false);
 				auto is_receive (false);
-				auto account_error (ledger.store.account.get (transaction, block_a.hashables.account, info));
+				auto const existing_info = ledger.any.account_get (transaction, block_a.hashables.account);
+				auto account_error (!existing_info);
+				info = existing_info.value_or (info);
 				if (!account_error)
 				{
 					// Account already exists
@@ -383,7 +325,9 @@ void ledger_processor::epoch_block_impl (nano::state_block & block_a)
 			if (result == nano::block_status::progress)
 			{
 				nano::account_info info;
-				auto account_error (ledger.store.account.get (transaction, block_a.hashables.account, info));
+				auto const existing_info = ledger.any.account_get (transaction, block_a.hashables.account);
+				auto account_error (!existing_info);
+				info = existing_info.value_or (info);
 				if (!account_error)
 				{
 					// Account already exists
@@ -711,7 +655,7 @@ void representative_visitor::state_block (nano::state_block const & block_a)
 }
 } // namespace
 
-nano::ledger::ledger (nano::store::component & store_a, nano::stats & stat_a, nano::ledger_constants & constants, nano::generate_cache_flags const & generate_cache_flags_a, nano::uint128_t min_rep_weight_a) :
+nano::ledger::ledger (nano::store::component & store_a, nano::stats & stat_a, nano::ledger_constants & constants, nano::generate_cache_flags const & generate_cache_flags_a, nano::uint128_t min_rep_weight_a, std::size_t account_cache_size_a) :
 	constants{ constants },
 	store{ store_a },
 	cache{ store_a.rep_weight, min_rep_weight_a },
@@ -719,8 +663,10 @@ nano::ledger::ledger (nano::store::component & store_a, nano::stats & stat_a, na
 	check_bootstrap_weights{ true },
 	any_impl{ std::make_unique<ledger_set_any> (*this) },
 	confirmed_impl{ std::make_unique<ledger_set_confirmed> (*this) },
+	account_cache_impl{ std::make_unique<nano::account_cache> (account_cache_size_a, stat_a) },
 	any{ *any_impl },
-	confirmed{ *confirmed_impl }
+	confirmed{ *confirmed_impl },
+	account_cache{ *account_cache_impl }
 {
 	if (!store.init_error ())
 	{
@@ -736,12 +682,14 @@ auto nano::ledger::tx_begin_write (nano::store::writer guard_type) const -> secu
 {
 	auto guard = store.write_queue.wait (guard_type);
 	auto txn = store.tx_begin_write ();
-	return secure::write_transaction{ std::move (txn), std::move (guard) };
+	return secure::write_transaction{ std::move (txn), std::move (guard), [&account_cache = account_cache] () { account_cache.commit (); } };
 }
 
 auto nano::ledger::tx_begin_read () const -> secure::read_transaction
 {
-	return secure::read_transaction{ store.tx_begin_read () };
+	// Sampled before the snapshot is taken, the snapshot includes at least everything committed up to this generation
+	auto const generation = account_cache.generation ();
+	return secure::read_transaction{ store.tx_begin_read (), generation, &account_cache.generation_source () };
 }
 
 void nano::ledger::initialize (nano::generate_cache_flags const & generate_cache_flags_a)
@@ -818,6 +766,34 @@ std::deque<std::shared_ptr<nano::block>> nano::ledger::confirm (secure::write_tr
 {
 	std::deque<std::shared_ptr<nano::block>> result;
 
+	// Confirmation height of each account is only written once cementing stops or the transaction is refreshed
+	// Lookups need to take heights which are not yet in the store into account
+	cemented_heights cemented;
+	auto block_confirmed = [&] (nano::block const & block) {
+		if (auto existing = cemented.find (block.account ()); existing != cemented.end ())
+		{
+			return block.sideband ().height <= existing->second.height;
+		}
+		auto info = confirmation_height (transaction, block.account ());
+		return info && block.sideband ().height <= info->height;
+	};
+	auto confirmed_or_pruned = [&] (nano::block_hash const & hash) {
+		if (account_cache.confirmed_get (transaction, hash, true))
+		{
+			return true;
+		}
+		if (auto block = store.block.get (transaction, hash))
+		{
+			auto const result = block_confirmed (*block);
+			if (result)
+			{
+				account_cache.confirmed_put (transaction, block->account (), hash);
+			}
+			return result;
+		}
+		return store.pruned.exists (transaction, hash);
+	};
+
 	std::deque<nano::block_hash> stack;
 	stack.push_back (target_hash);
 	while (!stack.empty ())
@@ -829,7 +805,7 @@ std::deque<std::shared_ptr<nano::block>> nano::ledger::confirm (secure::write_tr
 		auto dependents = dependent_blocks (transaction, *block);
 		for (auto const & dependent : dependents)
 		{
-			if (!dependent.is_zero () && !confirmed.block_exists_or_pruned (transaction, dependent))
+			if (!dependent.is_zero () && !confirmed_or_pruned (dependent))
 			{
 				stats.inc (nano::stat::type::confirmation_height, nano::stat::detail::dependent_unconfirmed);
 
@@ -847,11 +823,11 @@ std::deque<std::shared_ptr<nano::block>> nano::ledger::confirm (secure::write_tr
 		if (stack.back () == hash)
 		{
 			stack.pop_back ();
-			if (!confirmed.block_exists_or_pruned (transaction, hash))
+			if (!block_confirmed (*block))
 			{
 				// We must only confirm blocks that have their dependencies confirmed
-				debug_assert (dependents_confirmed (transaction, *block));
-				confirm_one (transaction, *block);
+				debug_assert (std::all_of (dependents.begin (), dependents.end (), [&] (auto const & dependent) { return dependent.is_zero () || confirmed_or_pruned (dependent); }));
+				confirm_one (transaction, *block, cemented);
 				result.push_back (block);
 			}
 		}
@@ -861,10 +837,12 @@ std::deque<std::shared_ptr<nano::block>> nano::ledger::confirm (secure::write_tr
 		}
 
 		// Refresh the transaction to avoid long-running transactions
+		// Pending heights are written first so that cemented blocks can't be rolled back while the write lock is released
 		// Ensure that the block wasn't rolled back during the refresh
-		bool refreshed = transaction.refresh_if_needed ();
-		if (refreshed)
+		if (transaction.refresh_needed ())
 		{
+			write_cemented (transaction, cemented);
+			transaction.refresh ();
 			if (!any.block_exists (transaction, target_hash))
 			{
 				break; // Block was rolled back during cementing
@@ -878,19 +856,45 @@ std::deque<std::shared_ptr<nano::block>> nano::ledger::confirm (secure::write_tr
 		}
 	}
 
+	write_cemented (transaction, cemented);
 	return result;
 }
 
-void nano::ledger::confirm_one (secure::write_transaction & transaction, nano::block const & block)
+void nano::ledger::confirm_one (secure::write_transaction & transaction, nano::block const & block, cemented_heights & cemented)
 {
-	debug_assert ((!store.confirmation_height.get (transaction, block.account ()) && block.sideband ().height == 1) || store.confirmation_height.get (transaction, block.account ()).value ().height + 1 == block.sideband ().height);
-	confirmation_height_info info{ block.sideband ().height, block.hash () };
-	store.confirmation_height.put (transaction, block.account (), info);
+	auto const account = block.account ();
+	auto existing = cemented.find (account);
+	if (existing == cemented.end ())
+	{
+		debug_assert ((!store.confirmation_height.get (transaction, account) && block.sideband ().height == 1) || store.confirmation_height.get (transaction, account).value ().height + 1 == block.sideband ().height);
+		existing = cemented.emplace (account, nano::confirmation_height_info{}).first;
+	}
+	debug_assert (existing->second.height == 0 || existing->second.height + 1 == block.sideband ().height);
+	existing->second = { block.sideband ().height, block.hash () };
+	account_cache.confirmed_put (transaction, account, block.hash ());
 	++cache.cemented_count;
 
+	// Cementing the head of the chain leaves no unconfirmed blocks in the account
+	if (block.sideband ().successor.is_zero ())
+	{
+		debug_assert (store.account.get (transaction, account).value ().block_count == block.sideband ().height);
+		store.unconfirmed.del (transaction, account);
+	}
+
 	stats.inc (nano::stat::type::confirmation_height, nano::stat::detail::blocks_confirmed);
 }
 
+void nano::ledger::write_cemented (secure::write_transaction & transaction, cemented_heights & cemented)
+{
+	for (auto const & [account, info] : cemented)
+	{
+		store.confirmation_height.put (transaction, account, info);
+		account_cache.height_put (transaction, account, info);
+	}
+	stats.add (nano::stat::type::confirmation_height, nano::stat::detail::height_writes, cemented.size ());
+	cemented.clear ();
+}
+
 nano::block_status nano::ledger::process (secure::write_transaction const & transaction_a, std::shared_ptr<nano::block> block_a)
 {
 	debug_assert (!constants.work.validate_entry (*block_a) || constants.genesis == nano::dev::genesis);
@@ -934,6 +938,20 @@ std::string nano::ledger::block_text (nano::block_hash const & hash_a)
 	return result;
 }
 
+std::optional<nano::confirmation_height_info> nano::ledger::confirmation_height (secure::transaction const & transaction, nano::account const & account) const
+{
+	if (auto cached = account_cache.height_get (transaction, account))
+	{
+		return cached;
+	}
+	auto result = store.confirmation_height.get (transaction, account);
+	if (result)
+	{
+		account_cache.height_fill (transaction, account, *result);
+	}
+	return result;
+}
+
 std::pair<nano::block_hash, nano::block_hash> nano::ledger::hash_root_random (secure::transaction const & transaction_a) const
 {
 	nano::block_hash hash (0);
@@ -989,37 +1007,124 @@ nano::uint128_t nano::ledger::weight_exact (secure::transaction const & txn_a, n
 	return store.rep_weight.get (txn_a, representative_a);
 }
 
-// Rollback blocks until `block_a' doesn't exist or it tries to penetrate the confirmation height
-bool nano::ledger::rollback (secure::write_transaction const & transaction_a, nano::block_hash const & block_a, std::vector<std::shared_ptr<nano::block>> & list_a)
+std::optional<std::vector<std::shared_ptr<nano::block>>> nano::ledger::rollback_dependents (secure::transaction const & transaction, nano::block_hash const & hash)
 {
-	debug_assert (any.block_exists (transaction_a, block_a));
-	auto account_l = any.block_account (transaction_a, block_a).value ();
-	auto block_account_height (any.block_height (transaction_a, block_a));
-	rollback_visitor rollback (transaction_a, *this, list_a);
-	auto error (false);
-	while (!error && any.block_exists (transaction_a, block_a))
+	debug_assert (any.block_exists (transaction, hash));
+	rollback_planner planner{ *this, transaction };
+	planner.roll_back (any.block_account (transaction, hash).value (), [&hash] (nano::block const & block) {
+		return block.hash () == hash;
+	});
+	if (planner.error)
+	{
+		return std::nullopt;
+	}
+	return std::move (planner.blocks);
+}
+
+// Rollback blocks until `hash' doesn't exist, nothing is rolled back if that would penetrate the confirmation height
+bool nano::ledger::rollback (secure::write_transaction const & transaction, nano::block_hash const & hash, std::vector<std::shared_ptr<nano::block>> & list)
+{
+	debug_assert (any.block_exists (transaction, hash));
+	rollback_planner planner{ *this, transaction };
+	planner.roll_back (any.block_account (transaction, hash).value (), [&hash] (nano::block const & block) {
+		return block.hash () == hash;
+	});
+	if (planner.error)
+	{
+		return true; // Error
+	}
+
+	// Everything is read before the first write, changes are then applied per table
+
+	std::vector<std::pair<nano::pending_key, nano::pending_info>> pending_put;
+	std::vector<nano::pending_key> pending_del;
+	for (auto const & block : planner.blocks)
 	{
-		nano::confirmation_height_info confirmation_height_info;
-		store.confirmation_height.get (transaction_a, account_l, confirmation_height_info);
-		if (block_account_height > confirmation_height_info.height)
+		if (block->is_send ())
 		{
-			auto info = any.account_get (transaction_a, account_l);
-			debug_assert (info);
-			auto block_l = any.block_get (transaction_a, info->head);
-			list_a.push_back (block_l);
-			block_l->visit (rollback);
-			error = rollback.error;
-			if (!error)
+			// A send whose receive is rolled back as well leaves no receivable entry behind
+			if (!planner.restored.contains (block->hash ()))
 			{
-				--cache.block_count;
+				pending_del.emplace_back (block->destination (), block->hash ());
 			}
+			stats.inc (nano::stat::type::rollback, nano::stat::detail::send);
 		}
-		else
+		else if (block->is_receive ())
+		{
+			auto const source = block->source ();
+			if (!planner.rolled_back.contains (source))
+			{
+				// Pending account entry can be incorrect if source block was pruned. But it's not affecting correct ledger processing
+				auto const source_account = any.block_account (transaction, source);
+				auto const source_epoch = block->type () == nano::block_type::state ? block->sideband ().source_epoch : nano::epoch::epoch_0;
+				pending_put.emplace_back (nano::pending_key{ block->account (), source }, nano::pending_info{ source_account.value_or (0), any.block_amount (transaction, block).value (), source_epoch });
+			}
+			if (block->type () != nano::block_type::open)
+			{
+				stats.inc (nano::stat::type::rollback, nano::stat::detail::receive);
+			}
+		}
+		else if (block->type () == nano::block_type::change)
+		{
+			stats.inc (nano::stat::type::rollback, nano::stat::detail::change);
+		}
+		if (block->previous ().is_zero ())
 		{
-			error = true;
+			stats.inc (nano::stat::type::rollback, nano::stat::detail::open);
 		}
 	}
-	return error;
+
+	// Each account moves its balance from the representative at the old head to the one at the new head
+	std::vector<std::tuple<nano::account, nano::account_info const &, nano::account_info>> account_updates;
+	std::unordered_map<nano::account, nano::uint128_t> weights;
+	for (auto const & [account, entry] : planner.accounts)
+	{
+		nano::account_info new_info;
+		if (!entry.head.is_zero ())
+		{
+			auto rep_block = store.block.get (transaction, representative (transaction, entry.head));
+			release_assert (rep_block != nullptr);
+			new_info = nano::account_info{ entry.head, rep_block->representative_field ().value (), entry.info.open_block, any.block_balance (transaction, entry.head).value (), nano::seconds_since_epoch (), entry.height, version (transaction, entry.head) };
+			weights[new_info.representative] += new_info.balance.number ();
+		}
+		weights[entry.info.representative] -= entry.info.balance.number ();
+		account_updates.emplace_back (account, entry.info, new_info);
+	}
+
+	for (auto const & block : planner.blocks)
+	{
+		store.block.del (transaction, block->hash ());
+	}
+	for (auto const & [account, entry] : planner.accounts)
+	{
+		if (!entry.head.is_zero ())
+		{
+			store.block.successor_clear (transaction, entry.head);
+		}
+	}
+	for (auto const & key : pending_del)
+	{
+		store.pending.del (transaction, key);
+	}
+	for (auto const & [key, info] : pending_put)
+	{
+		store.pending.put (transaction, key, info);
+	}
+	for (auto const & [account, old_info, new_info] : account_updates)
+	{
+		update_account (transaction, account, old_info, new_info);
+	}
+	for (auto const & [representative, amount] : weights)
+	{
+		if (amount != 0)
+		{
+			cache.rep_weights.representation_add (transaction, representative, amount);
+		}
+	}
+	cache.block_count -= planner.blocks.size ();
+
+	list.insert (list.end (), planner.blocks.begin (), planner.blocks.end ());
+	return false;
 }
 
 bool nano::ledger::rollback (secure::write_transaction const & transaction_a, nano::block_hash const & block_a)
@@ -1148,12 +1253,12 @@ std::shared_ptr<nano::block> nano::ledger::find_receive_block_by_send_hash (secu
 	debug_assert (send_block_hash != 0);
 
 	// get the cemented frontier
-	nano::confirmation_height_info info;
-	if (store.confirmation_height.get (transaction, destination, info))
+	auto info = confirmation_height (transaction, destination);
+	if (!info)
 	{
 		return nullptr;
 	}
-	auto possible_receive_block = any.block_get (transaction, info.frontier);
+	auto possible_receive_block = any.block_get (transaction, info->frontier);
 
 	// walk down the chain until the source field of a receive block matches the send block hash
 	while (possible_receive_block != nullptr)
@@ -1195,11 +1300,30 @@ void nano::ledger::update_account (secure::write_transaction const & transaction
 			store.account.del (transaction_a, account_a);
 		}
 		store.account.put (transaction_a, account_a, new_a);
+		account_cache.account_put (transaction_a, account_a, new_a);
+
+		if (new_a.block_count > old_a.block_count)
+		{
+			// A new block is never confirmed
+			store.unconfirmed.put (transaction_a, account_a);
+		}
+		else if (new_a.block_count < old_a.block_count)
+		{
+			// Rolled back down to the confirmation height, confirmed blocks are never rolled back
+			auto const conf_info = confirmation_height (transaction_a, account_a);
+			debug_assert (!conf_info || conf_info->height <= new_a.block_count);
+			if (conf_info && conf_info->height == new_a.block_count)
+			{
+				store.unconfirmed.del (transaction_a, account_a);
+			}
+		}
 	}
 	else
 	{
 		debug_assert (!store.confirmation_height.exists (transaction_a, account_a));
 		store.account.del (transaction_a, account_a);
+		store.unconfirmed.del (transaction_a, account_a);
+		account_cache.erase (account_a);
 		debug_assert (cache.account_count > 0);
 		--cache.account_count;
 	}
@@ -1238,6 +1362,7 @@ uint64_t nano::ledger::pruning_action (secure::write_transaction & transaction_a
 			release_assert (confirmed.block_exists (transaction_a, hash));
 			store.block.del (transaction_a, hash);
 			store.pruned.put (transaction_a, hash);
+			account_cache.confirmed_prune (transaction_a, hash);
 			hash = block_l->previous ();
 			++pruned_count;
 			++cache.pruned_count;
@@ -1291,21 +1416,20 @@ bool nano::ledger::migrate_lmdb_to_rocksdb (std::filesystem::path const & data_p
 	if (!rocksdb_store->init_error ())
 	{
 		auto table_size = store.count (store.tx_begin_read (), tables::blocks);
-		logger.info (nano::log::type::ledger, "Step 1 of 7: Converting {} entries from blocks table", table_size);
+		logger.info (nano::log::type::ledger, "Step 1 of 8: Converting {} entries from blocks table", table_size);
 		std::atomic<std::size_t> count = 0;
 		store.block.for_each_par (
 		[&] (store::read_transaction const & /*unused*/, auto i, auto n) {
-			auto rocksdb_transaction = rocksdb_store->tx_begin_write ();
+			auto loader = rocksdb_store->make_bulk_loader ();
 			for (; i != n; ++i)
 			{
-				rocksdb_transaction.refresh_if_needed ();
 				std::vector<uint8_t> vector;
 				{
 					nano::vectorstream stream (vector);
 					nano::serialize_block (stream, *i->second.block);
 					i->second.sideband.serialize (stream, i->second.block->type ());
 				}
-				rocksdb_store->block.raw_put (rocksdb_transaction, vector, i->first);
+				loader->block_raw_put (i->first, vector);
 
 				if (auto count_l = ++count; count_l % 5000000 == 0)
 				{
@@ -1316,15 +1440,14 @@ bool nano::ledger::migrate_lmdb_to_rocksdb (std::filesystem::path const & data_p
 		logger.info (nano::log::type::ledger, "{} entries converted ({}%)", count.load (), table_size > 0 ? count.load () * 100 / table_size : 100);
 
 		table_size = store.count (store.tx_begin_read (), tables::pending);
-		logger.info (nano::log::type::ledger, "Step 2 of 7: Converting {} entries from pending table", table_size);
+		logger.info (nano::log::type::ledger, "Step 2 of 8: Converting {} entries from pending table", table_size);
 		count = 0;
 		store.pending.for_each_par (
 		[&] (store::read_transaction const & /*unused*/, auto i, auto n) {
-			auto rocksdb_transaction = rocksdb_store->tx_begin_write ();
+			auto loader = rocksdb_store->make_bulk_loader ();
 			for (; i != n; ++i)
 			{
-				rocksdb_transaction.refresh_if_needed ();
-				rocksdb_store->pending.put (rocksdb_transaction, i->first, i->second);
+				loader->pending_put (i->first, i->second);
 				if (auto count_l = ++count; count_l % 500000 == 0)
 				{
 					logger.info (nano::log::type::ledger, "{} entries converted ({}%)", count_l, count_l * 100 / table_size);
@@ -1334,15 +1457,14 @@ bool nano::ledger::migrate_lmdb_to_rocksdb (std::filesystem::path const & data_p
 		logger.info (nano::log::type::ledger, "{} entries converted ({}%)", count.load (), table_size > 0 ? count.load () * 100 / table_size : 100);
 
 		table_size = store.count (store.tx_begin_read (), tables::confirmation_height);
-		logger.info (nano::log::type::ledger, "Step 3 of 7: Converting {} entries from confirmation_height table", table_size);
+		logger.info (nano::log::type::ledger, "Step 3 of 8: Converting {} entries from confirmation_height table", table_size);
 		count = 0;
 		store.confirmation_height.for_each_par (
 		[&] (store::read_transaction const & /*unused*/, auto i, auto n) {
-			auto rocksdb_transaction = rocksdb_store->tx_begin_write ();
+			auto loader = rocksdb_store->make_bulk_loader ();
 			for (; i != n; ++i)
 			{
-				rocksdb_transaction.refresh_if_needed ();
-				rocksdb_store->confirmation_height.put (rocksdb_transaction, i->first, i->second);
+				loader->confirmation_height_put (i->first, i->second);
 				if (auto count_l = ++count; count_l % 500000 == 0)
 				{
 					logger.info (nano::log::type::ledger, "{} entries converted ({}%)", count_l, count_l * 100 / table_size);
@@ -1352,15 +1474,14 @@ bool nano::ledger::migrate_lmdb_to_rocksdb (std::filesystem::path const & data_p
 		logger.info (nano::log::type::ledger, "{} entries converted ({}%)", count.load (), table_size > 0 ? count.load () * 100 / table_size : 100);
 
 		table_size = store.count (store.tx_begin_read (), tables::accounts);
-		logger.info (nano::log::type::ledger, "Step 4 of 7: Converting {} entries from accounts table", table_size);
+		logger.info (nano::log::type::ledger, "Step 4 of 8: Converting {} entries from accounts table", table_size);
 		count = 0;
 		store.account.for_each_par (
 		[&] (store::read_transaction const & /*unused*/, auto i, auto n) {
-			auto rocksdb_transaction = rocksdb_store->tx_begin_write ();
+			auto loader = rocksdb_store->make_bulk_loader ();
 			for (; i != n; ++i)
 			{
-				rocksdb_transaction.refresh_if_needed ();
-				rocksdb_store->account.put (rocksdb_transaction, i->first, i->second);
+				loader->account_put (i->first, i->second);
 				if (auto count_l = ++count; count_l % 500000 == 0)
 				{
 					logger.info (nano::log::type::ledger, "{} entries converted ({}%)", count_l, count_l * 100 / table_size);
@@ -1370,15 +1491,14 @@ bool nano::ledger::migrate_lmdb_to_rocksdb (std::filesystem::path const & data_p
 		logger.info (nano::log::type::ledger, "{} entries converted ({}%)", count.load (), table_size > 0 ? count.load () * 100 / table_size : 100);
 
 		table_size = store.count (store.tx_begin_read (), tables::rep_weights);
-		logger.info (nano::log::type::ledger, "Step 5 of 7: Converting {} entries from rep_weights table", table_size);
+		logger.info (nano::log::type::ledger, "Step 5 of 8: Converting {} entries from rep_weights table", table_size);
 		count = 0;
 		store.rep_weight.for_each_par (
 		[&] (store::read_transaction const & /*unused*/, auto i, auto n) {
-			auto rocksdb_transaction = rocksdb_store->tx_begin_write ();
+			auto loader = rocksdb_store->make_bulk_loader ();
 			for (; i != n; ++i)
 			{
-				rocksdb_transaction.refresh_if_needed ();
-				rocksdb_store->rep_weight.put (rocksdb_transaction, i->first, i->second.number ());
+				loader->rep_weight_put (i->first, i->second.number ());
 				if (auto count_l = ++count; count_l % 500000 == 0)
 				{
 					logger.info (nano::log::type::ledger, "{} entries converted ({}%)", count_l, count_l * 100 / table_size);
@@ -1388,15 +1508,14 @@ bool nano::ledger::migrate_lmdb_to_rocksdb (std::filesystem::path const & data_p
 		logger.info (nano::log::type::ledger, "{} entries converted ({}%)", count.load (), table_size > 0 ? count.load () * 100 / table_size : 100);
 
 		table_size = store.count (store.tx_begin_read (), tables::pruned);
-		logger.info (nano::log::type::ledger, "Step 6 of 7: Converting {} entries from pruned table", table_size);
+		logger.info (nano::log::type::ledger, "Step 6 of 8: Converting {} entries from pruned table", table_size);
 		count = 0;
 		store.pruned.for_each_par (
 		[&] (store::read_transaction const & /*unused*/, auto i, auto n) {
-			auto rocksdb_transaction = rocksdb_store->tx_begin_write ();
+			auto loader = rocksdb_store->make_bulk_loader ();
 			for (; i != n; ++i)
 			{
-				rocksdb_transaction.refresh_if_needed ();
-				rocksdb_store->pruned.put (rocksdb_transaction, i->first);
+				loader->pruned_put (i->first);
 				if (auto count_l = ++count; count_l % 500000 == 0)
 				{
 					logger.info (nano::log::type::ledger, "{} entries converted ({}%)", count_l, count_l * 100 / table_size);
@@ -1406,15 +1525,31 @@ bool nano::ledger::migrate_lmdb_to_rocksdb (std::filesystem::path const & data_p
 		logger.info (nano::log::type::ledger, "{} entries converted ({}%)", count.load (), table_size > 0 ? count.load () * 100 / table_size : 100);
 
 		table_size = store.count (store.tx_begin_read (), tables::final_votes);
-		logger.info (nano::log::type::ledger, "Step 7 of 7: Converting {} entries from final_votes table", table_size);
+		logger.info (nano::log::type::ledger, "Step 7 of 8: Converting {} entries from final_votes table", table_size);
 		count = 0;
 		store.final_vote.for_each_par (
 		[&] (store::read_transaction const & /*unused*/, auto i, auto n) {
-			auto rocksdb_transaction = rocksdb_store->tx_begin_write ();
+			auto loader = rocksdb_store->make_bulk_loader ();
+			for (; i != n; ++i)
+			{
+				loader->final_vote_put (i->first, i->second);
+				if (auto count_l = ++count; count_l % 500000 == 0)
+				{
+					logger.info (nano::log::type::ledger, "{} entries converted ({}%)", count_l, count_l * 100 / table_size);
+				}
+			}
+		});
+		logger.info (nano::log::type::ledger, "{} entries converted ({}%)", count.load (), table_size > 0 ? count.load () * 100 / table_size : 100);
+
+		table_size = store.count (store.tx_begin_read (), tables::unconfirmed);
+		logger.info (nano::log::type::ledger, "Step 8 of 8: Converting {} entries from unconfirmed table", table_size);
+		count = 0;
+		store.unconfirmed.for_each_par (
+		[&] (store::read_transaction const & /*unused*/, auto i, auto n) {
+			auto loader = rocksdb_store->make_bulk_loader ();
 			for (; i != n; ++i)
 			{
-				rocksdb_transaction.refresh_if_needed ();
-				rocksdb_store->final_vote.put (rocksdb_transaction, i->first, i->second);
+				loader->unconfirmed_put (i->first);
 				if (auto count_l = ++count; count_l % 500000 == 0)
 				{
 					logger.info (nano::log::type::ledger, "{} entries converted ({}%)", count_l, count_l * 100 / table_size);
@@ -1445,6 +1580,7 @@ bool nano::ledger::migrate_lmdb_to_rocksdb (std::filesystem::path const & data_p
 		error |= store.final_vote.count (lmdb_transaction) != rocksdb_store->final_vote.count (rocksdb_transaction);
 		error |= store.online_weight.count (lmdb_transaction) != rocksdb_store->online_weight.count (rocksdb_transaction);
 		error |= store.rep_weight.count (lmdb_transaction) != rocksdb_store->rep_weight.count (rocksdb_transaction);
+		error |= store.unconfirmed.count (lmdb_transaction) != rocksdb_store->unconfirmed.count (rocksdb_transaction);
 		error |= store.version.get (lmdb_transaction) != rocksdb_store->version.get (rocksdb_transaction);
 
 		// For large tables a random key is used instead and makes sure it exists
@@ -1522,5 +1658,6 @@ nano::container_info nano::ledger::container_info () const
 	nano::container_info info;
 	info.put ("bootstrap_weights", bootstrap_weights);
 	info.add ("rep_weights", cache.rep_weights.container_info ());
+	info.add ("account_cache", account_cache.container_info ());
 	return info;
 }
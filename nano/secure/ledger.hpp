@@ -19,6 +19,7 @@ class component;
 
 namespace nano
 {
+class account_cache;
 class block;
 enum class block_status;
 enum class epoch : uint8_t;
@@ -35,7 +36,7 @@ class ledger final
 	friend class receivable_iterator;
 
 public:
-	ledger (nano::store::component &, nano::stats &, nano::ledger_constants & constants, nano::generate_cache_flags const & = nano::generate_cache_flags{}, nano::uint128_t min_rep_weight_a = 0);
+	ledger (nano::store::component &, nano::stats &, nano::ledger_constants & constants, nano::generate_cache_flags const & = nano::generate_cache_flags{}, nano::uint128_t min_rep_weight_a = 0, std::size_t account_cache_size = 0);
 	~ledger ();
 
 	/** Start read-write transaction */
@@ -60,8 +61,13 @@ public:
 	std::string block_text (nano::block_hash const &);
 	std::pair<nano::block_hash, nano::block_hash> hash_root_random (secure::transaction const &) const;
 	std::optional<nano::pending_info> pending_info (secure::transaction const &, nano::pending_key const & key) const;
+	/** Confirmation height of the account, served from the account cache when possible */
+	std::optional<nano::confirmation_height_info> confirmation_height (secure::transaction const &, nano::account const &) const;
 	std::deque<std::shared_ptr<nano::block>> confirm (secure::write_transaction &, nano::block_hash const & hash, size_t max_blocks = 1024 * 128);
 	nano::block_status process (secure::write_transaction const &, std::shared_ptr<nano::block> block);
+	/** Blocks rolled back together with `hash` in rollback order, nullopt if a confirmed block would have to be rolled back */
+	std::optional<std::vector<std::shared_ptr<nano::block>>> rollback_dependents (secure::transaction const &, nano::block_hash const & hash);
+	/** Rolls back `hash` and all blocks depending on it as one batch, returns true and leaves the ledger unchanged if a confirmed block would be rolled back */
 	bool rollback (secure::write_transaction const &, nano::block_hash const &, std::vector<std::shared_ptr<nano::block>> &);
 	bool rollback (secure::write_transaction const &, nano::block_hash const &);
 	void update_account (secure::write_transaction const &, nano::account const &, nano::account_info const &, nano::account_info const &);
@@ -100,13 +106,18 @@ public:
 
 private:
 	void initialize (nano::generate_cache_flags const &);
-	void confirm_one (secure::write_transaction &, nano::block const & block);
+	// Cemented heights accumulated while confirming, written to the store once per account
+	using cemented_heights = std::unordered_map<nano::account, nano::confirmation_height_info>;
+	void confirm_one (secure::write_transaction &, nano::block const & block, cemented_heights &);
+	void write_cemented (secure::write_transaction &, cemented_heights &);
 
 	std::unique_ptr<ledger_set_any> any_impl;
 	std::unique_ptr<ledger_set_confirmed> confirmed_impl;
+	std::unique_ptr<nano::account_cache> account_cache_impl;
 
 public:
 	ledger_set_any & any;
 	ledger_set_confirmed & confirmed;
+	nano::account_cache & account_cache;
 };
 }
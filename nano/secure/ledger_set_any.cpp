@@ -1,3 +1,4 @@
+#include <nano/secure/account_cache.hpp>
 #include <nano/secure/ledger.hpp>
 #include <nano/secure/ledger_set_any.hpp>
 #include <nano/store/account.hpp>
@@ -32,7 +33,16 @@ auto nano::ledger_set_any::account_end () const -> account_iterator
 
 std::optional<nano::account_info> nano::ledger_set_any::account_get (secure::transaction const & transaction, nano::account const & account) const
 {
-	return ledger.store.account.get (transaction, account);
+	if (auto cached = ledger.account_cache.account_get (transaction, account))
+	{
+		return cached;
+	}
+	auto result = ledger.store.account.get (transaction, account);
+	if (result)
+	{
+		ledger.account_cache.account_fill (transaction, account, *result);
+	}
+	return result;
 }
 
 nano::block_hash nano::ledger_set_any::account_head (secure::transaction const & transaction, nano::account const & account) const
@@ -1,3 +1,4 @@
+#include <nano/secure/account_cache.hpp>
 #include <nano/secure/ledger.hpp>
 #include <nano/secure/ledger_set_confirmed.hpp>
 #include <nano/store/account.hpp>
@@ -23,7 +24,7 @@ std::optional<nano::amount> nano::ledger_set_confirmed::account_balance (secure:
 
 nano::block_hash nano::ledger_set_confirmed::account_head (secure::transaction const & transaction, nano::account const & account) const
 {
-	auto info = ledger.store.confirmation_height.get (transaction, account);
+	auto info = ledger.confirmation_height (transaction, account);
 	if (!info)
 	{
 		return 0;
@@ -59,11 +60,24 @@ std::optional<nano::amount> nano::ledger_set_confirmed::block_balance (secure::t
 
 bool nano::ledger_set_confirmed::block_exists (secure::transaction const & transaction, nano::block_hash const & hash) const
 {
-	return block_get (transaction, hash) != nullptr;
+	if (ledger.account_cache.confirmed_get (transaction, hash))
+	{
+		return true;
+	}
+	auto block = block_get (transaction, hash);
+	if (block)
+	{
+		ledger.account_cache.confirmed_fill (transaction, block->account (), hash);
+	}
+	return block != nullptr;
 }
 
 bool nano::ledger_set_confirmed::block_exists_or_pruned (secure::transaction const & transaction, nano::block_hash const & hash) const
 {
+	if (ledger.account_cache.confirmed_get (transaction, hash, true))
+	{
+		return true;
+	}
 	if (ledger.store.pruned.exists (transaction, hash))
 	{
 		return true;
@@ -78,7 +92,7 @@ std::shared_ptr<nano::block> nano::ledger_set_confirmed::block_get (secure::tran
 	{
 		return nullptr;
 	}
-	auto info = ledger.store.confirmation_height.get (transaction, block->account ());
+	auto info = ledger.confirmation_height (transaction, block->account ());
 	if (!info)
 	{
 		return nullptr;
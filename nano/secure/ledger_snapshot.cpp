@@ -0,0 +1,627 @@
+#include <nano/lib/blocks.hpp>
+#include <nano/lib/logging.hpp>
+#include <nano/lib/stream.hpp>
+#include <nano/lib/thread_pool.hpp>
+#include <nano/secure/account_cache.hpp>
+#include <nano/secure/common.hpp>
+#include <nano/secure/ledger.hpp>
+#include <nano/secure/ledger_snapshot.hpp>
+#include <nano/store/account.hpp>
+#include <nano/store/block.hpp>
+#include <nano/store/bulk_loader.hpp>
+#include <nano/store/component.hpp>
+#include <nano/store/confirmation_height.hpp>
+#include <nano/store/pending.hpp>
+#include <nano/store/pruned.hpp>
+#include <nano/store/rep_weight.hpp>
+
+#include <fstream>
+#include <latch>
+
+namespace
+{
+enum class section : uint8_t
+{
+	end,
+	accounts,
+	confirmation_height,
+	blocks,
+	pending,
+	rep_weights,
+	pruned,
+};
+
+nano::uint256_union digest (std::vector<uint8_t> const & data)
+{
+	nano::uint256_union result;
+	blake2b_state state;
+	blake2b_init (&state, sizeof (result.bytes));
+	blake2b_update (&state, data.data (), data.size ());
+	blake2b_final (&state, result.bytes.data (), sizeof (result.bytes));
+	return result;
+}
+
+void write_bytes (std::ostream & out, std::vector<uint8_t> const & data)
+{
+	out.write (reinterpret_cast<char const *> (data.data ()), data.size ());
+}
+
+/**
+ * Accumulates serialized records of a section and writes them out as digested chunks
+ */
+class chunk_writer final
+{
+public:
+	chunk_writer (std::ostream & out, section type) :
+		out{ out }
+	{
+		std::vector<uint8_t> header;
+		{
+			nano::vectorstream stream{ header };
+			nano::write (stream, type);
+		}
+		write_bytes (out, header);
+	}
+
+	~chunk_writer ()
+	{
+		flush ();
+		// An empty chunk terminates the section
+		write_header (0, 0);
+	}
+
+	void add (std::function<void (nano::stream &)> const & serialize)
+	{
+		{
+			nano::vectorstream stream{ buffer };
+			serialize (stream);
+		}
+		++records;
+		++total;
+		if (buffer.size () >= nano::ledger_snapshot::chunk_size)
+		{
+			flush ();
+		}
+	}
+
+	uint64_t total{ 0 };
+
+private:
+	void flush ()
+	{
+		if (records > 0)
+		{
+			write_header (records, static_cast<uint32_t> (buffer.size ()));
+			std::vector<uint8_t> checksum;
+			{
+				nano::vectorstream stream{ checksum };
+				nano::write (stream, digest (buffer).bytes);
+			}
+			write_bytes (out, checksum);
+			write_bytes (out, buffer);
+			buffer.clear ();
+			records = 0;
+		}
+	}
+
+	void write_header (uint32_t records_a, uint32_t size_a)
+	{
+		std::vector<uint8_t> header;
+		{
+			nano::vectorstream stream{ header };
+			nano::write_big_endian (stream, records_a);
+			nano::write_big_endian (stream, size_a);
+		}
+		write_bytes (out, header);
+	}
+
+	std::ostream & out;
+	std::vector<uint8_t> buffer;
+	uint32_t records{ 0 };
+};
+
+class chunk final
+{
+public:
+	section type;
+	uint32_t records{ 0 };
+	nano::uint256_union checksum;
+	std::vector<uint8_t> data;
+	/** Block hashes computed during verification, only populated for the blocks section */
+	std::vector<nano::block_hash> hashes;
+	bool error{ false };
+};
+
+/** Reads exactly \p size bytes, returns true on error */
+bool read_bytes (std::istream & in, std::vector<uint8_t> & data, size_t size)
+{
+	data.resize (size);
+	in.read (reinterpret_cast<char *> (data.data ()), size);
+	return !in;
+}
+
+/** Reads the next chunk header and payload of \p type. Returns true on error, an empty chunk marks the end of the section */
+bool read_chunk (std::istream & in, section type, chunk & result)
+{
+	std::vector<uint8_t> header;
+	if (read_bytes (in, header, sizeof (uint32_t) * 2))
+	{
+		return true;
+	}
+	uint32_t size{ 0 };
+	try
+	{
+		nano::bufferstream stream{ header.data (), header.size () };
+		nano::read_big_endian (stream, result.records);
+		nano::read_big_endian (stream, size);
+	}
+	catch (std::runtime_error const &)
+	{
+		return true;
+	}
+	result.type = type;
+	if (result.records == 0)
+	{
+		result.data.clear ();
+		return size != 0;
+	}
+	if (size > nano::ledger_snapshot::chunk_size * 2 || read_bytes (in, header, sizeof (result.checksum.bytes)))
+	{
+		return true;
+	}
+	std::copy (header.begin (), header.end (), result.checksum.bytes.begin ());
+	return read_bytes (in, result.data, size);
+}
+
+void write_block (nano::stream & stream, nano::store::block_w_sideband const & block)
+{
+	std::vector<uint8_t> data;
+	{
+		nano::vectorstream raw{ data };
+		nano::serialize_block (raw, *block.block);
+		block.sideband.serialize (raw, block.block->type ());
+	}
+	nano::write_big_endian (stream, static_cast<uint32_t> (data.size ()));
+	nano::write (stream, data);
+}
+
+/** Reads the raw database representation of a block, a block followed by its sideband */
+std::shared_ptr<nano::block> read_block (nano::stream & stream, std::vector<uint8_t> & data)
+{
+	uint32_t size{ 0 };
+	nano::read_big_endian (stream, size);
+	nano::read (stream, data, size);
+	nano::bufferstream raw{ data.data (), data.size () };
+	auto block = nano::deserialize_block (raw);
+	if (block == nullptr)
+	{
+		throw std::runtime_error ("Invalid block");
+	}
+	nano::block_sideband sideband;
+	if (sideband.deserialize (raw, block->type ()) || !nano::at_end (raw))
+	{
+		throw std::runtime_error ("Invalid sideband");
+	}
+	block->sideband_set (sideband);
+	return block;
+}
+
+/** Checks chunk integrity and, for blocks, computes hashes and optionally checks signatures. Sets `chunk.error` on failure */
+void verify (nano::ledger const & ledger, chunk & chunk, bool signatures)
+{
+	if (digest (chunk.data) != chunk.checksum)
+	{
+		chunk.error = true;
+		return;
+	}
+	if (chunk.type != section::blocks)
+	{
+		return;
+	}
+	try
+	{
+		nano::bufferstream stream{ chunk.data.data (), chunk.data.size () };
+		std::vector<uint8_t> data;
+		chunk.hashes.reserve (chunk.records);
+		for (auto i = 0u; i < chunk.records; ++i)
+		{
+			auto block = read_block (stream, data);
+			if (signatures)
+			{
+				auto const & signer = block->is_epoch () ? ledger.epoch_signer (block->link_field ().value ()) : block->account ();
+				if (nano::validate_message (signer, block->hash (), block->block_signature ()))
+				{
+					chunk.error = true;
+					return;
+				}
+			}
+			chunk.hashes.push_back (block->hash ());
+		}
+		chunk.error = !nano::at_end (stream);
+	}
+	catch (std::runtime_error const &)
+	{
+		chunk.error = true;
+	}
+}
+
+/** Parses the records of a verified chunk and, unless \p loader is null, writes them out. Returns true on error */
+bool load_chunk (chunk const & chunk, nano::store::bulk_loader * loader)
+{
+	nano::bufferstream stream{ chunk.data.data (), chunk.data.size () };
+	std::vector<uint8_t> data;
+	for (auto i = 0u; i < chunk.records; ++i)
+	{
+		switch (chunk.type)
+		{
+			case section::accounts:
+			{
+				nano::account account;
+				nano::account_info info;
+				nano::read (stream, account.bytes);
+				if (info.deserialize (stream))
+				{
+					return true;
+				}
+				if (loader)
+				{
+					loader->account_put (account, info);
+				}
+				break;
+			}
+			case section::confirmation_height:
+			{
+				nano::account account;
+				nano::confirmation_height_info info;
+				nano::read (stream, account.bytes);
+				if (info.deserialize (stream))
+				{
+					return true;
+				}
+				if (loader)
+				{
+					loader->confirmation_height_put (account, info);
+				}
+				break;
+			}
+			case section::blocks:
+			{
+				uint32_t size{ 0 };
+				nano::read_big_endian (stream, size);
+				nano::read (stream, data, size);
+				if (loader)
+				{
+					loader->block_raw_put (chunk.hashes[i], data);
+				}
+				break;
+			}
+			case section::pending:
+			{
+				nano::pending_key key;
+				nano::pending_info info;
+				if (key.deserialize (stream) || info.deserialize (stream))
+				{
+					return true;
+				}
+				if (loader)
+				{
+					loader->pending_put (key, info);
+				}
+				break;
+			}
+			case section::rep_weights:
+			{
+				nano::account representative;
+				nano::amount weight;
+				nano::read (stream, representative.bytes);
+				nano::read (stream, weight.bytes);
+				if (loader)
+				{
+					loader->rep_weight_put (representative, weight.number ());
+				}
+				break;
+			}
+			case section::pruned:
+			{
+				nano::block_hash hash;
+				nano::read (stream, hash.bytes);
+				if (loader)
+				{
+					loader->pruned_put (hash);
+				}
+				break;
+			}
+			case section::end:
+				return true;
+		}
+	}
+	return !nano::at_end (stream);
+}
+}
+
+nano::ledger_snapshot::ledger_snapshot (nano::ledger & ledger_a, nano::logger & logger_a, unsigned verification_threads_a) :
+	ledger{ ledger_a },
+	logger{ logger_a },
+	verification_threads{ std::max (verification_threads_a, 1u) }
+{
+}
+
+bool nano::ledger_snapshot::write (std::filesystem::path const & path)
+{
+	std::ofstream out{ path, std::ios::binary | std::ios::trunc };
+	if (!out)
+	{
+		logger.error (nano::log::type::ledger, "Unable to open snapshot file for writing: {}", path.string ());
+		return true;
+	}
+
+	auto & store = ledger.store;
+	// A single read transaction keeps all sections consistent with each other
+	auto transaction = store.tx_begin_read ();
+
+	std::vector<uint8_t> header;
+	{
+		nano::vectorstream stream{ header };
+		nano::write (stream, magic);
+		nano::write (stream, version);
+		nano::write (stream, ledger.constants.genesis->hash ().bytes);
+	}
+	write_bytes (out, header);
+
+	logger.info (nano::log::type::ledger, "Step 1 of 6: Exporting accounts");
+	{
+		chunk_writer writer{ out, section::accounts };
+		for (auto i = store.account.begin (transaction), n = store.account.end (transaction); i != n; ++i)
+		{
+			writer.add ([&] (nano::stream & stream) {
+				nano::account_info const & info = i->second;
+				nano::write (stream, i->first.bytes);
+				nano::write (stream, info.head.bytes);
+				nano::write (stream, info.representative.bytes);
+				nano::write (stream, info.open_block.bytes);
+				nano::write (stream, info.balance.bytes);
+				nano::write (stream, info.modified);
+				nano::write (stream, info.block_count);
+				nano::write (stream, info.epoch_m);
+			});
+		}
+		logger.info (nano::log::type::ledger, "{} accounts exported", writer.total);
+	}
+
+	logger.info (nano::log::type::ledger, "Step 2 of 6: Exporting confirmation heights");
+	{
+		chunk_writer writer{ out, section::confirmation_height };
+		for (auto i = store.confirmation_height.begin (transaction), n = store.confirmation_height.end (transaction); i != n; ++i)
+		{
+			writer.add ([&] (nano::stream & stream) {
+				nano::write (stream, i->first.bytes);
+				i->second.serialize (stream);
+			});
+		}
+		logger.info (nano::log::type::ledger, "{} confirmation heights exported", writer.total);
+	}
+
+	logger.info (nano::log::type::ledger, "Step 3 of 6: Exporting blocks");
+	{
+		chunk_writer writer{ out, section::blocks };
+		for (auto i = store.block.begin (transaction), n = store.block.end (transaction); i != n; ++i)
+		{
+			writer.add ([&] (nano::stream & stream) {
+				write_block (stream, i->second);
+			});
+			if (writer.total % 5000000 == 0)
+			{
+				logger.info (nano::log::type::ledger, "{} blocks exported", writer.total);
+			}
+		}
+		logger.info (nano::log::type::ledger, "{} blocks exported", writer.total);
+	}
+
+	logger.info (nano::log::type::ledger, "Step 4 of 6: Exporting pending entries");
+	{
+		chunk_writer writer{ out, section::pending };
+		for (auto i = store.pending.begin (transaction), n = store.pending.end (transaction); i != n; ++i)
+		{
+			writer.add ([&] (nano::stream & stream) {
+				nano::pending_info const & info = i->second;
+				nano::write (stream, i->first.account.bytes);
+				nano::write (stream, i->first.hash.bytes);
+				nano::write (stream, info.source.bytes);
+				nano::write (stream, info.amount.bytes);
+				nano::write (stream, info.epoch);
+			});
+		}
+		logger.info (nano::log::type::ledger, "{} pending entries exported", writer.total);
+	}
+
+	logger.info (nano::log::type::ledger, "Step 5 of 6: Exporting representative weights");
+	{
+		chunk_writer writer{ out, section::rep_weights };
+		for (auto i = store.rep_weight.begin (transaction), n = store.rep_weight.end (transaction); i != n; ++i)
+		{
+			writer.add ([&] (nano::stream & stream) {
+				nano::write (stream, i->first.bytes);
+				nano::write (stream, i->second.bytes);
+			});
+		}
+		logger.info (nano::log::type::ledger, "{} representative weights exported", writer.total);
+	}
+
+	logger.info (nano::log::type::ledger, "Step 6 of 6: Exporting pruned blocks");
+	{
+		chunk_writer writer{ out, section::pruned };
+		for (auto i = store.pruned.begin (transaction), n = store.pruned.end (transaction); i != n; ++i)
+		{
+			writer.add ([&] (nano::stream & stream) {
+				nano::write (stream, i->first.bytes);
+			});
+		}
+		logger.info (nano::log::type::ledger, "{} pruned blocks exported", writer.total);
+	}
+
+	std::vector<uint8_t> footer;
+	{
+		nano::vectorstream stream{ footer };
+		nano::write (stream, section::end);
+	}
+	write_bytes (out, footer);
+	out.flush ();
+
+	auto error = !out;
+	if (error)
+	{
+		logger.error (nano::log::type::ledger, "Failed writing snapshot file: {}", path.string ());
+	}
+	return error;
+}
+
+bool nano::ledger_snapshot::read (std::filesystem::path const & path)
+{
+	std::ifstream in{ path, std::ios::binary };
+	if (!in)
+	{
+		logger.error (nano::log::type::ledger, "Unable to open snapshot file: {}", path.string ());
+		return true;
+	}
+
+	std::vector<uint8_t> header;
+	if (read_bytes (in, header, magic.size () + sizeof (version) + sizeof (nano::block_hash)))
+	{
+		logger.error (nano::log::type::ledger, "Snapshot file is truncated");
+		return true;
+	}
+	{
+		nano::bufferstream stream{ header.data (), header.size () };
+		std::array<char, 8> magic_l;
+		uint8_t version_l;
+		nano::block_hash genesis_l;
+		nano::read (stream, magic_l);
+		nano::read (stream, version_l);
+		nano::read (stream, genesis_l.bytes);
+		if (magic_l != magic || version_l != version)
+		{
+			logger.error (nano::log::type::ledger, "Not a ledger snapshot or unsupported version: {}", path.string ());
+			return true;
+		}
+		if (genesis_l != ledger.constants.genesis->hash ())
+		{
+			logger.error (nano::log::type::ledger, "Snapshot was created for a different network (genesis: {})", genesis_l.to_string ());
+			return true;
+		}
+	}
+
+	auto & store = ledger.store;
+	{
+		auto transaction = store.tx_begin_read ();
+		if (store.block.count (transaction) > 1 || store.account.count (transaction) > 1)
+		{
+			logger.error (nano::log::type::ledger, "Snapshots can only be imported into an empty ledger");
+			return true;
+		}
+	}
+	// Verify the whole file before touching the ledger, so a corrupted or truncated snapshot leaves it as it was
+	auto const sections = in.tellg ();
+	uint64_t total = 0;
+	if (read_sections (in, nullptr, total))
+	{
+		logger.error (nano::log::type::ledger, "Snapshot is corrupted or truncated: {}", path.string ());
+		return true;
+	}
+	logger.info (nano::log::type::ledger, "Snapshot verified, {} records", total);
+	in.clear ();
+	in.seekg (sections);
+
+	{
+		// Genesis entries are part of the snapshot, start from empty tables so the result matches it exactly
+		auto transaction = store.tx_begin_write ();
+		for (auto table : { nano::tables::accounts, nano::tables::blocks, nano::tables::confirmation_height, nano::tables::pending, nano::tables::rep_weights, nano::tables::pruned, nano::tables::unconfirmed })
+		{
+			store.drop (transaction, table);
+		}
+	}
+
+	// Sections are exported in key order, which lets the loader append to the tables instead of inserting randomly
+	auto loader = store.make_bulk_loader ();
+	auto error = read_sections (in, loader.get (), total);
+	loader->flush ();
+	ledger.account_cache.clear ();
+
+	if (error)
+	{
+		// Only possible if the file changed or became unreadable since it was verified
+		logger.error (nano::log::type::ledger, "Snapshot could not be read back after verification, the ledger is incomplete and must be deleted: {}", path.string ());
+	}
+	else
+	{
+		// The unconfirmed index is derived from accounts and confirmation heights, it isn't part of the snapshot
+		auto transaction = store.tx_begin_write ();
+		store.rebuild_unconfirmed (transaction);
+
+		logger.info (nano::log::type::ledger, "Snapshot import completed, {} records imported", total);
+	}
+	return error;
+}
+
+bool nano::ledger_snapshot::read_sections (std::istream & in, nano::store::bulk_loader * loader, uint64_t & total)
+{
+	// Signatures only need checking once, the second pass still recomputes block hashes and digests
+	bool const signatures = loader == nullptr;
+	nano::thread_pool workers{ verification_threads, nano::thread_role::name::signature_checking };
+
+	auto error = false;
+	total = 0;
+	while (!error)
+	{
+		std::vector<uint8_t> marker;
+		if (read_bytes (in, marker, sizeof (section)) || marker[0] > static_cast<uint8_t> (section::pruned))
+		{
+			error = true;
+			break;
+		}
+		auto type = static_cast<section> (marker[0]);
+		if (type == section::end)
+		{
+			break;
+		}
+		logger.info (nano::log::type::ledger, "{} section {} of 6", loader ? "Importing" : "Verifying", marker[0]);
+
+		// Chunks are verified in parallel in batches, then parsed and written in file order
+		for (auto section_done = false; !section_done && !error;)
+		{
+			std::vector<chunk> batch (verification_threads * 2);
+			size_t count = 0;
+			while (count < batch.size () && !section_done && !error)
+			{
+				error = read_chunk (in, type, batch[count]);
+				section_done = batch[count].records == 0;
+				count += section_done ? 0 : 1;
+			}
+
+			std::latch verified{ static_cast<std::ptrdiff_t> (count) };
+			for (size_t i = 0; i < count; ++i)
+			{
+				workers.push_task ([this, &batch, &verified, signatures, i] () {
+					verify (ledger, batch[i], signatures);
+					verified.count_down ();
+				});
+			}
+			verified.wait ();
+
+			for (size_t i = 0; i < count && !error; ++i)
+			{
+				auto const & chunk = batch[i];
+				try
+				{
+					error = chunk.error || load_chunk (chunk, loader);
+				}
+				catch (std::runtime_error const &)
+				{
+					error = true;
+				}
+				total += chunk.records;
+			}
+			logger.debug (nano::log::type::ledger, "{} records {}", total, loader ? "imported" : "verified");
+		}
+	}
+	return error;
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <nano/lib/numbers.hpp>
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <iosfwd>
+
+namespace nano
+{
+class ledger;
+class logger;
+}
+namespace nano::store
+{
+class bulk_loader;
+}
+
+namespace nano
+{
+/**
+ * Compact, checksummed, streaming dump of the ledger tables used to seed a new node without bootstrapping
+ * The file starts with a header identifying the network, followed by one section per table (accounts, confirmation heights,
+ * blocks with sidebands, pending, representative weights and pruned). Every section is split into chunks, each carrying its own
+ * blake2b digest, so chunks can be verified independently and in parallel while importing.
+ */
+class ledger_snapshot final
+{
+public:
+	ledger_snapshot (nano::ledger &, nano::logger &, unsigned verification_threads);
+
+	/** Writes all ledger tables into \p path. Returns true on error */
+	bool write (std::filesystem::path const & path);
+	/**
+	 * Loads the snapshot from \p path into the ledger, which must be empty apart from the genesis block.
+	 * The whole file, including chunk digests and block signatures, is verified before the ledger is modified.
+	 * Returns true on error
+	 */
+	bool read (std::filesystem::path const & path);
+
+public: // Format
+	static std::array<char, 8> constexpr magic{ 'n', 'a', 'n', 'o', 's', 'n', 'a', 'p' };
+	static uint8_t constexpr version{ 1 };
+	/** Target size of a single chunk, records are never split across chunks */
+	static size_t constexpr chunk_size{ 1024 * 1024 };
+
+private:
+	/** Reads all sections following the header. Only verifies them if \p loader is null, otherwise writes them out. Returns true on error */
+	bool read_sections (std::istream &, nano::store::bulk_loader * loader, uint64_t & total);
+
+private:
+	nano::ledger & ledger;
+	nano::logger & logger;
+	unsigned const verification_threads;
+};
+}
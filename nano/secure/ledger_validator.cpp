@@ -0,0 +1,412 @@
+#include <nano/lib/blocks.hpp>
+#include <nano/lib/work.hpp>
+#include <nano/secure/ledger.hpp>
+#include <nano/secure/ledger_validator.hpp>
+#include <nano/secure/pending_info.hpp>
+#include <nano/store/account.hpp>
+#include <nano/store/block.hpp>
+#include <nano/store/component.hpp>
+#include <nano/store/confirmation_height.hpp>
+#include <nano/store/pending.hpp>
+#include <nano/store/pruned.hpp>
+
+#include <boost/format.hpp>
+
+nano::ledger_validator::ledger_validator (nano::ledger & ledger_a, unsigned threads_a, error_callback on_error_a) :
+	ledger{ ledger_a },
+	threads{ std::max (threads_a, 1u) },
+	on_error{ std::move (on_error_a) }
+{
+}
+
+void nano::ledger_validator::validate_accounts ()
+{
+	ledger.store.account.for_each_par ([this] (store::read_transaction const & transaction, auto i, auto n) {
+		acquire ();
+		signature_batch batch;
+		for (; i != n; ++i)
+		{
+			check_account (transaction, i->first, i->second, batch);
+		}
+		verify (batch);
+		release ();
+	});
+
+	// Every block has to be reachable from exactly one account chain
+	auto transaction = ledger.store.tx_begin_read ();
+	auto block_count = blocks_m.load ();
+	if (ledger.pruning)
+	{
+		block_count += 1; // Add disconnected genesis block
+	}
+	auto const ledger_block_count = ledger.store.block.count (transaction);
+	if (block_count != ledger_block_count)
+	{
+		error (boost::str (boost::format ("Incorrect total block count. Blocks validated %1%. Block count in database: %2%\n") % block_count % ledger_block_count));
+	}
+}
+
+void nano::ledger_validator::validate_pending ()
+{
+	ledger.store.pending.for_each_par ([this] (store::read_transaction const & transaction, auto i, auto n) {
+		acquire ();
+		for (; i != n; ++i)
+		{
+			check_pending (transaction, i->first, i->second);
+		}
+		release ();
+	});
+}
+
+void nano::ledger_validator::check_account (store::transaction const & transaction, nano::account const & account, nano::account_info const & info, signature_batch & batch)
+{
+	auto & store = ledger.store;
+	nano::confirmation_height_info confirmation_height_info;
+	store.confirmation_height.get (transaction, account, confirmation_height_info);
+	if (confirmation_height_info.height > info.block_count)
+	{
+		error (boost::str (boost::format ("Confirmation height %1% greater than block count %2% for account: %3%\n") % confirmation_height_info.height % info.block_count % account.to_account ()));
+	}
+
+	auto hash = info.open_block;
+	nano::block_hash calculated_hash{ 0 };
+	auto block = store.block.get (transaction, hash);
+	uint64_t height = 0;
+	if (ledger.pruning && confirmation_height_info.height != 0)
+	{
+		hash = confirmation_height_info.frontier;
+		block = store.block.get (transaction, hash);
+		// Iteration until pruned block
+		bool pruned_block = false;
+		while (block != nullptr && !pruned_block && !block->previous ().is_zero ())
+		{
+			auto previous_block = store.block.get (transaction, block->previous ());
+			if (previous_block != nullptr)
+			{
+				hash = previous_block->hash ();
+				block = previous_block;
+			}
+			else
+			{
+				pruned_block = true;
+				if (!store.pruned.exists (transaction, block->previous ()))
+				{
+					error (boost::str (boost::format ("Pruned previous block does not exist %1%\n") % block->previous ().to_string ()));
+				}
+			}
+		}
+		if (block != nullptr)
+		{
+			calculated_hash = block->previous ();
+			height = block->sideband ().height - 1;
+		}
+		if (!store.block.exists (transaction, info.open_block) && !store.pruned.exists (transaction, info.open_block))
+		{
+			error (boost::str (boost::format ("Open block does not exist %1%\n") % info.open_block.to_string ()));
+		}
+	}
+	// The balance of the previous block is carried along the walk, it is only unknown when the walk starts after a pruned block
+	std::optional<nano::amount> previous_balance;
+	if (block != nullptr && block->previous ().is_zero ())
+	{
+		previous_balance = nano::amount{ 0 };
+	}
+	uint64_t previous_timestamp = 0;
+	nano::account calculated_representative{};
+	while (!hash.is_zero () && block != nullptr)
+	{
+		++blocks_m;
+		auto const & sideband = block->sideband ();
+		// Check if previous field is correct
+		if (calculated_hash != block->previous ())
+		{
+			error (boost::str (boost::format ("Incorrect previous field for block %1%\n") % hash.to_string ()));
+		}
+		// Check if previous & type for open blocks are correct
+		if (height == 0 && !block->previous ().is_zero ())
+		{
+			error (boost::str (boost::format ("Incorrect previous for open block %1%\n") % hash.to_string ()));
+		}
+		if (height == 0 && block->type () != nano::block_type::open && block->type () != nano::block_type::state)
+		{
+			error (boost::str (boost::format ("Incorrect type for open block %1%\n") % hash.to_string ()));
+		}
+		// Check if block data is correct (calculating hash)
+		calculated_hash = block->hash ();
+		if (calculated_hash != hash)
+		{
+			error (boost::str (boost::format ("Invalid data inside block %1% calculated hash: %2%\n") % hash.to_string () % calculated_hash.to_string ()));
+		}
+		check_block (transaction, account, hash, *block, previous_balance, batch);
+		// Check if sideband height is correct
+		++height;
+		if (sideband.height != height)
+		{
+			error (boost::str (boost::format ("Incorrect sideband height for block %1%. Sideband: %2%. Expected: %3%\n") % hash.to_string () % sideband.height % height));
+		}
+		// Check if sideband timestamp is after previous timestamp
+		if (sideband.timestamp < previous_timestamp)
+		{
+			error (boost::str (boost::format ("Incorrect sideband timestamp for block %1%\n") % hash.to_string ()));
+		}
+		previous_timestamp = sideband.timestamp;
+		previous_balance = block->balance ();
+		// Calculate representative block
+		if (block->type () == nano::block_type::open || block->type () == nano::block_type::change || block->type () == nano::block_type::state)
+		{
+			calculated_representative = block->representative_field ().value ();
+		}
+		// The successor is stored in the sideband, no separate lookup needed
+		hash = sideband.successor;
+		if (!hash.is_zero ())
+		{
+			block = store.block.get (transaction, hash);
+		}
+	}
+	// Check if required block exists
+	if (!hash.is_zero () && block == nullptr)
+	{
+		error (boost::str (boost::format ("Required block in account %1% chain was not found in ledger: %2%\n") % account.to_account () % hash.to_string ()));
+	}
+	// Check account block count
+	if (info.block_count != height)
+	{
+		error (boost::str (boost::format ("Incorrect block count for account %1%. Actual: %2%. Expected: %3%\n") % account.to_account () % height % info.block_count));
+	}
+	// Check account head block (frontier)
+	if (info.head != calculated_hash)
+	{
+		error (boost::str (boost::format ("Incorrect frontier for account %1%. Actual: %2%. Expected: %3%\n") % account.to_account () % calculated_hash.to_string () % info.head.to_string ()));
+	}
+	// Check account representative block
+	if (info.representative != calculated_representative)
+	{
+		error (boost::str (boost::format ("Incorrect representative for account %1%. Actual: %2%. Expected: %3%\n") % account.to_account () % calculated_representative.to_string () % info.representative.to_string ()));
+	}
+	++accounts_m;
+}
+
+void nano::ledger_validator::check_block (store::transaction const & transaction, nano::account const & account, nano::block_hash const & hash, nano::block const & block, std::optional<nano::amount> const & previous_balance, signature_batch & batch)
+{
+	auto & store = ledger.store;
+	auto const & sideband = block.sideband ();
+	// Check for state & open blocks if account field is correct
+	if (block.type () == nano::block_type::open || block.type () == nano::block_type::state)
+	{
+		if (block.account () != account)
+		{
+			error (boost::str (boost::format ("Incorrect account field for block %1%\n") % hash.to_string ()));
+		}
+	}
+	// Check if sideband account is correct
+	else if (sideband.account != account)
+	{
+		error (boost::str (boost::format ("Incorrect sideband account for block %1%\n") % hash.to_string ()));
+	}
+	// Queue the signature, epoch blocks are signed by the epoch signer
+	bool const epoch_link = block.type () == nano::block_type::state && ledger.is_epoch_link (block.link_field ().value ());
+	if (epoch_link && (previous_balance ? block.balance () == previous_balance.value () : sideband.details.is_epoch))
+	{
+		batch.items.push_back ({ hash, ledger.epoch_signer (block.link_field ().value ()), block.block_signature (), account });
+	}
+	else
+	{
+		batch.items.push_back ({ hash, account, block.block_signature (), std::nullopt });
+	}
+	if (batch.items.size () >= signature_batch_size)
+	{
+		verify (batch);
+	}
+	// Validate block details set in the sideband
+	bool block_details_error = false;
+	if (block.type () != nano::block_type::state)
+	{
+		// Not state
+		block_details_error = sideband.details.is_send || sideband.details.is_receive || sideband.details.is_epoch;
+	}
+	else if (previous_balance)
+	{
+		if (block.balance () < previous_balance.value ())
+		{
+			// State send
+			block_details_error = !sideband.details.is_send || sideband.details.is_receive || sideband.details.is_epoch;
+		}
+		else if (block.is_change ())
+		{
+			// State change
+			block_details_error = sideband.details.is_send || sideband.details.is_receive || sideband.details.is_epoch;
+		}
+		else if (block.balance () == previous_balance.value () && epoch_link)
+		{
+			// State epoch
+			block_details_error = !sideband.details.is_epoch || sideband.details.is_send || sideband.details.is_receive;
+		}
+		else
+		{
+			// State receive
+			block_details_error = !sideband.details.is_receive || sideband.details.is_send || sideband.details.is_epoch;
+			block_details_error |= !store.block.exists (transaction, block.source ()) && !(ledger.pruning && store.pruned.exists (transaction, block.source ()));
+		}
+	}
+	else if (!store.pruned.exists (transaction, block.previous ()))
+	{
+		error (boost::str (boost::format ("Previous pruned block does not exist %1%\n") % block.previous ().to_string ()));
+	}
+	if (block_details_error)
+	{
+		error (boost::str (boost::format ("Incorrect sideband block details for block %1%\n") % hash.to_string ()));
+	}
+	// Check that the source epoch matches the epoch of the send block
+	if (sideband.details.is_receive)
+	{
+		if (auto source = store.block.get (transaction, block.source ()); source != nullptr && sideband.source_epoch != nano::ledger::version (*source))
+		{
+			error (boost::str (boost::format ("Incorrect source epoch for block %1%\n") % hash.to_string ()));
+		}
+	}
+	// Check if block work value is correct
+	auto const & work = ledger.constants.work;
+	if (work.difficulty (block) < work.threshold (block.work_version (), sideband.details))
+	{
+		error (boost::str (boost::format ("Invalid work for block %1% value: %2%\n") % hash.to_string () % nano::to_string_hex (block.block_work ())));
+	}
+}
+
+void nano::ledger_validator::check_pending (store::transaction const & transaction, nano::pending_key const & key, nano::pending_info const & info)
+{
+	auto & store = ledger.store;
+	++pending_m;
+	// Check block existence
+	auto block = store.block.get (transaction, key.hash);
+	if (block == nullptr)
+	{
+		if (!ledger.pruning || !store.pruned.exists (transaction, key.hash))
+		{
+			error (boost::str (boost::format ("Pending block does not exist %1%\n") % key.hash.to_string ()));
+		}
+		return;
+	}
+	// Check if pending destination is correct
+	nano::account destination{};
+	if (auto state = dynamic_cast<nano::state_block *> (block.get ()))
+	{
+		if (state->is_send ())
+		{
+			destination = state->hashables.link.as_account ();
+		}
+	}
+	else if (auto send = dynamic_cast<nano::send_block *> (block.get ()))
+	{
+		destination = send->hashables.destination;
+	}
+	else
+	{
+		error (boost::str (boost::format ("Incorrect type for pending block %1%\n") % key.hash.to_string ()));
+	}
+	if (key.account != destination)
+	{
+		error (boost::str (boost::format ("Incorrect destination for pending block %1%\n") % key.hash.to_string ()));
+	}
+	// Check if pending source is correct
+	if (info.source != block->account ())
+	{
+		error (boost::str (boost::format ("Incorrect source for pending block %1%\n") % key.hash.to_string ()));
+	}
+	// Check if pending amount is correct
+	if (ledger.pruning && store.pruned.exists (transaction, block->previous ()))
+	{
+		return;
+	}
+	std::optional<nano::uint128_t> amount;
+	if (block->previous ().is_zero ())
+	{
+		amount = block->balance ().number ();
+	}
+	else if (auto previous = store.block.get (transaction, block->previous ()))
+	{
+		auto const previous_balance = previous->balance ().number ();
+		auto const balance = block->balance ().number ();
+		amount = previous_balance > balance ? previous_balance - balance : balance - previous_balance;
+	}
+	if (!amount || info.amount.number () != amount.value ())
+	{
+		error (boost::str (boost::format ("Incorrect amount for pending block %1%\n") % key.hash.to_string ()));
+	}
+}
+
+void nano::ledger_validator::verify (signature_batch & batch)
+{
+	auto const size = batch.items.size ();
+	if (size == 0)
+	{
+		return;
+	}
+	std::vector<unsigned char const *> messages;
+	std::vector<size_t> lengths (size, sizeof (nano::block_hash));
+	std::vector<unsigned char const *> public_keys;
+	std::vector<unsigned char const *> signatures;
+	std::vector<int> valid (size, 0);
+	messages.reserve (size);
+	public_keys.reserve (size);
+	signatures.reserve (size);
+	for (auto const & item : batch.items)
+	{
+		messages.push_back (item.hash.bytes.data ());
+		public_keys.push_back (item.signer.bytes.data ());
+		signatures.push_back (item.signature.bytes.data ());
+	}
+	if (nano::validate_message_batch (messages.data (), lengths.data (), public_keys.data (), signatures.data (), size, valid.data ()))
+	{
+		for (std::size_t i = 0; i < size; ++i)
+		{
+			auto const & item = batch.items[i];
+			if (valid[i] == 0 && (!item.fallback || nano::validate_message (item.fallback.value (), item.hash, item.signature)))
+			{
+				error (boost::str (boost::format ("Invalid signature for block %1%\n") % item.hash.to_string ()));
+			}
+		}
+	}
+	batch.items.clear ();
+}
+
+void nano::ledger_validator::error (std::string const & message)
+{
+	++errors_m;
+	on_error (message);
+}
+
+void nano::ledger_validator::acquire ()
+{
+	nano::unique_lock<nano::mutex> lock{ mutex };
+	condition.wait (lock, [this] () { return active < threads; });
+	++active;
+}
+
+void nano::ledger_validator::release ()
+{
+	{
+		nano::lock_guard<nano::mutex> lock{ mutex };
+		--active;
+	}
+	condition.notify_one ();
+}
+
+uint64_t nano::ledger_validator::accounts () const
+{
+	return accounts_m;
+}
+
+uint64_t nano::ledger_validator::blocks () const
+{
+	return blocks_m;
+}
+
+uint64_t nano::ledger_validator::pending () const
+{
+	return pending_m;
+}
+
+uint64_t nano::ledger_validator::errors () const
+{
+	return errors_m;
+}
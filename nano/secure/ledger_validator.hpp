@@ -0,0 +1,94 @@
+#pragma once
+
+#include <nano/lib/locks.hpp>
+#include <nano/lib/numbers.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace nano
+{
+class account_info;
+class block;
+class ledger;
+class pending_info;
+class pending_key;
+}
+namespace nano::store
+{
+class transaction;
+}
+
+namespace nano
+{
+/**
+ * Offline consistency check of every account chain and receivable entry, used by the `validate_blocks` command
+ * The account and pending tables are split into key ranges that are walked in parallel through `for_each_par`.
+ * Chains are followed through the sideband successor and previous balances are carried along the walk, so every block is read once.
+ * Signatures are collected per range and verified in batches, only the signatures failing a batch are rechecked individually.
+ */
+class ledger_validator final
+{
+public:
+	using error_callback = std::function<void (std::string const &)>;
+
+	/** @param threads upper bound on the number of key ranges validated at the same time */
+	ledger_validator (nano::ledger &, unsigned threads, error_callback);
+
+	/** Validates all account chains followed by the total block count */
+	void validate_accounts ();
+	/** Validates all receivable entries against their send blocks */
+	void validate_pending ();
+
+	uint64_t accounts () const;
+	uint64_t blocks () const;
+	uint64_t pending () const;
+	uint64_t errors () const;
+
+	static std::size_t constexpr signature_batch_size = 64;
+
+private:
+	class signature_batch
+	{
+	public:
+		class item
+		{
+		public:
+			nano::block_hash hash;
+			nano::account signer;
+			nano::signature signature;
+			std::optional<nano::account> fallback; // Epoch blocks are batched with the epoch signer, the account itself is tried if that fails
+		};
+
+		std::vector<item> items;
+	};
+
+	void check_account (store::transaction const &, nano::account const &, nano::account_info const &, signature_batch &);
+	void check_block (store::transaction const &, nano::account const &, nano::block_hash const &, nano::block const &, std::optional<nano::amount> const & previous_balance, signature_batch &);
+	void check_pending (store::transaction const &, nano::pending_key const &, nano::pending_info const &);
+	void verify (signature_batch &);
+	void error (std::string const &);
+
+	/** Limits the number of ranges processed concurrently to `threads` */
+	void acquire ();
+	void release ();
+
+private:
+	nano::ledger & ledger;
+	unsigned const threads;
+	error_callback const on_error;
+
+	std::atomic<uint64_t> accounts_m{ 0 };
+	std::atomic<uint64_t> blocks_m{ 0 };
+	std::atomic<uint64_t> pending_m{ 0 };
+	std::atomic<uint64_t> errors_m{ 0 };
+
+	unsigned active{ 0 };
+	nano::mutex mutex;
+	nano::condition_variable condition;
+};
+}
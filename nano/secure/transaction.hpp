@@ -3,6 +3,9 @@
 #include <nano/store/transaction.hpp>
 #include <nano/store/write_queue.hpp>
 
+#include <atomic>
+#include <functional>
+#include <limits>
 #include <utility>
 
 namespace nano::secure
@@ -27,22 +30,38 @@ public:
 
 	// Conversion operator to const nano::store::transaction&
 	virtual operator const nano::store::transaction & () const = 0;
+
+	// Newest commit generation guaranteed to be included in this transaction's view of the ledger, see nano::account_cache
+	virtual uint64_t generation () const = 0;
 };
 
 class write_transaction : public transaction
 {
 	nano::store::write_transaction txn;
 	nano::store::write_guard guard;
+	std::function<void ()> committed; // Called after each commit, before the write guard is released
 	std::chrono::steady_clock::time_point start;
 
 public:
-	explicit write_transaction (nano::store::write_transaction && txn, nano::store::write_guard && guard) noexcept :
+	explicit write_transaction (nano::store::write_transaction && txn, nano::store::write_guard && guard, std::function<void ()> committed = nullptr) noexcept :
 		txn{ std::move (txn) },
-		guard{ std::move (guard) }
+		guard{ std::move (guard) },
+		committed{ std::move (committed) }
 	{
 		start = std::chrono::steady_clock::now ();
 	}
 
+	write_transaction (write_transaction &&) noexcept = default;
+
+	~write_transaction ()
+	{
+		// Commit explicitly so the guard is only released once changes are visible to other transactions
+		if (guard.is_owned ())
+		{
+			commit ();
+		}
+	}
+
 	// Override to return a reference to the encapsulated write_transaction
 	const nano::store::transaction & base_txn () const override
 	{
@@ -52,6 +71,10 @@ public:
 	void commit ()
 	{
 		txn.commit ();
+		if (committed)
+		{
+			committed ();
+		}
 		guard.release ();
 	}
 
@@ -68,10 +91,14 @@ public:
 		renew ();
 	}
 
+	bool refresh_needed (std::chrono::milliseconds max_age = std::chrono::milliseconds{ 500 }) const
+	{
+		return std::chrono::steady_clock::now () - start > max_age;
+	}
+
 	bool refresh_if_needed (std::chrono::milliseconds max_age = std::chrono::milliseconds{ 500 })
 	{
-		auto now = std::chrono::steady_clock::now ();
-		if (now - start > max_age)
+		if (refresh_needed (max_age))
 		{
 			refresh ();
 			return true;
@@ -84,6 +111,12 @@ public:
 		return txn.timestamp ();
 	}
 
+	// The single writer sees all committed changes as well as its own
+	uint64_t generation () const override
+	{
+		return std::numeric_limits<uint64_t>::max ();
+	}
+
 	// Conversion operator to const nano::store::transaction&
 	operator const nano::store::transaction & () const override
 	{
@@ -100,10 +133,14 @@ public:
 class read_transaction : public transaction
 {
 	nano::store::read_transaction txn;
+	std::atomic<uint64_t> const * generation_source; // Sampled before the snapshot is taken
+	uint64_t generation_m;
 
 public:
-	explicit read_transaction (nano::store::read_transaction && t) noexcept :
-		txn{ std::move (t) }
+	explicit read_transaction (nano::store::read_transaction && t, uint64_t generation = 0, std::atomic<uint64_t> const * generation_source = nullptr) noexcept :
+		txn{ std::move (t) },
+		generation_source{ generation_source },
+		generation_m{ generation }
 	{
 	}
 
@@ -115,12 +152,19 @@ public:
 
 	void refresh ()
 	{
+		if (generation_source)
+		{
+			generation_m = generation_source->load ();
+		}
 		txn.refresh ();
 	}
 
 	void refresh_if_needed (std::chrono::milliseconds max_age = std::chrono::milliseconds{ 500 })
 	{
-		txn.refresh_if_needed (max_age);
+		if (std::chrono::steady_clock::now () - txn.timestamp () > max_age)
+		{
+			refresh ();
+		}
 	}
 
 	auto timestamp () const
@@ -128,6 +172,11 @@ public:
 		return txn.timestamp ();
 	}
 
+	uint64_t generation () const override
+	{
+		return generation_m;
+	}
+
 	// Conversion operator to const nano::store::transaction&
 	operator const nano::store::transaction & () const override
 	{
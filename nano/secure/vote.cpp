@@ -1,9 +1,13 @@
+#include <nano/lib/memory.hpp>
 #include <nano/lib/utility.hpp>
 #include <nano/secure/common.hpp>
 #include <nano/secure/vote.hpp>
 
 #include <boost/property_tree/json_parser.hpp>
 
+#include <algorithm>
+#include <cstring>
+
 nano::vote::vote (bool & error_a, nano::stream & stream_a)
 {
 	error_a = deserialize (stream_a);
@@ -41,6 +45,8 @@ bool nano::vote::deserialize (nano::stream & stream_a)
 		nano::read (stream_a, signature.bytes);
 		nano::read (stream_a, timestamp_m);
 
+		// Size the hash list upfront, votes are parsed for every confirm_ack received
+		hashes.reserve (std::min<std::size_t> (stream_a.in_avail () / sizeof (nano::block_hash), max_hashes));
 		while (stream_a.in_avail () > 0 && hashes.size () < max_hashes)
 		{
 			nano::block_hash block_hash;
@@ -64,32 +70,40 @@ std::size_t nano::vote::size (uint8_t count)
 std::string const nano::vote::hash_prefix = "vote ";
 
 nano::block_hash nano::vote::hash () const
+{
+	static_assert (sizeof (nano::block_hash) == sizeof (nano::block_hash::bytes));
+	return hash ({ reinterpret_cast<uint8_t const *> (hashes.data ()), hashes.size () * sizeof (nano::block_hash) }, timestamp_m);
+}
+
+nano::block_hash nano::vote::hash (std::span<uint8_t const> hashes, uint64_t timestamp)
 {
 	nano::block_hash result;
 	blake2b_state hash;
 	blake2b_init (&hash, sizeof (result.bytes));
 	blake2b_update (&hash, hash_prefix.data (), hash_prefix.size ());
-	for (auto const & block_hash : hashes)
-	{
-		blake2b_update (&hash, block_hash.bytes.data (), sizeof (block_hash.bytes));
-	}
+	blake2b_update (&hash, hashes.data (), hashes.size ());
 	union
 	{
 		uint64_t qword;
 		std::array<uint8_t, 8> bytes;
 	};
-	qword = timestamp_m;
+	qword = timestamp;
 	blake2b_update (&hash, bytes.data (), sizeof (bytes));
 	blake2b_final (&hash, result.bytes.data (), sizeof (result.bytes));
 	return result;
 }
 
 nano::block_hash nano::vote::full_hash () const
+{
+	return full_hash (hash (), account, signature);
+}
+
+nano::block_hash nano::vote::full_hash (nano::block_hash const & hash, nano::account const & account, nano::signature const & signature)
 {
 	nano::block_hash result;
 	blake2b_state state;
 	blake2b_init (&state, sizeof (result.bytes));
-	blake2b_update (&state, hash ().bytes.data (), sizeof (hash ().bytes));
+	blake2b_update (&state, hash.bytes.data (), sizeof (hash.bytes));
 	blake2b_update (&state, account.bytes.data (), sizeof (account.bytes.data ()));
 	blake2b_update (&state, signature.bytes.data (), sizeof (signature.bytes.data ()));
 	blake2b_final (&state, result.bytes.data (), sizeof (result.bytes));
@@ -193,4 +207,68 @@ void nano::vote::operator() (nano::object_stream & obs) const
 	obs.write ("final", is_final_timestamp (timestamp_m));
 	obs.write ("timestamp", timestamp_m);
 	obs.write_range ("hashes", hashes);
+}
+
+/*
+ * vote_view
+ */
+
+nano::vote_view::vote_view (std::span<uint8_t const> bytes_a) :
+	bytes{ bytes_a }
+{
+}
+
+std::optional<nano::vote_view> nano::vote_view::parse (std::span<uint8_t const> bytes)
+{
+	if (bytes.size () < nano::vote::partial_size)
+	{
+		return std::nullopt;
+	}
+	auto const hashes_size = bytes.size () - nano::vote::partial_size;
+	if (hashes_size % sizeof (nano::block_hash) != 0 || hashes_size / sizeof (nano::block_hash) > nano::vote::max_hashes)
+	{
+		return std::nullopt;
+	}
+	return vote_view{ bytes };
+}
+
+nano::account nano::vote_view::account () const
+{
+	nano::account result;
+	std::copy_n (bytes.begin (), sizeof (result.bytes), result.bytes.begin ());
+	return result;
+}
+
+std::size_t nano::vote_view::hash_count () const
+{
+	return (bytes.size () - nano::vote::partial_size) / sizeof (nano::block_hash);
+}
+
+nano::block_hash nano::vote_view::hash () const
+{
+	uint64_t timestamp;
+	std::memcpy (&timestamp, bytes.data () + sizeof (nano::account) + sizeof (nano::signature), sizeof (timestamp));
+	return nano::vote::hash (bytes.subspan (nano::vote::partial_size), timestamp);
+}
+
+nano::block_hash nano::vote_view::full_hash () const
+{
+	nano::signature signature;
+	std::copy_n (bytes.begin () + sizeof (nano::account), sizeof (signature.bytes), signature.bytes.begin ());
+	return nano::vote::full_hash (hash (), account (), signature);
+}
+
+std::shared_ptr<nano::vote> nano::vote_view::to_vote () const
+{
+	auto result = nano::make_shared<nano::vote> ();
+	auto const * data = bytes.data ();
+	std::copy_n (data, sizeof (result->account.bytes), result->account.bytes.begin ());
+	data += sizeof (result->account.bytes);
+	std::copy_n (data, sizeof (result->signature.bytes), result->signature.bytes.begin ());
+	data += sizeof (result->signature.bytes);
+	std::memcpy (&result->timestamp_m, data, sizeof (result->timestamp_m));
+	data += sizeof (result->timestamp_m);
+	result->hashes.resize (hash_count ());
+	std::memcpy (result->hashes.data (), data, result->hashes.size () * sizeof (nano::block_hash));
+	return result;
 }
\ No newline at end of file
@@ -8,6 +8,9 @@
 #include <boost/iterator/transform_iterator.hpp>
 #include <boost/property_tree/ptree_fwd.hpp>
 
+#include <memory>
+#include <optional>
+#include <span>
 #include <vector>
 
 namespace nano
@@ -59,6 +62,10 @@ public:
 	/* Check if timestamp represents a final vote */
 	static bool is_final_timestamp (uint64_t timestamp);
 
+	/** Hash signed by the representative, computed over serialized block hashes and the timestamp as stored on the wire */
+	static nano::block_hash hash (std::span<uint8_t const> hashes, uint64_t timestamp);
+	static nano::block_hash full_hash (nano::block_hash const & hash, nano::account const &, nano::signature const &);
+
 public: // Payload
 	// The hashes for which this vote directly covers
 	std::vector<nano::block_hash> hashes;
@@ -80,6 +87,36 @@ private:
 
 public: // Logging
 	void operator() (nano::object_stream &) const;
+
+	friend class vote_view;
+};
+
+/**
+ * Read only view over a serialized vote, e.g. a confirm_ack payload still sitting in the receive buffer
+ * Allows hashing and deduplicating votes before anything is allocated for them
+ */
+class vote_view final
+{
+public:
+	/**
+	 * @return view over \p bytes, or nothing if they don't hold exactly one vote
+	 */
+	static std::optional<vote_view> parse (std::span<uint8_t const> bytes);
+
+	nano::account account () const;
+	std::size_t hash_count () const;
+	/** Same as `nano::vote::hash ()` of the deserialized vote */
+	nano::block_hash hash () const;
+	/** Same as `nano::vote::full_hash ()` of the deserialized vote */
+	nano::block_hash full_hash () const;
+
+	/** Deserializes the vote, block hashes are copied with a single allocation */
+	std::shared_ptr<nano::vote> to_vote () const;
+
+private:
+	explicit vote_view (std::span<uint8_t const> bytes);
+
+	std::span<uint8_t const> bytes;
 };
 
 using vote_uniquer = nano::uniquer<nano::block_hash, nano::vote>;
@@ -1,6 +1,7 @@
 #include <nano/crypto_lib/random_pool.hpp>
 #include <nano/lib/blocks.hpp>
 #include <nano/lib/logging.hpp>
+#include <nano/lib/network_filter.hpp>
 #include <nano/lib/thread_runner.hpp>
 #include <nano/node/active_elections.hpp>
 #include <nano/node/confirming_set.hpp>
@@ -15,6 +16,8 @@
 #include <nano/secure/ledger.hpp>
 #include <nano/secure/ledger_set_any.hpp>
 #include <nano/secure/ledger_set_confirmed.hpp>
+#include <nano/store/account.hpp>
+#include <nano/store/bulk_loader.hpp>
 #include <nano/test_common/network.hpp>
 #include <nano/test_common/system.hpp>
 #include <nano/test_common/testutil.hpp>
@@ -25,6 +28,7 @@
 #include <boost/unordered_set.hpp>
 
 #include <random>
+#include <thread>
 
 using namespace std::chrono_literals;
 
@@ -186,6 +190,62 @@ TEST (ledger, deep_account_compute)
 	}
 }
 
+/*
+ * Cements a single deep account chain and reports the cementing rate, confirmation heights are written once per account instead of once per block
+ */
+TEST (ledger, cement_deep_chain)
+{
+	nano::logger logger;
+	auto store = nano::make_store (logger, nano::unique_path (), nano::dev::constants);
+	ASSERT_FALSE (store->init_error ());
+	nano::stats stats{ logger };
+	nano::ledger ledger (*store, stats, nano::dev::constants);
+	nano::work_pool pool{ nano::dev::network_params.network, std::numeric_limits<unsigned>::max () };
+	{
+		auto transaction = ledger.tx_begin_write ();
+		store->initialize (transaction, ledger.cache, ledger.constants);
+	}
+
+	auto const chain_length = 10000;
+	std::shared_ptr<nano::block> head = nano::dev::genesis;
+	{
+		auto transaction = ledger.tx_begin_write ();
+		nano::block_builder builder;
+		for (auto i = 0; i < chain_length; ++i)
+		{
+			auto send = builder
+						.state ()
+						.account (nano::dev::genesis_key.pub)
+						.previous (head->hash ())
+						.representative (nano::dev::genesis_key.pub)
+						.balance (nano::dev::constants.genesis_amount - (i + 1))
+						.link (nano::dev::genesis_key.pub)
+						.sign (nano::dev::genesis_key.prv, nano::dev::genesis_key.pub)
+						.work (*pool.generate (head->hash ()))
+						.build ();
+			ASSERT_EQ (nano::block_status::progress, ledger.process (transaction, send));
+			head = send;
+		}
+	}
+
+	std::deque<std::shared_ptr<nano::block>> confirmed;
+	auto const start = std::chrono::steady_clock::now ();
+	{
+		auto transaction = ledger.tx_begin_write ();
+		confirmed = ledger.confirm (transaction, head->hash ());
+	}
+	auto const duration = std::chrono::duration_cast<std::chrono::milliseconds> (std::chrono::steady_clock::now () - start);
+	ASSERT_EQ (chain_length, confirmed.size ());
+	ASSERT_TRUE (ledger.confirmed.block_exists (ledger.tx_begin_read (), head->hash ()));
+
+	auto const writes = stats.count (nano::stat::type::confirmation_height, nano::stat::detail::height_writes);
+	std::cout << "cemented " << confirmed.size () << " blocks in " << duration.count () << " ms"
+			  << " (" << confirmed.size () * 1000 / std::max<int64_t> (duration.count (), 1) << " blocks/sec)"
+			  << ", confirmation height writes: " << writes
+			  << std::endl;
+	ASSERT_LT (writes, confirmed.size ());
+}
+
 /*
  * This test case creates a node and a wallet primed with the genesis account credentials.
  * Then it spawns 'num_of_threads' threads, each doing 'num_of_sends' async sends
@@ -248,6 +308,180 @@ TEST (store, load)
 	}
 }
 
+// Compares filling the accounts table with regular puts against the bulk loader, using random key order for both
+TEST (store, bulk_load)
+{
+	auto const count = 1000000;
+	std::vector<std::pair<nano::account, nano::account_info>> accounts (count);
+	for (auto & [account, info] : accounts)
+	{
+		nano::random_pool::generate_block (account.bytes.data (), account.bytes.size ());
+		nano::random_pool::generate_block (info.head.bytes.data (), info.head.bytes.size ());
+	}
+
+	nano::logger logger;
+	auto store_put = nano::make_store (logger, nano::unique_path (), nano::dev::constants);
+	ASSERT_FALSE (store_put->init_error ());
+	auto start = std::chrono::steady_clock::now ();
+	{
+		auto transaction = store_put->tx_begin_write ();
+		for (auto const & [account, info] : accounts)
+		{
+			transaction.refresh_if_needed ();
+			store_put->account.put (transaction, account, info);
+		}
+	}
+	auto put_time = std::chrono::duration_cast<std::chrono::milliseconds> (std::chrono::steady_clock::now () - start);
+
+	auto store_bulk = nano::make_store (logger, nano::unique_path (), nano::dev::constants);
+	ASSERT_FALSE (store_bulk->init_error ());
+	start = std::chrono::steady_clock::now ();
+	{
+		auto loader = store_bulk->make_bulk_loader ();
+		for (auto const & [account, info] : accounts)
+		{
+			loader->account_put (account, info);
+		}
+		loader->flush ();
+	}
+	auto bulk_time = std::chrono::duration_cast<std::chrono::milliseconds> (std::chrono::steady_clock::now () - start);
+
+	std::cout << store_bulk->vendor_get () << ": " << count << " accounts, put: " << put_time.count () << " ms, bulk load: " << bulk_time.count () << " ms" << std::endl;
+	ASSERT_EQ (store_put->account.count (store_put->tx_begin_read ()), store_bulk->account.count (store_bulk->tx_begin_read ()));
+}
+
+// Measures network filter throughput with an increasing number of threads, each applying a mix of new and duplicate digests
+TEST (network_filter, multithreaded)
+{
+	auto const filter_size = 1024 * 1024;
+	auto const digests_per_thread = 1024 * 1024;
+	auto const max_threads = std::max (4u, std::thread::hardware_concurrency ());
+
+	std::vector<std::vector<nano::network_filter::digest_t>> digests (max_threads);
+	for (auto & thread_digests : digests)
+	{
+		for (auto i = 0; i < digests_per_thread; ++i)
+		{
+			nano::uint128_union digest;
+			nano::random_pool::generate_block (digest.bytes.data (), digest.bytes.size ());
+			thread_digests.push_back (digest.number ());
+		}
+	}
+
+	for (auto thread_count = 1u; thread_count <= max_threads; thread_count *= 2)
+	{
+		nano::network_filter filter{ filter_size };
+		std::atomic<uint64_t> duplicates{ 0 };
+		auto start = std::chrono::steady_clock::now ();
+		std::vector<std::thread> threads;
+		for (auto i = 0u; i < thread_count; ++i)
+		{
+			threads.emplace_back ([&filter, &duplicates, &thread_digests = digests[i]] () {
+				uint64_t duplicates_l = 0;
+				for (auto const & digest : thread_digests)
+				{
+					// Every message is usually received from more than one peer
+					duplicates_l += filter.apply (digest);
+					duplicates_l += filter.apply (digest);
+				}
+				duplicates += duplicates_l;
+			});
+		}
+		for (auto & thread : threads)
+		{
+			thread.join ();
+		}
+		auto elapsed = std::chrono::duration_cast<std::chrono::microseconds> (std::chrono::steady_clock::now () - start);
+		auto const applied = 2ull * digests_per_thread * thread_count;
+		std::cout << thread_count << " threads: " << applied << " applies in " << elapsed.count () / 1000 << " ms, " << applied / std::max<int64_t> (1, elapsed.count ()) << " applies/us, duplicates: " << duplicates << std::endl;
+		ASSERT_LE (duplicates, applied / 2);
+	}
+}
+
+/*
+ * Spam flooding the lowest balance bucket from block processing threads while the scheduler keeps locking the bucket
+ * Compares the locked `push` against the lock free `enqueue` path used by the priority scheduler
+ */
+TEST (election_scheduler, bucket_spam)
+{
+	nano::test::system system;
+	auto & node = *system.add_node ();
+
+	auto const blocks_per_thread = 64 * 1024;
+	auto const max_threads = std::max (4u, std::thread::hardware_concurrency ());
+
+	std::vector<std::vector<std::shared_ptr<nano::block>>> blocks (max_threads);
+	nano::keypair key;
+	for (auto & thread_blocks : blocks)
+	{
+		for (auto i = 0; i < blocks_per_thread; ++i)
+		{
+			nano::block_builder builder;
+			thread_blocks.push_back (builder
+									 .state ()
+									 .account (nano::random_pool::generate<nano::account> ())
+									 .previous (nano::random_pool::generate<nano::block_hash> ())
+									 .representative (0)
+									 .balance (1)
+									 .link (0)
+									 .sign (key.prv, key.pub)
+									 .work (0)
+									 .build ());
+		}
+	}
+
+	nano::scheduler::priority_bucket_config bucket_config{
+		.max_blocks = blocks_per_thread * max_threads
+	};
+
+	for (auto use_enqueue : { false, true })
+	{
+		for (auto thread_count = 1u; thread_count <= max_threads; thread_count *= 2)
+		{
+			nano::scheduler::bucket bucket{ 0, bucket_config, node.active, node.stats };
+			std::atomic<bool> done{ false };
+			// Stands in for the scheduler thread which takes the bucket lock on every activation
+			std::thread scheduler_thread ([&bucket, &done] () {
+				while (!done)
+				{
+					bucket.size ();
+				}
+			});
+
+			auto start = std::chrono::steady_clock::now ();
+			std::vector<std::thread> threads;
+			for (auto i = 0u; i < thread_count; ++i)
+			{
+				threads.emplace_back ([&bucket, use_enqueue, &thread_blocks = blocks[i]] () {
+					uint64_t time = 0;
+					for (auto const & block : thread_blocks)
+					{
+						if (use_enqueue)
+						{
+							bucket.enqueue (++time, block);
+						}
+						else
+						{
+							bucket.push (++time, block);
+						}
+					}
+				});
+			}
+			for (auto & thread : threads)
+			{
+				thread.join ();
+			}
+			auto elapsed = std::chrono::duration_cast<std::chrono::microseconds> (std::chrono::steady_clock::now () - start);
+			done = true;
+			scheduler_thread.join ();
+
+			auto const pushed = uint64_t{ blocks_per_thread } * thread_count;
+			std::cout << (use_enqueue ? "enqueue" : "push") << ", " << thread_count << " threads: " << pushed << " blocks in " << elapsed.count () / 1000 << " ms, " << pushed * 1000 / std::max<int64_t> (1, elapsed.count ()) << " blocks/ms" << std::endl;
+			ASSERT_EQ (pushed, bucket.size ());
+		}
+	}
+}
+
 namespace nano
 {
 TEST (node, fork_storm)
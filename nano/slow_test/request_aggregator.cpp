@@ -0,0 +1,126 @@
+#include <nano/lib/blocks.hpp>
+#include <nano/node/network.hpp>
+#include <nano/node/request_aggregator.hpp>
+#include <nano/secure/ledger.hpp>
+#include <nano/test_common/system.hpp>
+#include <nano/test_common/testutil.hpp>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <iostream>
+
+using namespace std::chrono_literals;
+
+namespace
+{
+class aggregator_benchmark_result
+{
+public:
+	std::chrono::milliseconds duration;
+	uint64_t generated_votes;
+	uint64_t cached_votes;
+	uint64_t cache_hits;
+	uint64_t cache_misses;
+};
+
+/*
+ * Many peers requesting votes for the same confirmed blocks at the same time, the way they do while following the same elections
+ */
+aggregator_benchmark_result run_aggregator_benchmark (std::chrono::milliseconds reply_cache_age, std::size_t block_count, std::size_t peer_count)
+{
+	nano::test::system system;
+	nano::node_config config = system.default_config ();
+	config.backlog_population.enable = false;
+	config.request_aggregator.reply_cache_age = reply_cache_age;
+	auto & node = *system.add_node (config);
+	system.wallet (0)->insert_adhoc (nano::dev::genesis_key.prv);
+
+	std::vector<std::shared_ptr<nano::block>> blocks;
+	auto previous = nano::dev::genesis->hash ();
+	for (std::size_t i = 0; i < block_count; ++i)
+	{
+		nano::block_builder builder;
+		auto block = builder
+					 .state ()
+					 .account (nano::dev::genesis_key.pub)
+					 .previous (previous)
+					 .representative (nano::dev::genesis_key.pub)
+					 .balance (nano::dev::constants.genesis_amount - (i + 1))
+					 .link (nano::dev::genesis_key.pub)
+					 .sign (nano::dev::genesis_key.prv, nano::dev::genesis_key.pub)
+					 .work (*system.work.generate (previous))
+					 .build ();
+		EXPECT_EQ (nano::block_status::progress, node.ledger.process (node.ledger.tx_begin_write (), block));
+		previous = block->hash ();
+		blocks.push_back (block);
+	}
+	nano::test::confirm (node.ledger, blocks.back ());
+
+	// Split into requests of the size a confirm_req carries
+	std::vector<nano::request_aggregator::request_type> requests;
+	for (std::size_t i = 0; i < blocks.size (); i += nano::network::confirm_req_hashes_max)
+	{
+		nano::request_aggregator::request_type request;
+		for (auto j = i; j < std::min (blocks.size (), i + nano::network::confirm_req_hashes_max); ++j)
+		{
+			request.emplace_back (blocks[j]->hash (), blocks[j]->root ());
+		}
+		requests.push_back (request);
+	}
+
+	std::vector<std::shared_ptr<nano::transport::channel>> channels;
+	for (std::size_t i = 0; i < peer_count; ++i)
+	{
+		channels.push_back (nano::test::fake_channel (node));
+	}
+
+	auto const start = std::chrono::steady_clock::now ();
+	for (auto const & request : requests)
+	{
+		for (auto const & channel : channels)
+		{
+			EXPECT_TRUE (node.aggregator.request (request, channel));
+		}
+	}
+	auto answered = [&node] () {
+		return node.stats.count (nano::stat::type::requests, nano::stat::detail::requests_generated_hashes) + node.stats.count (nano::stat::type::requests, nano::stat::detail::requests_cached_hashes);
+	};
+	EXPECT_TIMELY (120s, answered () == block_count * peer_count);
+	auto const duration = std::chrono::duration_cast<std::chrono::milliseconds> (std::chrono::steady_clock::now () - start);
+
+	return {
+		.duration = duration,
+		.generated_votes = node.stats.count (nano::stat::type::requests, nano::stat::detail::requests_generated_votes),
+		.cached_votes = node.stats.count (nano::stat::type::requests, nano::stat::detail::requests_cached_votes),
+		.cache_hits = node.stats.count (nano::stat::type::request_aggregator, nano::stat::detail::reply_cache_hit),
+		.cache_misses = node.stats.count (nano::stat::type::request_aggregator, nano::stat::detail::reply_cache_miss),
+	};
+}
+
+void print (std::string const & name, aggregator_benchmark_result const & result)
+{
+	std::cout << name << ": " << result.duration.count () << " ms"
+			  << ", generated votes: " << result.generated_votes
+			  << ", cached votes: " << result.cached_votes
+			  << ", cache hits: " << result.cache_hits
+			  << ", cache misses: " << result.cache_misses
+			  << std::endl;
+}
+}
+
+TEST (request_aggregator, reply_cache_benchmark)
+{
+	std::size_t const block_count = 512;
+	std::size_t const peer_count = 16;
+
+	auto uncached = run_aggregator_benchmark (0ms, block_count, peer_count);
+	print ("reply cache disabled", uncached);
+	auto cached = run_aggregator_benchmark (nano::request_aggregator_config{}.reply_cache_age, block_count, peer_count);
+	print ("reply cache enabled", cached);
+
+	// Every peer asking for the same blocks should be served mostly from the cache
+	ASSERT_EQ (0, uncached.cached_votes);
+	ASSERT_LT (cached.generated_votes, uncached.generated_votes);
+	ASSERT_GT (cached.cache_hits, cached.cache_misses);
+}
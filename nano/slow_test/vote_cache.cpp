@@ -1,6 +1,8 @@
 #include <nano/lib/blocks.hpp>
 #include <nano/node/active_elections.hpp>
+#include <nano/node/vote_cache.hpp>
 #include <nano/node/vote_router.hpp>
+#include <nano/secure/vote.hpp>
 #include <nano/test_common/rate_observer.hpp>
 #include <nano/test_common/system.hpp>
 #include <nano/test_common/testutil.hpp>
@@ -8,6 +10,7 @@
 #include <gtest/gtest.h>
 
 #include <functional>
+#include <map>
 #include <thread>
 
 using namespace std::chrono_literals;
@@ -250,3 +253,82 @@ TEST (vote_cache, perf_multithreaded)
 	// Ensure vote cache size is at max capacity
 	ASSERT_EQ (node.vote_cache.size (), config.vote_cache.max_size);
 }
+
+/*
+ * Fills a standalone vote cache sized for a principal representative and reports the estimated memory usage per cached hash
+ * Estimate is derived from container info, so allocator and index node overheads are not included
+ */
+TEST (vote_cache, memory_usage)
+{
+	nano::test::system system;
+	nano::vote_cache_config config;
+	config.max_size = 1024 * 512;
+	nano::vote_cache vote_cache{ config, system.stats };
+
+	const int rep_count = 24;
+	const int hash_count = config.max_size;
+
+	std::vector<nano::keypair> reps (rep_count);
+	std::map<nano::account, nano::uint128_t> weights;
+	for (int n = 0; n < rep_count; ++n)
+	{
+		weights[reps[n].pub] = nano::Knano_ratio * (n + 1);
+	}
+	vote_cache.rep_weight_query = [&weights] (nano::account const & rep) { return weights[rep]; };
+
+	std::vector<nano::block_hash> hashes;
+	for (int n = 0; n < hash_count; ++n)
+	{
+		hashes.push_back (nano::test::random_hash ());
+	}
+
+	// Every hash is voted on by a varying number of representatives, from a single one up to all of them
+	std::vector<std::shared_ptr<nano::vote>> votes;
+	for (int rep_idx = 0; rep_idx < rep_count; ++rep_idx)
+	{
+		for (std::size_t offset = 0; offset < hashes.size (); offset += nano::vote::max_hashes)
+		{
+			std::vector<nano::block_hash> vote_hashes;
+			for (auto i = offset; i < std::min (offset + nano::vote::max_hashes, hashes.size ()); ++i)
+			{
+				if (i % rep_count >= static_cast<std::size_t> (rep_idx))
+				{
+					vote_hashes.push_back (hashes[i]);
+				}
+			}
+			if (!vote_hashes.empty ())
+			{
+				votes.push_back (nano::test::make_vote (reps[rep_idx], vote_hashes));
+			}
+		}
+	}
+
+	std::cout << "preparation done, votes: " << votes.size () << std::endl;
+
+	auto start = std::chrono::steady_clock::now ();
+	for (auto const & vote : votes)
+	{
+		vote_cache.insert (vote);
+	}
+	auto insert_time = std::chrono::duration_cast<std::chrono::milliseconds> (std::chrono::steady_clock::now () - start);
+
+	ASSERT_EQ (vote_cache.size (), config.max_size);
+
+	std::function<std::size_t (nano::container_info const &)> estimate = [&estimate] (nano::container_info const & info) {
+		std::size_t result = 0;
+		for (auto const & entry : info.entries ())
+		{
+			std::cout << entry.name << ": " << entry.size << " x " << entry.sizeof_element << " bytes" << std::endl;
+			result += entry.size * entry.sizeof_element;
+		}
+		for (auto const & [name, child] : info.children ())
+		{
+			result += estimate (child);
+		}
+		return result;
+	};
+	auto bytes = estimate (vote_cache.container_info ());
+
+	std::cout << "insert time: " << insert_time.count () << " ms" << std::endl;
+	std::cout << "estimated memory: " << bytes / 1024 / 1024 << " MiB, " << bytes / vote_cache.size () << " bytes per hash" << std::endl;
+}
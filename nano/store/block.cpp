@@ -1 +1,36 @@
+#include <nano/lib/blocks.hpp>
+#include <nano/lib/stream.hpp>
+#include <nano/lib/utility.hpp>
 #include <nano/store/block.hpp>
+
+nano::store::block_view::block_view (nano::block_hash const & hash_a, std::span<uint8_t const> data) :
+	hash{ hash_a },
+	// The block type is the first byte
+	type{ static_cast<nano::block_type> (data[0]) }
+{
+	auto const sideband_size = nano::block_sideband::size (type);
+	release_assert (data.size () > sideband_size);
+	block = data.subspan (1, data.size () - 1 - sideband_size);
+	sideband = data.last (sideband_size);
+}
+
+nano::block_hash nano::store::block_view::successor () const
+{
+	// The successor is the first field of the sideband
+	nano::block_hash result;
+	std::copy_n (sideband.begin (), result.bytes.size (), result.bytes.begin ());
+	return result;
+}
+
+std::shared_ptr<nano::block> nano::store::block_view::deserialize () const
+{
+	nano::bufferstream block_stream{ block.data (), block.size () };
+	auto result = nano::deserialize_block (block_stream, type);
+	release_assert (result != nullptr);
+	nano::bufferstream sideband_stream{ sideband.data (), sideband.size () };
+	nano::block_sideband sideband_l;
+	auto error = sideband_l.deserialize (sideband_stream, type);
+	release_assert (!error);
+	result->sideband_set (sideband_l);
+	return result;
+}
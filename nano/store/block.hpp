@@ -8,6 +8,7 @@
 
 #include <functional>
 #include <optional>
+#include <span>
 
 namespace nano
 {
@@ -16,6 +17,26 @@ class block_hash;
 }
 namespace nano::store
 {
+/**
+ * Stored representation of a block, pointing directly into memory owned by the database
+ * Only valid inside the callback it is passed to, nothing is deserialized unless asked for.
+ */
+class block_view
+{
+public:
+	/** Splits a raw database value into the serialized block and its sideband */
+	block_view (nano::block_hash const & hash, std::span<uint8_t const> data);
+
+	nano::block_hash hash;
+	nano::block_type type;
+	std::span<uint8_t const> block; // Serialized block, without the leading type byte
+	std::span<uint8_t const> sideband;
+
+	nano::block_hash successor () const;
+	/** Deserializes the block and attaches its sideband */
+	std::shared_ptr<nano::block> deserialize () const;
+};
+
 /**
  * Manages block storage and iteration
  */
@@ -38,5 +59,10 @@ public:
 	virtual iterator begin (store::transaction const &) const = 0;
 	virtual iterator end (store::transaction const &) const = 0;
 	virtual void for_each_par (std::function<void (store::read_transaction const &, iterator, iterator)> const & action_a) const = 0;
+	/**
+	 * Walks up to \p count blocks of an account chain starting at \p start by following the sideband successors
+	 * Each block is read once and handed to \p action as a view of the stored bytes, stops at the frontier or the first missing block
+	 */
+	virtual void chain (store::transaction const &, nano::block_hash const & start, std::size_t count, std::function<void (store::block_view const &)> const & action) const = 0;
 };
 } // namespace nano::store
@@ -0,0 +1,168 @@
+#include <nano/lib/utility.hpp>
+#include <nano/secure/account_info.hpp>
+#include <nano/secure/pending_info.hpp>
+#include <nano/store/bulk_loader.hpp>
+#include <nano/store/db_val_impl.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+/** Backend neutral container so records are encoded exactly like the regular store::*::put paths do */
+class raw_val
+{
+public:
+	std::size_t size;
+	void * data;
+};
+
+using raw_db_val = nano::store::db_val<raw_val>;
+}
+
+template <>
+void * raw_db_val::data () const
+{
+	return value.data;
+}
+
+template <>
+std::size_t raw_db_val::size () const
+{
+	return value.size;
+}
+
+template <>
+raw_db_val::db_val (std::size_t size_a, void * data_a) :
+	value ({ size_a, data_a })
+{
+}
+
+template <>
+void raw_db_val::convert_buffer_to_value ()
+{
+	value = { buffer->size (), const_cast<uint8_t *> (buffer->data ()) };
+}
+
+namespace
+{
+std::span<uint8_t const> as_span (raw_db_val const & val)
+{
+	return { static_cast<uint8_t const *> (val.data ()), val.size () };
+}
+}
+
+/*
+ * bulk_loader
+ */
+
+nano::store::bulk_loader::bulk_loader (std::size_t batch_size_a) :
+	batch_size{ batch_size_a }
+{
+}
+
+void nano::store::bulk_loader::account_put (nano::account const & account, nano::account_info const & info)
+{
+	put (tables::accounts, as_span (raw_db_val{ account }), as_span (raw_db_val{ info }));
+}
+
+void nano::store::bulk_loader::block_raw_put (nano::block_hash const & hash, std::vector<uint8_t> const & data)
+{
+	put (tables::blocks, as_span (raw_db_val{ hash }), data);
+}
+
+void nano::store::bulk_loader::confirmation_height_put (nano::account const & account, nano::confirmation_height_info const & info)
+{
+	put (tables::confirmation_height, as_span (raw_db_val{ account }), as_span (raw_db_val{ info }));
+}
+
+void nano::store::bulk_loader::pending_put (nano::pending_key const & key, nano::pending_info const & info)
+{
+	put (tables::pending, as_span (raw_db_val{ key }), as_span (raw_db_val{ info }));
+}
+
+void nano::store::bulk_loader::pruned_put (nano::block_hash const & hash)
+{
+	put (tables::pruned, as_span (raw_db_val{ hash }), as_span (raw_db_val{ nullptr }));
+}
+
+void nano::store::bulk_loader::rep_weight_put (nano::account const & representative, nano::uint128_t const & weight)
+{
+	nano::uint128_union const weight_l{ weight };
+	put (tables::rep_weights, as_span (raw_db_val{ representative }), as_span (raw_db_val{ weight_l }));
+}
+
+void nano::store::bulk_loader::final_vote_put (nano::qualified_root const & root, nano::block_hash const & hash)
+{
+	put (tables::final_votes, as_span (raw_db_val{ root }), as_span (raw_db_val{ hash }));
+}
+
+void nano::store::bulk_loader::unconfirmed_put (nano::account const & account)
+{
+	put (tables::unconfirmed, as_span (raw_db_val{ account }), as_span (raw_db_val{ nullptr }));
+}
+
+void nano::store::bulk_loader::put (tables table, std::span<uint8_t const> key, std::span<uint8_t const> value)
+{
+	auto & buffer = buffers[table];
+	buffer.entries.push_back ({ buffer.data.size (), static_cast<uint32_t> (key.size ()), static_cast<uint32_t> (value.size ()) });
+	buffer.data.insert (buffer.data.end (), key.begin (), key.end ());
+	buffer.data.insert (buffer.data.end (), value.begin (), value.end ());
+	buffered += key.size () + value.size ();
+	if (buffered >= batch_size)
+	{
+		flush ();
+	}
+}
+
+void nano::store::bulk_loader::flush ()
+{
+	for (auto & [table, buffer] : buffers)
+	{
+		write_buffer (table, buffer);
+	}
+	buffers.clear ();
+	buffered = 0;
+}
+
+void nano::store::bulk_loader::write_buffer (tables table, buffer & buffer)
+{
+	auto const * base = buffer.data.data ();
+	auto key_of = [base] (entry const & entry) {
+		return std::span<uint8_t const>{ base + entry.offset, entry.key_size };
+	};
+	auto less = [&key_of] (entry const & lhs, entry const & rhs) {
+		auto lhs_key = key_of (lhs);
+		auto rhs_key = key_of (rhs);
+		auto result = std::memcmp (lhs_key.data (), rhs_key.data (), std::min (lhs_key.size (), rhs_key.size ()));
+		return result < 0 || (result == 0 && lhs_key.size () < rhs_key.size ());
+	};
+	// Sources are usually iterated in key order already, only sort when needed
+	if (!std::is_sorted (buffer.entries.begin (), buffer.entries.end (), less))
+	{
+		// Stable so the most recently queued value of a duplicated key ends up last
+		std::stable_sort (buffer.entries.begin (), buffer.entries.end (), less);
+	}
+
+	std::vector<record> records;
+	records.reserve (buffer.entries.size ());
+	for (auto i = buffer.entries.begin (), n = buffer.entries.end (); i != n; ++i)
+	{
+		auto next = std::next (i);
+		if (next != n && !less (*i, *next))
+		{
+			continue; // Superseded by a later put of the same key
+		}
+		records.push_back ({ key_of (*i), { base + i->offset + i->key_size, i->value_size } });
+	}
+	if (!records.empty ())
+	{
+		write (table, records);
+		written_m += records.size ();
+	}
+}
+
+uint64_t nano::store::bulk_loader::written () const
+{
+	return written_m;
+}
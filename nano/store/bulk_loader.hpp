@@ -0,0 +1,87 @@
+#pragma once
+
+#include <nano/lib/numbers.hpp>
+#include <nano/store/tables.hpp>
+
+#include <cstdint>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+namespace nano
+{
+class account_info;
+class confirmation_height_info;
+class pending_info;
+class pending_key;
+}
+
+namespace nano::store
+{
+/**
+ * Write-only path for filling empty or freshly dropped tables with large amounts of data, e.g. when migrating between backends or importing a snapshot.
+ * Records are buffered and sorted per table, each batch is then handed to the backend in ascending key order so it can use
+ * its fastest insertion mode (MDB_APPEND for LMDB, SST file ingestion for RocksDB).
+ * When the same key is put more than once within a batch the last value wins.
+ * Data is only guaranteed to be written after flush () returns. Instances are not thread safe.
+ */
+class bulk_loader
+{
+public:
+	/** Buffered bytes (keys and values) after which a batch is written out automatically */
+	static std::size_t constexpr default_batch_size{ 64 * 1024 * 1024 };
+
+	explicit bulk_loader (std::size_t batch_size = default_batch_size);
+	virtual ~bulk_loader () = default;
+
+	void account_put (nano::account const &, nano::account_info const &);
+	void block_raw_put (nano::block_hash const &, std::vector<uint8_t> const & block_with_sideband);
+	void confirmation_height_put (nano::account const &, nano::confirmation_height_info const &);
+	void pending_put (nano::pending_key const &, nano::pending_info const &);
+	void pruned_put (nano::block_hash const &);
+	void rep_weight_put (nano::account const &, nano::uint128_t const & weight);
+	void final_vote_put (nano::qualified_root const &, nano::block_hash const &);
+	void unconfirmed_put (nano::account const &);
+
+	/** Queues an already encoded record */
+	void put (tables, std::span<uint8_t const> key, std::span<uint8_t const> value);
+	/** Writes all buffered records */
+	void flush ();
+
+	uint64_t written () const;
+
+protected:
+	class record
+	{
+	public:
+		std::span<uint8_t const> key;
+		std::span<uint8_t const> value;
+	};
+
+	/** Writes \p records, which are sorted by key with no duplicates, into \p table */
+	virtual void write (tables table, std::vector<record> const & records) = 0;
+
+private:
+	class entry
+	{
+	public:
+		std::size_t offset;
+		uint32_t key_size;
+		uint32_t value_size;
+	};
+
+	class buffer
+	{
+	public:
+		std::vector<uint8_t> data;
+		std::vector<entry> entries;
+	};
+
+	void write_buffer (tables, buffer &);
+
+	std::size_t const batch_size;
+	std::unordered_map<tables, buffer> buffers;
+	std::size_t buffered{ 0 };
+	uint64_t written_m{ 0 };
+};
+}
@@ -6,8 +6,9 @@
 #include <nano/store/component.hpp>
 #include <nano/store/confirmation_height.hpp>
 #include <nano/store/rep_weight.hpp>
+#include <nano/store/unconfirmed.hpp>
 
-nano::store::component::component (nano::store::block & block_store_a, nano::store::account & account_store_a, nano::store::pending & pending_store_a, nano::store::online_weight & online_weight_store_a, nano::store::pruned & pruned_store_a, nano::store::peer & peer_store_a, nano::store::confirmation_height & confirmation_height_store_a, nano::store::final_vote & final_vote_store_a, nano::store::version & version_store_a, nano::store::rep_weight & rep_weight_a) :
+nano::store::component::component (nano::store::block & block_store_a, nano::store::account & account_store_a, nano::store::pending & pending_store_a, nano::store::online_weight & online_weight_store_a, nano::store::pruned & pruned_store_a, nano::store::peer & peer_store_a, nano::store::confirmation_height & confirmation_height_store_a, nano::store::final_vote & final_vote_store_a, nano::store::version & version_store_a, nano::store::rep_weight & rep_weight_a, nano::store::unconfirmed & unconfirmed_a) :
 	block (block_store_a),
 	account (account_store_a),
 	pending (pending_store_a),
@@ -17,7 +18,8 @@ nano::store::component::component (nano::store::block & block_store_a, nano::sto
 	confirmation_height (confirmation_height_store_a),
 	final_vote (final_vote_store_a),
 	version (version_store_a),
-	rep_weight (rep_weight_a)
+	rep_weight (rep_weight_a),
+	unconfirmed (unconfirmed_a)
 {
 }
 
@@ -39,3 +41,33 @@ void nano::store::component::initialize (store::write_transaction const & transa
 	rep_weight.put (transaction_a, constants.genesis->account (), std::numeric_limits<nano::uint128_t>::max ());
 	ledger_cache_a.rep_weights.representation_put (constants.genesis->account (), std::numeric_limits<nano::uint128_t>::max ());
 }
+
+void nano::store::component::rebuild_unconfirmed (store::write_transaction & transaction_a)
+{
+	unconfirmed.clear (transaction_a);
+	transaction_a.refresh ();
+
+	// Both tables are keyed by account, walk them side by side instead of looking up every confirmation height
+	auto transaction_l = tx_begin_read ();
+	auto conf_it = confirmation_height.begin (transaction_l);
+	auto const conf_end = confirmation_height.end (transaction_l);
+	std::size_t processed = 0;
+	for (auto it = account.begin (transaction_l), end = account.end (transaction_l); it != end; ++it)
+	{
+		auto const & [account_l, info] = *it;
+		while (conf_it != conf_end && conf_it->first < account_l)
+		{
+			++conf_it;
+		}
+		auto const height = (conf_it != conf_end && conf_it->first == account_l) ? conf_it->second.height : 0;
+		if (height < info.block_count)
+		{
+			unconfirmed.put (transaction_a, account_l);
+		}
+
+		if (++processed % 250000 == 0)
+		{
+			transaction_a.refresh (); // Refresh to prevent excessive memory usage
+		}
+	}
+}
@@ -20,6 +20,7 @@ namespace store
 {
 	class account;
 	class block;
+	class bulk_loader;
 	class confirmation_height;
 	class final_vote;
 	class online_weight;
@@ -28,6 +29,7 @@ namespace store
 	class pruned;
 	class version;
 	class rep_weight;
+	class unconfirmed;
 }
 class ledger_cache;
 
@@ -53,11 +55,14 @@ namespace store
 		nano::store::confirmation_height &,
 		nano::store::final_vote &,
 		nano::store::version &,
-		nano::store::rep_weight &
+		nano::store::rep_weight &,
+		nano::store::unconfirmed &
 	);
 		// clang-format on
 		virtual ~component () = default;
 		void initialize (write_transaction const & transaction_a, nano::ledger_cache & ledger_cache_a, nano::ledger_constants & constants);
+		/** Refills the unconfirmed index from the account and confirmation height tables, used by upgrades and after confirmation heights are reset */
+		void rebuild_unconfirmed (write_transaction & transaction_a);
 		virtual uint64_t count (store::transaction const & transaction_a, tables table_a) const = 0;
 		virtual int drop (write_transaction const & transaction_a, tables table_a) = 0;
 		virtual bool not_found (int status) const = 0;
@@ -69,8 +74,9 @@ namespace store
 		store::account & account;
 		store::pending & pending;
 		store::rep_weight & rep_weight;
+		store::unconfirmed & unconfirmed;
 		static int constexpr version_minimum{ 21 };
-		static int constexpr version_current{ 24 };
+		static int constexpr version_current{ 25 };
 
 	public:
 		store::online_weight & online_weight;
@@ -88,6 +94,8 @@ namespace store
 
 		virtual bool copy_db (std::filesystem::path const & destination) = 0;
 		virtual void rebuild_db (write_transaction const & transaction_a) = 0;
+		/** Loader for filling tables in bulk, callers must ensure nothing else writes to the same tables while it is in use */
+		virtual std::unique_ptr<store::bulk_loader> make_bulk_loader () = 0;
 
 		/** Not applicable to all sub-classes */
 		virtual void serialize_mdb_tracker (boost::property_tree::ptree &, std::chrono::milliseconds, std::chrono::milliseconds){};
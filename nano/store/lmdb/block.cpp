@@ -159,6 +159,24 @@ void nano::store::lmdb::block::for_each_par (std::function<void (store::read_tra
 	});
 }
 
+void nano::store::lmdb::block::chain (store::transaction const & transaction, nano::block_hash const & start, std::size_t count, std::function<void (store::block_view const &)> const & action) const
+{
+	auto hash = start;
+	for (std::size_t i = 0; i < count && !hash.is_zero (); ++i)
+	{
+		// Values are read in place from the memory map, valid for the lifetime of the transaction
+		nano::store::lmdb::db_val value;
+		block_raw_get (transaction, hash, value);
+		if (value.size () == 0)
+		{
+			break;
+		}
+		nano::store::block_view view{ hash, { static_cast<uint8_t const *> (value.data ()), value.size () } };
+		action (view);
+		hash = view.successor ();
+	}
+}
+
 void nano::store::lmdb::block::block_raw_get (store::transaction const & transaction, nano::block_hash const & hash, nano::store::lmdb::db_val & value) const
 {
 	auto status = store.get (transaction, tables::blocks, hash, value);
@@ -35,6 +35,7 @@ public:
 	iterator begin (store::transaction const & transaction_a, nano::block_hash const & hash_a) const override;
 	iterator end (store::transaction const & transaction_a) const override;
 	void for_each_par (std::function<void (store::read_transaction const &, iterator, iterator)> const & action_a) const override;
+	void chain (store::transaction const &, nano::block_hash const & start, std::size_t count, std::function<void (store::block_view const &)> const & action) const override;
 
 	/**
 	 * Contains block_sideband and block for all block types (legacy send/change/open/receive & state blocks)
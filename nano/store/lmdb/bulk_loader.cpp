@@ -0,0 +1,33 @@
+#include <nano/lib/utility.hpp>
+#include <nano/store/lmdb/bulk_loader.hpp>
+#include <nano/store/lmdb/lmdb.hpp>
+
+nano::store::lmdb::bulk_loader::bulk_loader (nano::store::lmdb::component & store_a, std::size_t batch_size_a) :
+	nano::store::bulk_loader{ batch_size_a },
+	store{ store_a }
+{
+}
+
+nano::store::lmdb::bulk_loader::~bulk_loader ()
+{
+	flush ();
+}
+
+void nano::store::lmdb::bulk_loader::write (tables table, std::vector<record> const & records)
+{
+	auto transaction = store.tx_begin_write ();
+	auto txn = store.env.tx (transaction);
+	auto dbi = store.table_to_dbi (table);
+	for (auto const & record : records)
+	{
+		MDB_val key{ record.key.size (), const_cast<uint8_t *> (record.key.data ()) };
+		MDB_val value{ record.value.size (), const_cast<uint8_t *> (record.value.data ()) };
+		auto status = mdb_put (txn, dbi, &key, &value, MDB_APPEND);
+		if (status == MDB_KEYEXIST)
+		{
+			// Key is not past the end of the table, e.g. the table was not empty or an earlier batch had higher keys
+			status = mdb_put (txn, dbi, &key, &value, 0);
+		}
+		store.release_assert_success (status);
+	}
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <nano/store/bulk_loader.hpp>
+
+namespace nano::store::lmdb
+{
+class component;
+
+/**
+ * Writes each sorted batch in a single write transaction using MDB_APPEND, which skips the b-tree search
+ * and fills pages completely instead of splitting them. Keys lower than the last key already in the table fall back to a regular put.
+ */
+class bulk_loader : public nano::store::bulk_loader
+{
+public:
+	explicit bulk_loader (nano::store::lmdb::component &, std::size_t batch_size = default_batch_size);
+	~bulk_loader () override;
+
+protected:
+	void write (tables, std::vector<record> const &) override;
+
+private:
+	nano::store::lmdb::component & store;
+};
+}
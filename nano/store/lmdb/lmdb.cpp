@@ -26,7 +26,8 @@ nano::store::lmdb::component::component (nano::logger & logger_a, std::filesyste
 		confirmation_height_store,
 		final_vote_store,
 		version_store,
-		rep_weight_store
+		rep_weight_store,
+		unconfirmed_store
 	},
 	// clang-format on
 	block_store{ *this },
@@ -39,6 +40,7 @@ nano::store::lmdb::component::component (nano::logger & logger_a, std::filesyste
 	final_vote_store{ *this },
 	version_store{ *this },
 	rep_weight_store{ *this },
+	unconfirmed_store{ *this },
 	logger{ logger_a },
 	env (error, path_a, nano::store::lmdb::env::options::make ().set_config (lmdb_config_a).set_use_no_mem_init (true)),
 	mdb_txn_tracker (logger_a, txn_tracking_config_a, block_processor_batch_max_time_a),
@@ -206,6 +208,7 @@ void nano::store::lmdb::component::open_databases (bool & error_a, store::transa
 	error_a |= mdb_dbi_open (env.tx (transaction_a), "final_votes", flags, &final_vote_store.final_votes_handle) != 0;
 	error_a |= mdb_dbi_open (env.tx (transaction_a), "blocks", MDB_CREATE, &block_store.blocks_handle) != 0;
 	error_a |= mdb_dbi_open (env.tx (transaction_a), "rep_weights", flags, &rep_weight_store.rep_weights_handle) != 0;
+	error_a |= mdb_dbi_open (env.tx (transaction_a), "unconfirmed", flags, &unconfirmed_store.unconfirmed_handle) != 0;
 }
 
 bool nano::store::lmdb::component::do_upgrades (store::write_transaction & transaction, nano::ledger_constants & constants, bool & needs_vacuuming)
@@ -229,6 +232,9 @@ bool nano::store::lmdb::component::do_upgrades (store::write_transaction & trans
 			upgrade_v23_to_v24 (transaction);
 			[[fallthrough]];
 		case 24:
+			upgrade_v24_to_v25 (transaction);
+			[[fallthrough]];
+		case 25:
 			break;
 		default:
 			logger.critical (nano::log::type::lmdb, "The version of the ledger ({}) is too high for this node", version_l);
@@ -320,6 +326,18 @@ void nano::store::lmdb::component::upgrade_v23_to_v24 (store::write_transaction
 	logger.info (nano::log::type::lmdb, "Upgrading database from v23 to v24 completed");
 }
 
+// Fill unconfirmed table with all accounts which have blocks above their confirmation height
+void nano::store::lmdb::component::upgrade_v24_to_v25 (store::write_transaction & transaction)
+{
+	logger.info (nano::log::type::lmdb, "Upgrading database from v24 to v25...");
+
+	rebuild_unconfirmed (transaction);
+	logger.info (nano::log::type::lmdb, "Found {} accounts with unconfirmed blocks", unconfirmed.count (transaction));
+
+	version.put (transaction, 25);
+	logger.info (nano::log::type::lmdb, "Upgrading database from v24 to v25 completed");
+}
+
 /** Takes a filepath, appends '_backup_<timestamp>' to the end (but before any extension) and saves that file in the same directory */
 void nano::store::lmdb::component::create_backup_file (nano::store::lmdb::env & env_a, std::filesystem::path const & filepath_a, nano::logger & logger)
 {
@@ -417,6 +435,8 @@ MDB_dbi nano::store::lmdb::component::table_to_dbi (tables table_a) const
 			return final_vote_store.final_votes_handle;
 		case tables::rep_weights:
 			return rep_weight_store.rep_weights_handle;
+		case tables::unconfirmed:
+			return unconfirmed_store.unconfirmed_handle;
 		default:
 			release_assert (false);
 			return peer_store.peers_handle;
@@ -451,7 +471,7 @@ bool nano::store::lmdb::component::copy_db (std::filesystem::path const & destin
 void nano::store::lmdb::component::rebuild_db (store::write_transaction const & transaction_a)
 {
 	// Tables with uint256_union key
-	std::vector<MDB_dbi> tables = { account_store.accounts_handle, block_store.blocks_handle, pruned_store.pruned_handle, confirmation_height_store.confirmation_height_handle };
+	std::vector<MDB_dbi> tables = { account_store.accounts_handle, block_store.blocks_handle, pruned_store.pruned_handle, confirmation_height_store.confirmation_height_handle, unconfirmed_store.unconfirmed_handle };
 	for (auto const & table : tables)
 	{
 		MDB_dbi temp;
@@ -498,6 +518,11 @@ void nano::store::lmdb::component::rebuild_db (store::write_transaction const &
 	}
 }
 
+std::unique_ptr<nano::store::bulk_loader> nano::store::lmdb::component::make_bulk_loader ()
+{
+	return std::make_unique<nano::store::lmdb::bulk_loader> (*this);
+}
+
 bool nano::store::lmdb::component::init_error () const
 {
 	return error;
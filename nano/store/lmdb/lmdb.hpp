@@ -8,6 +8,7 @@
 #include <nano/store/db_val.hpp>
 #include <nano/store/lmdb/account.hpp>
 #include <nano/store/lmdb/block.hpp>
+#include <nano/store/lmdb/bulk_loader.hpp>
 #include <nano/store/lmdb/confirmation_height.hpp>
 #include <nano/store/lmdb/db_val.hpp>
 #include <nano/store/lmdb/final_vote.hpp>
@@ -19,6 +20,7 @@
 #include <nano/store/lmdb/pruned.hpp>
 #include <nano/store/lmdb/rep_weight.hpp>
 #include <nano/store/lmdb/transaction_impl.hpp>
+#include <nano/store/lmdb/unconfirmed.hpp>
 #include <nano/store/lmdb/version.hpp>
 #include <nano/store/versioning.hpp>
 
@@ -50,9 +52,11 @@ private:
 	nano::store::lmdb::pruned pruned_store;
 	nano::store::lmdb::version version_store;
 	nano::store::lmdb::rep_weight rep_weight_store;
+	nano::store::lmdb::unconfirmed unconfirmed_store;
 
 	friend class nano::store::lmdb::account;
 	friend class nano::store::lmdb::block;
+	friend class nano::store::lmdb::bulk_loader;
 	friend class nano::store::lmdb::confirmation_height;
 	friend class nano::store::lmdb::final_vote;
 	friend class nano::store::lmdb::online_weight;
@@ -61,6 +65,7 @@ private:
 	friend class nano::store::lmdb::pruned;
 	friend class nano::store::lmdb::version;
 	friend class nano::store::lmdb::rep_weight;
+	friend class nano::store::lmdb::unconfirmed;
 
 public:
 	component (nano::logger &, std::filesystem::path const &, nano::ledger_constants & constants, nano::txn_tracking_config const & txn_tracking_config_a = nano::txn_tracking_config{}, std::chrono::milliseconds block_processor_batch_max_time_a = std::chrono::milliseconds (5000), nano::lmdb_config const & lmdb_config_a = nano::lmdb_config{}, bool backup_before_upgrade = false);
@@ -92,6 +97,7 @@ public:
 
 	bool copy_db (std::filesystem::path const & destination_file) override;
 	void rebuild_db (store::write_transaction const & transaction_a) override;
+	std::unique_ptr<store::bulk_loader> make_bulk_loader () override;
 
 	template <typename Key, typename Value>
 	store::iterator<Key, Value> make_iterator (store::transaction const & transaction_a, tables table_a, bool const direction_asc = true) const
@@ -115,6 +121,7 @@ private:
 	void upgrade_v21_to_v22 (store::write_transaction &);
 	void upgrade_v22_to_v23 (store::write_transaction &);
 	void upgrade_v23_to_v24 (store::write_transaction &);
+	void upgrade_v24_to_v25 (store::write_transaction &);
 
 	void open_databases (bool &, store::transaction const &, unsigned);
 
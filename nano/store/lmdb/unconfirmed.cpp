@@ -0,0 +1,58 @@
+#include <nano/secure/parallel_traversal.hpp>
+#include <nano/store/lmdb/lmdb.hpp>
+#include <nano/store/lmdb/unconfirmed.hpp>
+
+nano::store::lmdb::unconfirmed::unconfirmed (nano::store::lmdb::component & store_a) :
+	store{ store_a } {};
+
+void nano::store::lmdb::unconfirmed::put (store::write_transaction const & transaction_a, nano::account const & account_a)
+{
+	auto status = store.put (transaction_a, tables::unconfirmed, account_a, nullptr);
+	store.release_assert_success (status);
+}
+
+void nano::store::lmdb::unconfirmed::del (store::write_transaction const & transaction_a, nano::account const & account_a)
+{
+	auto status = store.del (transaction_a, tables::unconfirmed, account_a);
+	release_assert (store.success (status) || store.not_found (status), store.error_string (status));
+}
+
+bool nano::store::lmdb::unconfirmed::exists (store::transaction const & transaction_a, nano::account const & account_a) const
+{
+	return store.exists (transaction_a, tables::unconfirmed, account_a);
+}
+
+uint64_t nano::store::lmdb::unconfirmed::count (store::transaction const & transaction_a) const
+{
+	return store.count (transaction_a, tables::unconfirmed);
+}
+
+void nano::store::lmdb::unconfirmed::clear (store::write_transaction const & transaction_a)
+{
+	auto status = store.drop (transaction_a, tables::unconfirmed);
+	store.release_assert_success (status);
+}
+
+auto nano::store::lmdb::unconfirmed::begin (store::transaction const & transaction_a, nano::account const & account_a) const -> iterator
+{
+	return store.make_iterator<nano::account, std::nullptr_t> (transaction_a, tables::unconfirmed, account_a);
+}
+
+auto nano::store::lmdb::unconfirmed::begin (store::transaction const & transaction_a) const -> iterator
+{
+	return store.make_iterator<nano::account, std::nullptr_t> (transaction_a, tables::unconfirmed);
+}
+
+auto nano::store::lmdb::unconfirmed::end (store::transaction const & transaction_a) const -> iterator
+{
+	return iterator{ nullptr };
+}
+
+void nano::store::lmdb::unconfirmed::for_each_par (std::function<void (store::read_transaction const &, iterator, iterator)> const & action_a) const
+{
+	parallel_traversal<nano::uint256_t> (
+	[&action_a, this] (nano::uint256_t const & start, nano::uint256_t const & end, bool const is_last) {
+		auto transaction (this->store.tx_begin_read ());
+		action_a (transaction, this->begin (transaction, start), !is_last ? this->begin (transaction, end) : this->end (transaction));
+	});
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <nano/store/unconfirmed.hpp>
+
+#include <lmdb/libraries/liblmdb/lmdb.h>
+
+namespace nano::store::lmdb
+{
+class component;
+
+class unconfirmed : public nano::store::unconfirmed
+{
+private:
+	nano::store::lmdb::component & store;
+
+public:
+	explicit unconfirmed (nano::store::lmdb::component & store_a);
+	void put (store::write_transaction const & transaction_a, nano::account const & account_a) override;
+	void del (store::write_transaction const & transaction_a, nano::account const & account_a) override;
+	bool exists (store::transaction const & transaction_a, nano::account const & account_a) const override;
+	uint64_t count (store::transaction const & transaction_a) const override;
+	void clear (store::write_transaction const & transaction_a) override;
+	iterator begin (store::transaction const & transaction_a, nano::account const & account_a) const override;
+	iterator begin (store::transaction const & transaction_a) const override;
+	iterator end (store::transaction const & transaction_a) const override;
+	void for_each_par (std::function<void (store::read_transaction const &, iterator, iterator)> const & action_a) const override;
+
+	/**
+	 * Accounts with blocks above their confirmation height
+	 * nano::account -> none
+	 */
+	MDB_dbi unconfirmed_handle{ 0 };
+};
+} // namespace nano::store::lmdb
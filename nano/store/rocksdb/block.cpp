@@ -158,6 +158,26 @@ void nano::store::rocksdb::block::for_each_par (std::function<void (store::read_
 	});
 }
 
+void nano::store::rocksdb::block::chain (store::transaction const & transaction, nano::block_hash const & start, std::size_t count, std::function<void (store::block_view const &)> const & action) const
+{
+	// A single slice is reused for the whole walk, values stay pinned in the block cache instead of being copied out
+	::rocksdb::PinnableSlice slice;
+	auto hash = start;
+	for (std::size_t i = 0; i < count && !hash.is_zero (); ++i)
+	{
+		slice.Reset ();
+		auto status = store.get (transaction, tables::blocks, hash, slice);
+		release_assert (store.success (status) || store.not_found (status));
+		if (!store.success (status))
+		{
+			break;
+		}
+		nano::store::block_view view{ hash, { reinterpret_cast<uint8_t const *> (slice.data ()), slice.size () } };
+		action (view);
+		hash = view.successor ();
+	}
+}
+
 void nano::store::rocksdb::block::block_raw_get (store::transaction const & transaction, nano::block_hash const & hash, nano::store::rocksdb::db_val & value) const
 {
 	auto status = store.get (transaction, tables::blocks, hash, value);
@@ -0,0 +1,47 @@
+#include <nano/lib/utility.hpp>
+#include <nano/store/rocksdb/bulk_loader.hpp>
+#include <nano/store/rocksdb/rocksdb.hpp>
+
+#include <rocksdb/sst_file_writer.h>
+
+#include <atomic>
+
+nano::store::rocksdb::bulk_loader::bulk_loader (nano::store::rocksdb::component & store_a, std::size_t batch_size_a) :
+	nano::store::bulk_loader{ batch_size_a },
+	store{ store_a }
+{
+}
+
+nano::store::rocksdb::bulk_loader::~bulk_loader ()
+{
+	flush ();
+}
+
+void nano::store::rocksdb::bulk_loader::write (tables table, std::vector<record> const & records)
+{
+	auto column_family = store.table_to_column_family (table);
+	::rocksdb::Options options{ ::rocksdb::DBOptions{}, store.get_cf_options (column_family->GetName ()) };
+	::rocksdb::SstFileWriter writer{ ::rocksdb::EnvOptions{}, options, column_family };
+
+	auto file = next_file ();
+	auto status = writer.Open (file.string ());
+	release_assert (status.ok (), status.ToString ());
+	for (auto const & record : records)
+	{
+		status = writer.Put (::rocksdb::Slice{ reinterpret_cast<char const *> (record.key.data ()), record.key.size () }, ::rocksdb::Slice{ reinterpret_cast<char const *> (record.value.data ()), record.value.size () });
+		release_assert (status.ok (), status.ToString ());
+	}
+	status = writer.Finish ();
+	release_assert (status.ok (), status.ToString ());
+
+	::rocksdb::IngestExternalFileOptions ingest_options;
+	ingest_options.move_files = true;
+	status = store.db->IngestExternalFile (column_family, { file.string () }, ingest_options);
+	release_assert (status.ok (), status.ToString ());
+}
+
+std::filesystem::path nano::store::rocksdb::bulk_loader::next_file ()
+{
+	static std::atomic<uint64_t> counter{ 0 };
+	return std::filesystem::path{ store.db->GetName () } / ("bulk_load_" + std::to_string (++counter) + ".sst");
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <nano/store/bulk_loader.hpp>
+
+#include <filesystem>
+
+namespace nano::store::rocksdb
+{
+class component;
+
+/**
+ * Writes each sorted batch into an SST file next to the database and ingests it, bypassing the memtable, WAL and the compactions they cause.
+ * Multiple loaders can be used concurrently, e.g. one per parallel traversal range.
+ */
+class bulk_loader : public nano::store::bulk_loader
+{
+public:
+	explicit bulk_loader (nano::store::rocksdb::component &, std::size_t batch_size = default_batch_size);
+	~bulk_loader () override;
+
+protected:
+	void write (tables, std::vector<record> const &) override;
+
+private:
+	std::filesystem::path next_file ();
+
+	nano::store::rocksdb::component & store;
+};
+}
@@ -47,7 +47,8 @@ nano::store::rocksdb::component::component (nano::logger & logger_a, std::filesy
 		confirmation_height_store,
 		final_vote_store,
 		version_store,
-		rep_weight_store
+		rep_weight_store,
+		unconfirmed_store
 	},
 	// clang-format on
 	block_store{ *this },
@@ -60,6 +61,7 @@ nano::store::rocksdb::component::component (nano::logger & logger_a, std::filesy
 	final_vote_store{ *this },
 	version_store{ *this },
 	rep_weight_store{ *this },
+	unconfirmed_store{ *this },
 	logger{ logger_a },
 	constants{ constants },
 	rocksdb_config{ rocksdb_config_a },
@@ -166,7 +168,8 @@ std::unordered_map<char const *, nano::tables> nano::store::rocksdb::component::
 		{ "confirmation_height", tables::confirmation_height },
 		{ "pruned", tables::pruned },
 		{ "final_votes", tables::final_votes },
-		{ "rep_weights", tables::rep_weights } };
+		{ "rep_weights", tables::rep_weights },
+		{ "unconfirmed", tables::unconfirmed } };
 
 	debug_assert (map.size () == all_tables ().size () + 1);
 	return map;
@@ -224,6 +227,9 @@ bool nano::store::rocksdb::component::do_upgrades (store::write_transaction & tr
 			upgrade_v23_to_v24 (transaction);
 			[[fallthrough]];
 		case 24:
+			upgrade_v24_to_v25 (transaction);
+			[[fallthrough]];
+		case 25:
 			break;
 		default:
 			logger.critical (nano::log::type::rocksdb, "The version of the ledger ({}) is too high for this node", version_l);
@@ -371,11 +377,52 @@ void nano::store::rocksdb::component::upgrade_v23_to_v24 (store::write_transacti
 	logger.info (nano::log::type::rocksdb, "Upgrading database from v23 to v24 completed");
 }
 
+// Fill unconfirmed table with all accounts which have blocks above their confirmation height
+void nano::store::rocksdb::component::upgrade_v24_to_v25 (store::write_transaction & transaction)
+{
+	logger.info (nano::log::type::rocksdb, "Upgrading database from v24 to v25...");
+
+	if (column_family_exists ("unconfirmed"))
+	{
+		logger.info (nano::log::type::rocksdb, "Dropping existing unconfirmed table");
+		auto const unconfirmed_handle = get_column_family ("unconfirmed");
+		db->DropColumnFamily (unconfirmed_handle);
+		db->DestroyColumnFamilyHandle (unconfirmed_handle);
+		std::erase_if (handles, [unconfirmed_handle] (auto & handle) {
+			if (handle.get () == unconfirmed_handle)
+			{
+				// The handle resource is deleted by RocksDB.
+				[[maybe_unused]] auto ptr = handle.release ();
+				return true;
+			}
+			return false;
+		});
+		transaction.refresh ();
+	}
+
+	{
+		logger.info (nano::log::type::rocksdb, "Creating table unconfirmed");
+		::rocksdb::ColumnFamilyOptions new_cf_options;
+		::rocksdb::ColumnFamilyHandle * new_cf_handle;
+		::rocksdb::Status status = db->CreateColumnFamily (new_cf_options, "unconfirmed", &new_cf_handle);
+		release_assert (success (status.code ()));
+		handles.emplace_back (new_cf_handle);
+		transaction.refresh ();
+	}
+
+	rebuild_unconfirmed (transaction);
+	logger.info (nano::log::type::rocksdb, "Found {} accounts with unconfirmed blocks", unconfirmed.count (transaction));
+
+	version.put (transaction, 25);
+	logger.info (nano::log::type::rocksdb, "Upgrading database from v24 to v25 completed");
+}
+
 void nano::store::rocksdb::component::generate_tombstone_map ()
 {
 	tombstone_map.emplace (std::piecewise_construct, std::forward_as_tuple (nano::tables::blocks), std::forward_as_tuple (0, 25000));
 	tombstone_map.emplace (std::piecewise_construct, std::forward_as_tuple (nano::tables::accounts), std::forward_as_tuple (0, 25000));
 	tombstone_map.emplace (std::piecewise_construct, std::forward_as_tuple (nano::tables::pending), std::forward_as_tuple (0, 25000));
+	tombstone_map.emplace (std::piecewise_construct, std::forward_as_tuple (nano::tables::unconfirmed), std::forward_as_tuple (0, 25000));
 }
 
 rocksdb::ColumnFamilyOptions nano::store::rocksdb::component::get_cf_options (std::string const & cf_name_a) const
@@ -490,6 +537,8 @@ rocksdb::ColumnFamilyHandle * nano::store::rocksdb::component::table_to_column_f
 			return get_column_family ("final_votes");
 		case tables::rep_weights:
 			return get_column_family ("rep_weights");
+		case tables::unconfirmed:
+			return get_column_family ("unconfirmed");
 		default:
 			release_assert (false);
 			return get_column_family ("");
@@ -551,8 +600,20 @@ rocksdb::Transaction * nano::store::rocksdb::component::tx (store::transaction c
 
 int nano::store::rocksdb::component::get (store::transaction const & transaction_a, tables table_a, nano::store::rocksdb::db_val const & key_a, nano::store::rocksdb::db_val & value_a) const
 {
-	::rocksdb::ReadOptions options;
 	::rocksdb::PinnableSlice slice;
+	auto status = get (transaction_a, table_a, key_a, slice);
+	if (success (status))
+	{
+		value_a.buffer = std::make_shared<std::vector<uint8_t>> (slice.size ());
+		std::memcpy (value_a.buffer->data (), slice.data (), slice.size ());
+		value_a.convert_buffer_to_value ();
+	}
+	return status;
+}
+
+int nano::store::rocksdb::component::get (store::transaction const & transaction_a, tables table_a, nano::store::rocksdb::db_val const & key_a, ::rocksdb::PinnableSlice & slice) const
+{
+	::rocksdb::ReadOptions options;
 	auto handle = table_to_column_family (table_a);
 	::rocksdb::Status status;
 	if (is_read (transaction_a))
@@ -563,13 +624,6 @@ int nano::store::rocksdb::component::get (store::transaction const & transaction
 	{
 		status = tx (transaction_a)->Get (options, handle, key_a, &slice);
 	}
-
-	if (status.ok ())
-	{
-		value_a.buffer = std::make_shared<std::vector<uint8_t>> (slice.size ());
-		std::memcpy (value_a.buffer->data (), slice.data (), slice.size ());
-		value_a.convert_buffer_to_value ();
-	}
 	return status.code ();
 }
 
@@ -655,6 +709,14 @@ uint64_t nano::store::rocksdb::component::count (store::transaction const & tran
 			++sum;
 		}
 	}
+	// Key estimates are unreliable with frequent deletes, the table is expected to stay small
+	else if (table_a == tables::unconfirmed)
+	{
+		for (auto i (unconfirmed.begin (transaction_a)), n (unconfirmed.end (transaction_a)); i != n; ++i)
+		{
+			++sum;
+		}
+	}
 	else
 	{
 		debug_assert (false);
@@ -764,7 +826,7 @@ void nano::store::rocksdb::component::on_flush (::rocksdb::FlushJobInfo const &
 
 std::vector<nano::tables> nano::store::rocksdb::component::all_tables () const
 {
-	return std::vector<nano::tables>{ tables::accounts, tables::blocks, tables::confirmation_height, tables::final_votes, tables::meta, tables::online_weight, tables::peers, tables::pending, tables::pruned, tables::vote, tables::rep_weights };
+	return std::vector<nano::tables>{ tables::accounts, tables::blocks, tables::confirmation_height, tables::final_votes, tables::meta, tables::online_weight, tables::peers, tables::pending, tables::pruned, tables::vote, tables::rep_weights, tables::unconfirmed };
 }
 
 bool nano::store::rocksdb::component::copy_db (std::filesystem::path const & destination_path)
@@ -842,6 +904,11 @@ void nano::store::rocksdb::component::rebuild_db (store::write_transaction const
 	// Not available for RocksDB
 }
 
+std::unique_ptr<nano::store::bulk_loader> nano::store::rocksdb::component::make_bulk_loader ()
+{
+	return std::make_unique<nano::store::rocksdb::bulk_loader> (*this);
+}
+
 bool nano::store::rocksdb::component::init_error () const
 {
 	return error;
@@ -7,6 +7,7 @@
 #include <nano/secure/common.hpp>
 #include <nano/store/rocksdb/account.hpp>
 #include <nano/store/rocksdb/block.hpp>
+#include <nano/store/rocksdb/bulk_loader.hpp>
 #include <nano/store/rocksdb/confirmation_height.hpp>
 #include <nano/store/rocksdb/final_vote.hpp>
 #include <nano/store/rocksdb/iterator.hpp>
@@ -15,6 +16,7 @@
 #include <nano/store/rocksdb/pending.hpp>
 #include <nano/store/rocksdb/pruned.hpp>
 #include <nano/store/rocksdb/rep_weight.hpp>
+#include <nano/store/rocksdb/unconfirmed.hpp>
 #include <nano/store/rocksdb/version.hpp>
 
 #include <rocksdb/db.h>
@@ -51,10 +53,12 @@ private:
 	nano::store::rocksdb::pruned pruned_store;
 	nano::store::rocksdb::version version_store;
 	nano::store::rocksdb::rep_weight rep_weight_store;
+	nano::store::rocksdb::unconfirmed unconfirmed_store;
 
 public:
 	friend class nano::store::rocksdb::account;
 	friend class nano::store::rocksdb::block;
+	friend class nano::store::rocksdb::bulk_loader;
 	friend class nano::store::rocksdb::confirmation_height;
 	friend class nano::store::rocksdb::final_vote;
 	friend class nano::store::rocksdb::online_weight;
@@ -63,6 +67,7 @@ public:
 	friend class nano::store::rocksdb::pruned;
 	friend class nano::store::rocksdb::version;
 	friend class nano::store::rocksdb::rep_weight;
+	friend class nano::store::rocksdb::unconfirmed;
 
 	explicit component (nano::logger &, std::filesystem::path const &, nano::ledger_constants & constants, nano::rocksdb_config const & = nano::rocksdb_config{}, bool open_read_only = false);
 
@@ -75,6 +80,8 @@ public:
 
 	bool exists (store::transaction const & transaction_a, tables table_a, nano::store::rocksdb::db_val const & key_a) const;
 	int get (store::transaction const & transaction_a, tables table_a, nano::store::rocksdb::db_val const & key_a, nano::store::rocksdb::db_val & value_a) const;
+	/** Reads the value without copying it out of the block cache, \p slice keeps it pinned until it is reset */
+	int get (store::transaction const &, tables, nano::store::rocksdb::db_val const & key, ::rocksdb::PinnableSlice & slice) const;
 	int put (store::write_transaction const & transaction_a, tables table_a, nano::store::rocksdb::db_val const & key_a, nano::store::rocksdb::db_val const & value_a);
 	int del (store::write_transaction const & transaction_a, tables table_a, nano::store::rocksdb::db_val const & key_a);
 
@@ -82,6 +89,7 @@ public:
 
 	bool copy_db (std::filesystem::path const & destination) override;
 	void rebuild_db (store::write_transaction const & transaction_a) override;
+	std::unique_ptr<store::bulk_loader> make_bulk_loader () override;
 
 	unsigned max_block_write_batch_num () const override;
 
@@ -150,6 +158,7 @@ private:
 	void upgrade_v21_to_v22 (store::write_transaction &);
 	void upgrade_v22_to_v23 (store::write_transaction &);
 	void upgrade_v23_to_v24 (store::write_transaction &);
+	void upgrade_v24_to_v25 (store::write_transaction &);
 
 	::rocksdb::Options get_db_options ();
 	::rocksdb::BlockBasedTableOptions get_table_options () const;
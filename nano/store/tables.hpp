@@ -19,6 +19,7 @@ enum class tables
 	pruned,
 	vote,
 	rep_weights,
+	unconfirmed,
 };
 } // namespace nano
 
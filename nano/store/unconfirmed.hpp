@@ -0,0 +1,32 @@
+#pragma once
+
+#include <nano/lib/numbers.hpp>
+#include <nano/store/component.hpp>
+#include <nano/store/iterator.hpp>
+
+#include <functional>
+
+namespace nano::store
+{
+/**
+ * Index of accounts which have blocks above their confirmation height
+ * Kept up to date by the ledger when blocks are processed, cemented or rolled back, so unconfirmed frontiers can be found without visiting every account
+ */
+class unconfirmed
+{
+public:
+	using iterator = store::iterator<nano::account, std::nullptr_t>;
+
+public:
+	virtual void put (store::write_transaction const &, nano::account const &) = 0;
+	/** Erasing an account which isn't in the index is a no-op */
+	virtual void del (store::write_transaction const &, nano::account const &) = 0;
+	virtual bool exists (store::transaction const &, nano::account const &) const = 0;
+	virtual uint64_t count (store::transaction const &) const = 0;
+	virtual void clear (store::write_transaction const &) = 0;
+	virtual iterator begin (store::transaction const &, nano::account const &) const = 0;
+	virtual iterator begin (store::transaction const &) const = 0;
+	virtual iterator end (store::transaction const &) const = 0;
+	virtual void for_each_par (std::function<void (store::read_transaction const &, iterator, iterator)> const & action_a) const = 0;
+};
+} // namespace nano::store